@@ -0,0 +1,317 @@
+// 游戏数据加载基准：对比 jsoncpp DOM 路径、流式读取器（读入字符串或内存映射）与二进制快照载入 test/ 下数据文件的耗时与常驻内存。
+// 用法: albc_bench_loader [测试数据目录] [迭代次数]
+#include "data_building.h"
+#include "data_character_meta_table.h"
+#include "data_player.h"
+#include "data_snapshot.h"
+#include "util_json.h"
+#include "util_json_stream.h"
+#include "util_mmap.h"
+#include "util_time.h"
+
+#include <filesystem>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+
+#if defined(__linux__)
+#include <unistd.h>
+#endif
+
+#if defined(__GLIBC__)
+#include <malloc.h>
+#endif
+
+namespace
+{
+using albc::util::FloatingSeconds;
+using albc::util::PerfClock;
+
+long long GetResidentKb()
+{
+#if defined(__linux__)
+    std::ifstream statm("/proc/self/statm");
+    long long total_pages = 0, resident_pages = 0;
+    statm >> total_pages >> resident_pages;
+    return resident_pages * sysconf(_SC_PAGESIZE) / 1024;
+#else
+    return -1;
+#endif
+}
+
+void TrimHeap()
+{
+#if defined(__GLIBC__)
+    malloc_trim(0);
+#endif
+}
+
+struct Sample
+{
+    double mean_ms = 0;
+    double min_ms = 0;
+    long long retained_kb = -1; // 加载结果驻留期间的 RSS 增量
+};
+
+// DOM 路径：与原先的 LoadGameDataFile + Resolve 一致，DOM 与强类型对象同时驻留
+template <typename T> struct DomLoaded
+{
+    Json::Value dom;
+    std::shared_ptr<T> value;
+};
+
+template <typename T> std::shared_ptr<DomLoaded<T>> LoadDom(const std::string &path)
+{
+    auto loaded = std::make_shared<DomLoaded<T>>();
+    loaded->dom = albc::util::read_json_from_file(path);
+    loaded->value = std::make_shared<T>(loaded->dom);
+    return loaded;
+}
+
+template <typename T> std::shared_ptr<T> LoadStream(const std::string &path)
+{
+    const auto text = albc::util::read_file_as_string(path);
+    albc::util::JsonStreamReader reader(text);
+    auto value = std::make_shared<T>(reader);
+    reader.ExpectEnd();
+    return value;
+}
+
+// 与 LoadGameDataFile / Model::FromFile 一致，直接在映射的页面上解析
+template <typename T> std::shared_ptr<T> LoadMapped(const std::string &path)
+{
+    const albc::util::MappedFile file(path);
+    albc::util::JsonStreamReader reader(file.View());
+    auto value = std::make_shared<T>(reader);
+    reader.ExpectEnd();
+    return value;
+}
+
+albc::data::GameDataSnapshot LoadSnapshot(const std::string &path)
+{
+    const albc::util::MappedFile file(path);
+    return albc::data::DeserializeGameDataSnapshot(file.View());
+}
+
+template <typename TLoad> Sample Measure(int iterations, TLoad &&load)
+{
+    Sample sample;
+
+    TrimHeap();
+    const auto rss_before = GetResidentKb();
+    {
+        const auto held = load();
+        if (rss_before >= 0)
+            sample.retained_kb = GetResidentKb() - rss_before;
+    }
+
+    double total_ms = 0;
+    sample.min_ms = std::numeric_limits<double>::max();
+    for (int i = 0; i < iterations; ++i)
+    {
+        const auto t0 = PerfClock::now();
+        load();
+        const double ms = FloatingSeconds(PerfClock::now() - t0).count() * 1000.;
+        total_ms += ms;
+        sample.min_ms = std::min(sample.min_ms, ms);
+    }
+    sample.mean_ms = total_ms / iterations;
+    return sample;
+}
+
+bool Same(const albc::data::building::BuildingData &lhs, const albc::data::building::BuildingData &rhs)
+{
+    if (lhs.chars.size() != rhs.chars.size() || lhs.buffs.size() != rhs.buffs.size())
+        return false;
+
+    for (auto l = lhs.buffs.begin(), r = rhs.buffs.begin(); l != lhs.buffs.end(); ++l, ++r)
+    {
+        const auto &lb = *l->second, &rb = *r->second;
+        if (l->first != r->first || lb.buff_id != rb.buff_id || lb.buff_name != rb.buff_name ||
+            lb.skill_icon != rb.skill_icon || lb.sort_id != rb.sort_id || lb.room_type != rb.room_type ||
+            lb.description != rb.description)
+            return false;
+    }
+
+    for (auto l = lhs.chars.begin(), r = rhs.chars.begin(); l != lhs.chars.end(); ++l, ++r)
+    {
+        const auto &lc = *l->second, &rc = *r->second;
+        if (l->first != r->first || lc.char_id != rc.char_id || lc.max_man_power != rc.max_man_power ||
+            lc.buff_char.size() != rc.buff_char.size())
+            return false;
+
+        for (size_t i = 0; i < lc.buff_char.size(); ++i)
+        {
+            const auto &ls = lc.buff_char[i]->buff_data, &rs = rc.buff_char[i]->buff_data;
+            if (ls.size() != rs.size())
+                return false;
+
+            for (size_t j = 0; j < ls.size(); ++j)
+            {
+                if (ls[j].buff_id != rs[j].buff_id || ls[j].cond.phase != rs[j].cond.phase ||
+                    ls[j].cond.level != rs[j].cond.level)
+                    return false;
+            }
+        }
+    }
+    return true;
+}
+
+bool Same(const albc::data::player::PlayerDataModel &lhs, const albc::data::player::PlayerDataModel &rhs)
+{
+    if (lhs.troop.chars.size() != rhs.troop.chars.size() ||
+        lhs.building.chars.size() != rhs.building.chars.size() ||
+        lhs.building.room_slots.size() != rhs.building.room_slots.size() ||
+        lhs.building.player_building_room.manufacture.size() != rhs.building.player_building_room.manufacture.size() ||
+        lhs.building.player_building_room.trading.size() != rhs.building.player_building_room.trading.size())
+        return false;
+
+    for (auto l = lhs.troop.chars.begin(), r = rhs.troop.chars.begin(); l != lhs.troop.chars.end(); ++l, ++r)
+    {
+        const auto &lc = *l->second, &rc = *r->second;
+        if (l->first != r->first || lc.inst_id != rc.inst_id || lc.char_id != rc.char_id || lc.level != rc.level ||
+            lc.exp != rc.exp || lc.evolve_phase != rc.evolve_phase)
+            return false;
+    }
+
+    for (auto l = lhs.building.chars.begin(), r = rhs.building.chars.begin(); l != lhs.building.chars.end(); ++l, ++r)
+    {
+        const auto &lc = *l->second, &rc = *r->second;
+        if (l->first != r->first || lc.char_id != rc.char_id || lc.room_slot_id != rc.room_slot_id ||
+            lc.ap != rc.ap || lc.index != rc.index || lc.change_scale != rc.change_scale ||
+            lc.work_time != rc.work_time)
+            return false;
+    }
+
+    for (auto l = lhs.building.room_slots.begin(), r = rhs.building.room_slots.begin();
+         l != lhs.building.room_slots.end(); ++l, ++r)
+    {
+        if (l->first != r->first || l->second.level != r->second.level || l->second.state != r->second.state ||
+            l->second.room_id != r->second.room_id || l->second.char_inst_ids != r->second.char_inst_ids)
+            return false;
+    }
+
+    const auto &lm = lhs.building.player_building_room.manufacture;
+    const auto &rm = rhs.building.player_building_room.manufacture;
+    for (auto l = lm.begin(), r = rm.begin(); l != lm.end(); ++l, ++r)
+    {
+        if (l->first != r->first || l->second.formula_id != r->second.formula_id ||
+            l->second.capacity != r->second.capacity || l->second.process_point != r->second.process_point)
+            return false;
+    }
+
+    const auto &lt = lhs.building.player_building_room.trading;
+    const auto &rt = rhs.building.player_building_room.trading;
+    for (auto l = lt.begin(), r = rt.begin(); l != lt.end(); ++l, ++r)
+    {
+        if (l->first != r->first || l->second.order_type != r->second.order_type ||
+            l->second.stock_limit != r->second.stock_limit || l->second.buff.speed != r->second.buff.speed)
+            return false;
+    }
+
+    return lhs.building.status_labor.max_value == rhs.building.status_labor.max_value &&
+           lhs.building.status_labor.value == rhs.building.status_labor.value;
+}
+
+bool Same(const albc::data::game::CharacterMetaTable &lhs, const albc::data::game::CharacterMetaTable &rhs)
+{
+    return lhs.sp_char_groups == rhs.sp_char_groups;
+}
+
+void PrintSample(const char *name, const Sample &sample)
+{
+    std::cout << "  " << std::left << std::setw(10) << name << std::right << std::fixed << std::setprecision(3)
+              << "mean " << std::setw(10) << sample.mean_ms << " ms, min " << std::setw(10) << sample.min_ms
+              << " ms, retained rss " << std::setw(8) << sample.retained_kb << " KiB" << std::endl;
+}
+
+template <typename T> bool RunCase(const std::string &path, int iterations)
+{
+    std::cout << path << " (" << std::filesystem::file_size(path) / 1024 << " KiB)" << std::endl;
+
+    // 流式路径先测，避免其常驻内存增量受到 DOM 路径释放后空闲堆的影响
+    const auto mapped = Measure(iterations, [&] { return LoadMapped<T>(path); });
+    const auto stream = Measure(iterations, [&] { return LoadStream<T>(path); });
+    const auto dom = Measure(iterations, [&] { return LoadDom<T>(path); });
+    PrintSample("mmap", mapped);
+    PrintSample("stream", stream);
+    PrintSample("dom", dom);
+    std::cout << "  speedup " << std::setprecision(2) << dom.mean_ms / mapped.mean_ms << "x";
+
+    const bool same = Same(*LoadMapped<T>(path), *LoadDom<T>(path)->value) &&
+                      Same(*LoadStream<T>(path), *LoadDom<T>(path)->value);
+    std::cout << ", results " << (same ? "identical" : "DIFFER") << std::endl;
+    return same;
+}
+
+// 快照路径：building_data 与 char_meta_table 编译为一个镜像后整体载入
+bool RunSnapshotCase(const std::string &test_data_path, int iterations)
+{
+    const auto building_path = test_data_path + "/building_data.json";
+    const auto meta_path = test_data_path + "/char_meta_table.json";
+    const auto snapshot_path = (std::filesystem::temp_directory_path() / "albc_bench_game_data.snapshot").string();
+
+    albc::data::GameDataSnapshot source;
+    source.building_data = LoadStream<albc::data::building::BuildingData>(building_path);
+    source.char_meta_table = LoadStream<albc::data::game::CharacterMetaTable>(meta_path);
+    {
+        const auto image = albc::data::SerializeGameDataSnapshot(source);
+        std::ofstream ofs(snapshot_path, std::ios::binary | std::ios::trunc);
+        ofs.write(image.data(), static_cast<std::streamsize>(image.size()));
+    }
+
+    std::cout << "snapshot of building_data + char_meta_table ("
+              << std::filesystem::file_size(snapshot_path) / 1024 << " KiB)" << std::endl;
+
+    const auto snapshot = Measure(iterations, [&] { return std::make_shared<albc::data::GameDataSnapshot>(LoadSnapshot(snapshot_path)); });
+    const auto stream = Measure(iterations, [&] {
+        return std::make_pair(LoadStream<albc::data::building::BuildingData>(building_path),
+                              LoadStream<albc::data::game::CharacterMetaTable>(meta_path));
+    });
+    PrintSample("snapshot", snapshot);
+    PrintSample("stream", stream);
+    std::cout << "  speedup " << std::setprecision(2) << stream.mean_ms / snapshot.mean_ms << "x";
+
+    const auto loaded = LoadSnapshot(snapshot_path);
+    const bool same = Same(*loaded.building_data, *source.building_data) &&
+                      Same(*loaded.char_meta_table, *source.char_meta_table);
+    std::cout << ", results " << (same ? "identical" : "DIFFER") << std::endl;
+
+    std::filesystem::remove(snapshot_path);
+    return same;
+}
+} // namespace
+
+int main(int argc, char *argv[])
+{
+    std::string test_data_path;
+    if (argc > 1)
+        test_data_path = argv[1];
+    else if (std::filesystem::exists("test"))
+        test_data_path = "test";
+    else if (std::filesystem::exists("../test"))
+        test_data_path = "../test";
+    else
+    {
+        std::cerr << "Test data path not found." << std::endl;
+        return 1;
+    }
+
+    const int iterations = argc > 2 ? std::max(1, std::atoi(argv[2])) : 10;
+
+    bool all_same = true;
+    try
+    {
+        all_same &= RunCase<albc::data::building::BuildingData>(test_data_path + "/building_data.json", iterations);
+        all_same &= RunCase<albc::data::player::PlayerDataModel>(test_data_path + "/player_data.json", iterations);
+        all_same &= RunCase<albc::data::game::CharacterMetaTable>(test_data_path + "/char_meta_table.json", iterations);
+        all_same &= RunSnapshotCase(test_data_path, iterations);
+    }
+    catch (const std::exception &e)
+    {
+        std::cerr << "Benchmark failed: " << e.what() << std::endl;
+        return 1;
+    }
+
+    return all_same ? 0 : 2;
+}
@@ -0,0 +1,122 @@
+// 模型构建基准：测量由玩家数据构建算法参数（干员、房间、Buff模型）及其依赖的表查找的耗时。
+// 同一源码分别以默认容器策略（albc_bench_model）与 std::map 回退（albc_bench_model_std）编译，用于对比容器策略的影响。
+// 用法: albc_bench_model[_std] [测试数据目录] [迭代次数]
+#include "algorithm_iface_params.h"
+#include "util_json_stream.h"
+#include "util_time.h"
+
+#include <filesystem>
+#include <iomanip>
+#include <iostream>
+
+namespace
+{
+using albc::util::FloatingSeconds;
+using albc::util::PerfClock;
+
+#ifdef ALBC_CONFIG_STD_CONTAINERS
+constexpr const char *kContainerPolicy = "std::map";
+#else
+constexpr const char *kContainerPolicy = "flat hash / sorted vector";
+#endif
+
+template <typename T> std::shared_ptr<T> LoadStream(const std::string &path)
+{
+    const auto text = albc::util::read_file_as_string(path);
+    albc::util::JsonStreamReader reader(text);
+    auto value = std::make_shared<T>(reader);
+    reader.ExpectEnd();
+    return value;
+}
+
+template <typename TFunc> void Measure(const char *name, int iterations, TFunc &&func)
+{
+    double total_ms = 0;
+    double min_ms = std::numeric_limits<double>::max();
+    size_t checksum = 0;
+    for (int i = 0; i < iterations; ++i)
+    {
+        const auto t0 = PerfClock::now();
+        checksum += func();
+        const double ms = FloatingSeconds(PerfClock::now() - t0).count() * 1000.;
+        total_ms += ms;
+        min_ms = std::min(min_ms, ms);
+    }
+
+    std::cout << "  " << std::left << std::setw(28) << name << std::right << std::fixed << std::setprecision(3)
+              << "mean " << std::setw(10) << total_ms / iterations << " ms, min " << std::setw(10) << min_ms
+              << " ms (checksum " << checksum / iterations << ")" << std::endl;
+}
+} // namespace
+
+int main(int argc, char *argv[])
+{
+    std::string test_data_path;
+    if (argc > 1)
+        test_data_path = argv[1];
+    else if (std::filesystem::exists("test"))
+        test_data_path = "test";
+    else if (std::filesystem::exists("../test"))
+        test_data_path = "../test";
+    else
+    {
+        std::cerr << "Test data path not found." << std::endl;
+        return 1;
+    }
+
+    const int iterations = argc > 2 ? std::max(1, std::atoi(argv[2])) : 20;
+    albc::util::GlobalLogConfig::SetLogLevel(albc::util::LogLevel::ERROR);
+
+    try
+    {
+        using albc::data::building::BuildingData;
+        using albc::data::player::PlayerDataModel;
+
+        const auto building_path = test_data_path + "/building_data.json";
+        const auto player_path = test_data_path + "/player_data.json";
+        const auto building_data = LoadStream<BuildingData>(building_path);
+        const auto player_data = LoadStream<PlayerDataModel>(player_path);
+
+        std::cout << "container policy: " << kContainerPolicy << ", " << iterations << " iterations" << std::endl;
+
+        Measure("load building_data", iterations, [&] { return LoadStream<BuildingData>(building_path)->chars.size(); });
+        Measure("load player_data", iterations, [&] { return LoadStream<PlayerDataModel>(player_path)->troop.chars.size(); });
+
+        // 构建模型时对 building_data 的主要访问模式：按干员Id与Buff Id查找
+        Measure("building lookups", iterations, [&] {
+            size_t found = 0;
+            for (const auto &[id, player_char] : player_data->troop.chars)
+            {
+                const auto it = building_data->chars.find(player_char->char_id);
+                if (it == building_data->chars.end())
+                    continue;
+
+                for (const auto &slot : it->second->buff_char)
+                    for (const auto &item : slot->buff_data)
+                        found += building_data->buffs.count(item.buff_id);
+            }
+            return found;
+        });
+
+        const auto build_model = [&](const PlayerDataModel &player) {
+            const albc::algorithm::iface::AlgorithmParams params(player, *building_data);
+            size_t buff_count = 0;
+            for (const auto &op : params.GetOperators())
+                buff_count += op->buffs.size();
+            return buff_count;
+        };
+        Measure("model construction", iterations, [&] { return build_model(*player_data); });
+
+        // 测试模式：所有干员满级，覆盖全部已实现的Buff
+        const auto test_mode_player_data = LoadStream<PlayerDataModel>(player_path);
+        albc::algorithm::iface::GenTestModePlayerData(*test_mode_player_data, *building_data);
+        Measure("model construction (test)", iterations, [&] { return build_model(*test_mode_player_data); });
+    }
+    catch (const std::exception &e)
+    {
+        std::cerr << "Benchmark failed: " << e.what() << std::endl;
+        return 1;
+    }
+
+    return 0;
+}
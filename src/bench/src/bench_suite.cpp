@@ -0,0 +1,533 @@
+// 基准测试套件：覆盖 Simulator::DoCalc、按房间规模的组合枚举、技能查找表构建、游戏/玩家数据解析与完整求解，
+// 每项输出带统计摘要的结果，可写出为 JSON/CSV，用于比较不同版本之间的性能。
+// 用法: albc_bench [-d 测试数据目录] [-n 迭代次数] [-w 预热次数] [-f 名称过滤] [-j 结果.json] [-v 结果.csv]
+//                  [-c character_table.json] [-i RunWithJsonParams的输入.json] [-s 合成输入参数.json]
+#include "albc/albc.h"
+#include "api_synthetic.h"
+#include "algorithm.h"
+#include "algorithm_iface_params.h"
+#include "algorithm_iface_runner.h"
+#include "data_character_lookup_table.h"
+#include "data_skill_lookup_table.h"
+#include "model_simulator.h"
+#include "util_flag.h"
+#include "util_json.h"
+#include "util_json_stream.h"
+#include "util_time.h"
+
+#include <cmath>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <numeric>
+#include <random>
+
+#define PROGRAMOPTIONS_NO_COLORS
+#include "ProgramOptions/ProgramOptions.hxx"
+
+namespace
+{
+using albc::util::FloatingSeconds;
+using albc::util::PerfClock;
+using albc::data::building::BuildingData;
+using albc::data::building::RoomType;
+using albc::data::player::PlayerDataModel;
+
+constexpr std::uint32_t kMixSeed = 20220424;
+constexpr size_t kMixesPerRoom = 512;
+
+template <typename T> std::shared_ptr<T> LoadStream(const std::string &path)
+{
+    const auto text = albc::util::read_file_as_string(path);
+    albc::util::JsonStreamReader reader(text);
+    auto value = std::make_shared<T>(reader);
+    reader.ExpectEnd();
+    return value;
+}
+
+struct Summary
+{
+    std::string name;
+    size_t samples = 0;
+    double items = 0; // 每次迭代处理的单位数（组合数、Buff组合数等），用于折算单位耗时
+    double mean_ms = 0;
+    double stddev_ms = 0;
+    double min_ms = 0;
+    double p50_ms = 0;
+    double p90_ms = 0;
+    double p99_ms = 0;
+    double max_ms = 0;
+    albc::Vector<std::pair<std::string, double>> counters; // 附加的规模指标（列数、组合数等），只写入 JSON
+
+    [[nodiscard]] double NsPerItem() const
+    {
+        return items > 0 ? mean_ms * 1e6 / items : 0;
+    }
+
+    explicit operator Json::Value() const
+    {
+        Json::Value val;
+        val["name"] = name;
+        val["samples"] = static_cast<Json::UInt64>(samples);
+        val["items"] = items;
+        val["mean_ms"] = mean_ms;
+        val["stddev_ms"] = stddev_ms;
+        val["min_ms"] = min_ms;
+        val["p50_ms"] = p50_ms;
+        val["p90_ms"] = p90_ms;
+        val["p99_ms"] = p99_ms;
+        val["max_ms"] = max_ms;
+        val["ns_per_item"] = NsPerItem();
+        for (const auto &[key, value] : counters)
+            val["counters"][key] = value;
+        return val;
+    }
+};
+
+double Percentile(const albc::Vector<double> &sorted, double p)
+{
+    // 最近秩法
+    const auto rank = static_cast<size_t>(std::ceil(p * static_cast<double>(sorted.size())));
+    return sorted[std::clamp<size_t>(rank, 1, sorted.size()) - 1];
+}
+
+class BenchSuite
+{
+  public:
+    BenchSuite(int iterations, int warmup, std::string filter)
+        : iterations_(iterations), warmup_(warmup), filter_(std::move(filter))
+    {
+    }
+
+    [[nodiscard]] bool Enabled(const std::string &name) const
+    {
+        return filter_.empty() || name.find(filter_) != std::string::npos;
+    }
+
+    // func 执行一次被测操作，返回本次处理的单位数
+    template <typename TFunc> void Run(const std::string &name, TFunc &&func)
+    {
+        if (!Enabled(name))
+            return;
+
+        for (int i = 0; i < warmup_; ++i)
+            func();
+
+        albc::Vector<double> samples;
+        samples.reserve(iterations_);
+        size_t items = 0;
+        for (int i = 0; i < iterations_; ++i)
+        {
+            const auto t0 = PerfClock::now();
+            items = func();
+            samples.push_back(FloatingSeconds(PerfClock::now() - t0).count() * 1000.);
+        }
+
+        Summary summary;
+        summary.name = name;
+        summary.samples = samples.size();
+        summary.items = static_cast<double>(items);
+
+        std::sort(samples.begin(), samples.end());
+        double sum = 0;
+        for (const double ms : samples)
+            sum += ms;
+        summary.mean_ms = sum / static_cast<double>(samples.size());
+
+        double sq = 0;
+        for (const double ms : samples)
+            sq += (ms - summary.mean_ms) * (ms - summary.mean_ms);
+        summary.stddev_ms = samples.size() > 1 ? std::sqrt(sq / static_cast<double>(samples.size() - 1)) : 0;
+
+        summary.min_ms = samples.front();
+        summary.max_ms = samples.back();
+        summary.p50_ms = Percentile(samples, .50);
+        summary.p90_ms = Percentile(samples, .90);
+        summary.p99_ms = Percentile(samples, .99);
+
+        std::cout << "  " << std::left << std::setw(36) << name << std::right << std::fixed << std::setprecision(3)
+                  << "mean " << std::setw(10) << summary.mean_ms << " ms, p50 " << std::setw(10) << summary.p50_ms
+                  << " ms, p99 " << std::setw(10) << summary.p99_ms << " ms, sd " << std::setw(8)
+                  << summary.stddev_ms;
+        if (summary.items > 0)
+            std::cout << ", " << std::setprecision(1) << summary.NsPerItem() << " ns/item";
+        std::cout << std::endl;
+
+        results_.push_back(std::move(summary));
+    }
+
+    // 为刚运行的用例附加规模指标，用例被过滤时忽略
+    void AddCounter(const std::string &name, const std::string &key, double value)
+    {
+        if (!results_.empty() && results_.back().name == name)
+            results_.back().counters.emplace_back(key, value);
+    }
+
+    void Skip(const std::string &name, const std::string &reason)
+    {
+        if (Enabled(name))
+            std::cout << "  " << std::left << std::setw(36) << name << "skipped: " << reason << std::endl;
+    }
+
+    void WriteJson(const std::string &path) const
+    {
+        Json::Value root;
+        root["iterations"] = iterations_;
+        root["warmup"] = warmup_;
+        root["timestamp"] = albc::util::GetReadableTime();
+        root["results"] = Json::arrayValue;
+        for (const auto &summary : results_)
+            root["results"].append(static_cast<Json::Value>(summary));
+
+        std::ofstream ofs(path);
+        ofs << root.toStyledString();
+    }
+
+    void WriteCsv(const std::string &path) const
+    {
+        std::ofstream ofs(path);
+        ofs << "name,samples,items,mean_ms,stddev_ms,min_ms,p50_ms,p90_ms,p99_ms,max_ms,ns_per_item\n";
+        ofs << std::setprecision(9);
+        for (const auto &s : results_)
+        {
+            ofs << s.name << ',' << s.samples << ',' << s.items << ',' << s.mean_ms << ',' << s.stddev_ms << ','
+                << s.min_ms << ',' << s.p50_ms << ',' << s.p90_ms << ',' << s.p99_ms << ',' << s.max_ms << ','
+                << s.NsPerItem() << '\n';
+        }
+    }
+
+  private:
+    int iterations_;
+    int warmup_;
+    std::string filter_;
+    albc::Vector<Summary> results_;
+};
+
+// 借用算法基类的干员筛选与组合枚举，按房间单独测量
+class BenchCombMaker : public albc::algorithm::CombMaker
+{
+  public:
+    using CombMaker::CombMaker;
+
+    void Run(albc::algorithm::AlgorithmResult &) override
+    {
+    }
+
+    const albc::Vector<albc::model::OperatorModel *> &Filter(const albc::model::buff::RoomModel *room)
+    {
+        FilterOperators(room);
+        return inbound_ops_;
+    }
+
+    size_t Enumerate(albc::model::buff::RoomModel *room, albc::UInt32 max_n)
+    {
+        albc::mem::Arena arena;
+        albc::algorithm::AllSolutionHolder holder(arena);
+        MakeComb(inbound_ops_, max_n, room, holder);
+        return holder.calc_cnt;
+    }
+};
+
+// 以固定种子从房间的可用干员中抽取组合，记录组合内对该房间生效的Buff，与枚举时压入房间的Buff一致
+albc::Vector<albc::Vector<albc::model::buff::RoomBuff *>> RecordBuffMixes(
+    const albc::Vector<albc::model::OperatorModel *> &ops, const albc::model::buff::RoomModel *room)
+{
+    albc::Vector<albc::Vector<albc::model::buff::RoomBuff *>> mixes;
+    if (ops.empty())
+        return mixes;
+
+    std::mt19937 rng(kMixSeed);
+    albc::Vector<size_t> indices(ops.size());
+    const size_t pick = std::min(ops.size(), static_cast<size_t>(room->max_slot_count));
+    for (size_t m = 0; m < kMixesPerRoom; ++m)
+    {
+        std::iota(indices.begin(), indices.end(), 0);
+        auto &mix = mixes.emplace_back();
+        for (size_t i = 0; i < pick; ++i)
+        {
+            std::swap(indices[i], indices[i + rng() % (indices.size() - i)]);
+            for (auto *buff : ops[indices[i]]->buffs)
+            {
+                if (buff && albc::util::check_flag(buff->meta->room_type, room->type) && buff->ValidateTarget(room))
+                    mix.push_back(buff);
+            }
+        }
+    }
+    return mixes;
+}
+
+std::string ReadAll(const std::string &path)
+{
+    return albc::util::read_file_as_string(path);
+}
+
+// 合成输入：由参数生成玩家数据，测量模型构建、各类房间的完整枚举与完整求解，记录求解规模
+void RunSyntheticCases(BenchSuite &suite, const std::string &label, const albc::api::SyntheticConfig &config,
+                       const BuildingData &building_data,
+                       const albc::data::game::CharacterMetaTable *char_meta_table,
+                       const AlbcSolverParameters &solver_params)
+{
+    const std::string prefix = "synthetic/" + label + "/";
+    const PlayerDataModel player_data(albc::api::GenSyntheticPlayerData(config, building_data, char_meta_table));
+
+    suite.Run(prefix + "model/build", [&] {
+        const albc::algorithm::iface::AlgorithmParams params(player_data, building_data);
+        return params.GetOperators().size();
+    });
+
+    const albc::algorithm::iface::AlgorithmParams params(player_data, building_data);
+    for (const auto room_type : {RoomType::MANUFACTURE, RoomType::TRADING})
+    {
+        const auto &rooms = params.GetRoomsOfType(room_type);
+        if (rooms.empty())
+            continue;
+
+        BenchCombMaker comb_maker(rooms, params.GetOperators(), solver_params, params.GetArena());
+        const std::string name = prefix + "comb/" + std::string(albc::util::enum_to_string(room_type));
+        suite.Run(name, [&] {
+            size_t calc_cnt = 0;
+            for (auto *room : rooms)
+            {
+                comb_maker.Filter(room);
+                calc_cnt += comb_maker.Enumerate(room, static_cast<albc::UInt32>(room->max_slot_count));
+            }
+            return calc_cnt;
+        });
+    }
+
+    const auto solve_name = prefix + "solve";
+    AlbcSolveStats totals{};
+    suite.Run(solve_name, [&] {
+        const albc::algorithm::iface::AlgorithmParams solve_params(player_data, building_data);
+        albc::algorithm::AlgorithmResult result;
+        albc::algorithm::iface::MultiRoomIntegerProgramRunner().Run(solve_params, solver_params, result);
+        totals = result.stats.totals;
+        return static_cast<size_t>(totals.col_cnt);
+    });
+
+    suite.AddCounter(solve_name, "operators", static_cast<double>(params.GetOperators().size()));
+    suite.AddCounter(solve_name, "calc_cnt", static_cast<double>(totals.calc_cnt));
+    suite.AddCounter(solve_name, "col_cnt", totals.col_cnt);
+    suite.AddCounter(solve_name, "row_cnt", totals.row_cnt);
+    suite.AddCounter(solve_name, "matrix_nnz", static_cast<double>(totals.matrix_nnz));
+    suite.AddCounter(solve_name, "enum_time", totals.enum_time);
+    suite.AddCounter(solve_name, "solve_time", totals.solve_time);
+}
+} // namespace
+
+int main(int argc, char *argv[])
+{
+    po::parser parser;
+    std::string test_data_path, json_path, csv_path, character_table_path, params_path, synthetic_path, filter;
+    int iterations = 20, warmup = 2;
+
+    parser["data"].abbreviation('d').description("Test data directory.").bind(test_data_path);
+    parser["iterations"].abbreviation('n').description("Measured iterations per benchmark.").bind(iterations);
+    parser["warmup"].abbreviation('w').description("Unmeasured warmup iterations per benchmark.").bind(warmup);
+    parser["filter"].abbreviation('f').description("Only run benchmarks whose name contains this.").bind(filter);
+    parser["json"].abbreviation('j').description("Write results as JSON.").bind(json_path);
+    parser["csv"].abbreviation('v').description("Write results as CSV.").bind(csv_path);
+    parser["character-table"]
+        .abbreviation('c')
+        .description("character_table.json, enables skill lookup table and RunWithJsonParams benchmarks.")
+        .bind(character_table_path);
+    parser["params"]
+        .abbreviation('i')
+        .description("RunWithJsonParams input, requires --character-table.")
+        .bind(params_path);
+    parser["synthetic"]
+        .abbreviation('s')
+        .description("Synthetic input config (see api_synthetic.h), a JSON object or an array of them for a sweep.\n"
+                     "An optional \"name\" key labels each config.")
+        .bind(synthetic_path);
+    auto &help = parser["help"].abbreviation('h').description("Produce help message.");
+
+    if (!parser.parse(argc, argv))
+    {
+        std::cerr << "Error: Unable to parse commandline args!" << std::endl;
+        return 1;
+    }
+
+    if (help.was_set())
+    {
+        std::cout << parser << std::endl;
+        return 0;
+    }
+
+    if (test_data_path.empty())
+    {
+        if (std::filesystem::exists("test"))
+            test_data_path = "test";
+        else if (std::filesystem::exists("../test"))
+            test_data_path = "../test";
+        else
+        {
+            std::cerr << "Test data path not found." << std::endl;
+            return 1;
+        }
+    }
+
+    iterations = std::max(1, iterations);
+    warmup = std::max(0, warmup);
+    albc::util::GlobalLogConfig::SetLogLevel(albc::util::LogLevel::ERROR);
+
+    BenchSuite suite(iterations, warmup, filter);
+    std::cout << iterations << " iterations, " << warmup << " warmup" << std::endl;
+
+    try
+    {
+        const auto building_path = test_data_path + "/building_data.json";
+        const auto player_path = test_data_path + "/player_data.json";
+        const auto building_data = LoadStream<BuildingData>(building_path);
+        const auto player_data = LoadStream<PlayerDataModel>(player_path);
+
+        // 数据解析
+        suite.Run("parse/building_data", [&] { return LoadStream<BuildingData>(building_path)->buffs.size(); });
+        suite.Run("parse/player_data", [&] { return LoadStream<PlayerDataModel>(player_path)->troop.chars.size(); });
+
+        // 技能查找表构建
+        if (!character_table_path.empty())
+        {
+            using albc::data::game::CharacterLookupTable;
+            using albc::data::game::CharacterTable;
+            using albc::data::game::SkillLookupTable;
+
+            suite.Run("parse/character_table", [&] { return LoadStream<CharacterTable>(character_table_path)->size(); });
+
+            const auto character_lookup =
+                std::make_shared<CharacterLookupTable>(LoadStream<CharacterTable>(character_table_path));
+            suite.Run("skill_lookup_table/build", [&] {
+                const SkillLookupTable table(building_data, character_lookup);
+                return building_data->buffs.size();
+            });
+        }
+        else
+        {
+            suite.Skip("skill_lookup_table/build", "no --character-table");
+        }
+
+        // 模型构建：所有干员满级，覆盖全部已实现的Buff
+        const auto test_mode_player_data = LoadStream<PlayerDataModel>(player_path);
+        albc::algorithm::iface::GenTestModePlayerData(*test_mode_player_data, *building_data);
+        suite.Run("model/build", [&] {
+            const albc::algorithm::iface::AlgorithmParams params(*test_mode_player_data, *building_data);
+            return params.GetOperators().size();
+        });
+
+        const albc::algorithm::iface::AlgorithmParams params(*test_mode_player_data, *building_data);
+        AlbcSolverParameters solver_params{};
+        solver_params.model_time_limit = 57600;
+        solver_params.solve_time_limit = 60;
+
+        for (const auto room_type : {RoomType::MANUFACTURE, RoomType::TRADING, RoomType::POWER})
+        {
+            const auto &rooms = params.GetRoomsOfType(room_type);
+            if (rooms.empty())
+                continue;
+
+            auto *room = rooms.front();
+            const std::string type_name(albc::util::enum_to_string(room_type));
+            BenchCombMaker comb_maker(rooms, params.GetOperators(), solver_params, params.GetArena());
+            const auto &inbound_ops = comb_maker.Filter(room);
+
+            // Simulator::DoCalc：重放记录的Buff组合
+            const auto mixes = RecordBuffMixes(inbound_ops, room);
+            suite.Run("simulator/do_calc/" + type_name, [&] {
+                double checksum = 0;
+                for (const auto &mix : mixes)
+                {
+                    room->n_buff = 0;
+                    for (auto *buff : mix)
+                        room->PushBuff(buff);
+
+                    double result, duration;
+                    albc::model::buff::Simulator::DoCalc(room, solver_params.model_time_limit, result, duration);
+                    checksum += result;
+                }
+                room->n_buff = 0;
+                return checksum > 0 ? mixes.size() : 0;
+            });
+
+            // 组合枚举：按房间槽位数
+            for (int n = 1; n <= room->max_slot_count; ++n)
+            {
+                suite.Run("comb/" + type_name + "/" + std::to_string(n),
+                          [&] { return comb_maker.Enumerate(room, static_cast<albc::UInt32>(n)); });
+            }
+        }
+
+        // 完整求解：由玩家数据构建模型并使用整数规划求解
+        suite.Run("solve/player_data", [&] {
+            const albc::algorithm::iface::AlgorithmParams solve_params(*player_data, *building_data);
+            albc::algorithm::AlgorithmResult result;
+            albc::algorithm::iface::MultiRoomIntegerProgramRunner().Run(solve_params, solver_params, result);
+            return static_cast<size_t>(result.stats.totals.col_cnt);
+        });
+
+        // 合成输入：按参数扫描输入规模
+        if (!synthetic_path.empty())
+        {
+            std::shared_ptr<albc::data::game::CharacterMetaTable> char_meta_table;
+            const auto char_meta_path = test_data_path + "/char_meta_table.json";
+            if (std::filesystem::exists(char_meta_path))
+                char_meta_table = LoadStream<albc::data::game::CharacterMetaTable>(char_meta_path);
+
+            const auto synthetic_json = albc::util::read_json_from_char_array(ReadAll(synthetic_path).c_str());
+            Json::Value configs = synthetic_json;
+            if (!synthetic_json.isArray())
+            {
+                configs = Json::arrayValue;
+                configs.append(synthetic_json);
+            }
+
+            for (Json::ArrayIndex i = 0; i < configs.size(); ++i)
+            {
+                const auto &config_json = configs[i];
+                const auto label = config_json.get("name", std::to_string(i)).asString();
+                RunSyntheticCases(suite, label, albc::api::SyntheticConfig(config_json), *building_data,
+                                  char_meta_table.get(), solver_params);
+            }
+        }
+
+        // 完整 API 调用：RunWithJsonParams
+        if (!character_table_path.empty() && !params_path.empty())
+        {
+            albc::LoadGameDataFile(ALBC_GAME_DATA_DB_BUILDING_DATA, building_path.c_str());
+            albc::LoadGameDataFile(ALBC_GAME_DATA_DB_CHARACTER_TABLE, character_table_path.c_str());
+            const auto char_meta_path = test_data_path + "/char_meta_table.json";
+            if (std::filesystem::exists(char_meta_path))
+                albc::LoadGameDataFile(ALBC_GAME_DATA_DB_CHAR_META_TABLE, char_meta_path.c_str());
+
+            const auto params_json = ReadAll(params_path);
+            suite.Run("api/run_with_json_params", [&] {
+                AlbcException *e = nullptr;
+                const auto out = albc::RunWithJsonParams(params_json.c_str(), &e);
+                if (e)
+                {
+                    const std::string what = e->what;
+                    albc::FreeException(e);
+                    throw std::runtime_error("RunWithJsonParams failed: " + what);
+                }
+                return std::strlen(out.c_str());
+            });
+        }
+        else
+        {
+            suite.Skip("api/run_with_json_params", "needs --character-table and --params");
+        }
+    }
+    catch (const std::exception &e)
+    {
+        std::cerr << "Benchmark failed: " << e.what() << std::endl;
+        return 1;
+    }
+
+    if (!json_path.empty())
+        suite.WriteJson(json_path);
+    if (!csv_path.empty())
+        suite.WriteCsv(csv_path);
+
+    return 0;
+}
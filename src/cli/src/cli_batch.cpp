@@ -0,0 +1,313 @@
+#include "cli_batch.h"
+#include "albc/albc.h"
+#include "cli_file.h"
+#include "cli_json.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <memory>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+namespace fs = std::filesystem;
+
+namespace
+{
+enum class InputKind
+{
+    PLAYER_DATA,
+    JSON_PARAMS,
+};
+
+const char *get_input_kind_name(InputKind kind)
+{
+    return kind == InputKind::PLAYER_DATA ? "player_data" : "json_params";
+}
+
+struct FileRecord
+{
+    fs::path path;
+    InputKind kind = InputKind::JSON_PARAMS;
+    bool ok = false;
+    std::string error;
+    fs::path result_path;
+    double read_time = 0;  // 秒
+    double solve_time = 0; // 秒
+};
+
+// 只支持 * 与 ?
+bool match_wildcard(const char *pattern, const char *str)
+{
+    if (*pattern == '\0')
+        return *str == '\0';
+
+    if (*pattern == '*')
+        return match_wildcard(pattern + 1, str) || (*str != '\0' && match_wildcard(pattern, str + 1));
+
+    if (*str == '\0')
+        return false;
+
+    return (*pattern == '?' || *pattern == *str) && match_wildcard(pattern + 1, str + 1);
+}
+
+// 目录取其中所有 .json 文件（不递归），否则按文件名中的通配符匹配所在目录下的文件
+std::vector<fs::path> collect_input_files(const std::string &input)
+{
+    const fs::path input_path(input);
+    std::vector<fs::path> files;
+    if (fs::is_directory(input_path))
+    {
+        for (const auto &entry : fs::directory_iterator(input_path))
+            if (entry.is_regular_file() && entry.path().extension() == ".json")
+                files.push_back(entry.path());
+    }
+    else
+    {
+        const auto pattern = input_path.filename().string();
+        if (pattern.find_first_of("*?") == std::string::npos)
+        {
+            if (!fs::is_regular_file(input_path))
+                throw std::runtime_error("Could not find input file: " + input);
+
+            files.push_back(input_path);
+        }
+        else
+        {
+            const auto dir = input_path.has_parent_path() ? input_path.parent_path() : fs::path(".");
+            for (const auto &entry : fs::directory_iterator(dir))
+                if (entry.is_regular_file() && match_wildcard(pattern.c_str(), entry.path().filename().string().c_str()))
+                    files.push_back(entry.path());
+        }
+    }
+
+    std::sort(files.begin(), files.end());
+    return files;
+}
+
+void write_text(const fs::path &path, const std::string &text)
+{
+    std::ofstream ofs(path, std::ios::binary);
+    if (!ofs.is_open())
+        throw std::runtime_error("Could not open file: " + path.string());
+
+    ofs << text;
+}
+
+// 游戏导出的玩家数据顶层总含有 troop 字段，请求 JSON 的顶层只有 chars 与 rooms 等
+InputKind detect_input_kind(const std::string &text)
+{
+    return json_has_top_level_key(text, "troop") ? InputKind::PLAYER_DATA : InputKind::JSON_PARAMS;
+}
+
+void throw_if_failed(AlbcException *e)
+{
+    if (!e)
+        return;
+
+    const std::string what = e->what;
+    albc::FreeException(e);
+    throw std::runtime_error(what);
+}
+
+// 与 RunWithJsonParams 结果中的 rooms 及 stats 字段名保持一致
+std::string result_to_json(const albc::IResult &result)
+{
+    std::string json = "{\"status\":" + std::to_string(result.GetStatus()) + ",\"rooms\":{";
+    bool first_room = true;
+    for (const auto &room : *result.GetRoomDetails())
+    {
+        if (!first_room)
+            json += ',';
+        first_room = false;
+
+        json += json_quote(room->GetIdentifier().c_str()) + ":{\"score\":" + json_number(room->GetScore()) +
+                ",\"duration\":" + json_number(room->GetDuration()) + ",\"chars\":[";
+        bool first_char = true;
+        for (const auto &char_id : *room->GetCharacterIdentifiers())
+        {
+            if (!first_char)
+                json += ',';
+            first_char = false;
+            json += json_quote(char_id.c_str());
+        }
+        json += "]}";
+    }
+
+    const auto stats = result.GetStats();
+    json += "},\"stats\":{";
+    json += "\"data_feed_time\":" + json_number(stats.data_feed_time);
+    json += ",\"filter_time\":" + json_number(stats.filter_time);
+    json += ",\"enum_time\":" + json_number(stats.enum_time);
+    json += ",\"solve_time\":" + json_number(stats.solve_time);
+    json += ",\"total_time\":" + json_number(stats.total_time);
+    json += ",\"gap\":" + json_number(stats.gap);
+    json += ",\"calc_cnt\":" + std::to_string(stats.calc_cnt);
+    json += ",\"matrix_nnz\":" + std::to_string(stats.matrix_nnz);
+    json += ",\"peak_memory\":" + std::to_string(stats.peak_memory);
+    json += ",\"col_cnt\":" + std::to_string(stats.col_cnt);
+    json += ",\"row_cnt\":" + std::to_string(stats.row_cnt);
+    json += ",\"node_cnt\":" + std::to_string(stats.node_cnt);
+    json += ",\"lp_iterations\":" + std::to_string(stats.lp_iterations);
+    return json + "}}\n";
+}
+
+std::string solve(InputKind kind, const std::string &text)
+{
+    AlbcException *e = nullptr;
+    if (kind == InputKind::JSON_PARAMS)
+    {
+        const auto result = albc::RunWithJsonParams(text.c_str(), &e);
+        throw_if_failed(e);
+        return result.c_str();
+    }
+
+    const std::unique_ptr<albc::Model> model(albc::Model::FromJson(text.c_str(), &e));
+    throw_if_failed(e);
+    const std::unique_ptr<albc::IResult> result(model->GetResult(&e));
+    throw_if_failed(e);
+    return result_to_json(*result);
+}
+
+double seconds_since(const std::chrono::steady_clock::time_point &start)
+{
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+void process_file(FileRecord &record, const fs::path &output_dir)
+{
+    try
+    {
+        auto start = std::chrono::steady_clock::now();
+        const auto text = read_file(record.path.string());
+        record.kind = detect_input_kind(text);
+        record.read_time = seconds_since(start);
+
+        start = std::chrono::steady_clock::now();
+        const auto result = solve(record.kind, text);
+        record.solve_time = seconds_since(start);
+
+        record.result_path = output_dir / (record.path.stem().string() + ".result.json");
+        write_text(record.result_path, result);
+        record.ok = true;
+    }
+    catch (const std::exception &ex)
+    {
+        record.error = ex.what();
+    }
+}
+
+// 最近秩法，values 需已排序
+double percentile(const std::vector<double> &values, double p)
+{
+    if (values.empty())
+        return 0;
+
+    const auto rank = static_cast<size_t>(std::ceil(p * static_cast<double>(values.size())));
+    return values[std::min(values.size(), std::max<size_t>(rank, 1)) - 1];
+}
+
+std::string make_summary(const std::vector<FileRecord> &records, int workers, double wall_time)
+{
+    std::vector<double> solve_times;
+    double total_solve_time = 0;
+    size_t succeeded = 0;
+    for (const auto &record : records)
+    {
+        if (!record.ok)
+            continue;
+
+        ++succeeded;
+        solve_times.push_back(record.solve_time);
+        total_solve_time += record.solve_time;
+    }
+    std::sort(solve_times.begin(), solve_times.end());
+
+    std::string json = "{\n";
+    json += "\t\"workers\" : " + std::to_string(workers) + ",\n";
+    json += "\t\"files\" : " + std::to_string(records.size()) + ",\n";
+    json += "\t\"succeeded\" : " + std::to_string(succeeded) + ",\n";
+    json += "\t\"failed\" : " + std::to_string(records.size() - succeeded) + ",\n";
+    json += "\t\"wall_time\" : " + json_number(wall_time) + ",\n";
+    json += "\t\"files_per_second\" : " + json_number(wall_time > 0 ? static_cast<double>(records.size()) / wall_time : 0) + ",\n";
+    json += "\t\"solve_time\" : {";
+    json += "\"total\" : " + json_number(total_solve_time);
+    json += ", \"mean\" : " + json_number(succeeded ? total_solve_time / static_cast<double>(succeeded) : 0);
+    json += ", \"p50\" : " + json_number(percentile(solve_times, 0.50));
+    json += ", \"p90\" : " + json_number(percentile(solve_times, 0.90));
+    json += ", \"p99\" : " + json_number(percentile(solve_times, 0.99));
+    json += ", \"max\" : " + json_number(solve_times.empty() ? 0 : solve_times.back());
+    json += "},\n";
+
+    json += "\t\"results\" : [";
+    for (size_t i = 0; i < records.size(); ++i)
+    {
+        const auto &record = records[i];
+        json += i ? ",\n\t\t{" : "\n\t\t{";
+        json += "\"file\" : " + json_quote(record.path.string());
+        json += ", \"kind\" : " + json_quote(get_input_kind_name(record.kind));
+        json += ", \"ok\" : ";
+        json += record.ok ? "true" : "false";
+        if (record.ok)
+            json += ", \"result\" : " + json_quote(record.result_path.string());
+        else
+            json += ", \"error\" : " + json_quote(record.error);
+        json += ", \"read_time\" : " + json_number(record.read_time);
+        json += ", \"solve_time\" : " + json_number(record.solve_time);
+        json += "}";
+    }
+    json += records.empty() ? "]\n}\n" : "\n\t]\n}\n";
+    return json;
+}
+} // namespace
+
+int run_batch(const BatchOptions &options)
+{
+    const auto files = collect_input_files(options.input);
+    if (files.empty())
+    {
+        std::cerr << "No input files matched: " << options.input << std::endl;
+        return -1;
+    }
+
+    const fs::path output_dir(options.output_dir);
+    fs::create_directories(output_dir);
+
+    const int workers =
+        std::min(options.workers > 0 ? options.workers
+                                     : std::max(1, static_cast<int>(std::thread::hardware_concurrency())),
+                 static_cast<int>(files.size()));
+    std::cout << "Batch: " << files.size() << " files, " << workers << " workers." << std::endl;
+
+    std::vector<FileRecord> records(files.size());
+    for (size_t i = 0; i < files.size(); ++i)
+        records[i].path = files[i];
+
+    const auto start = std::chrono::steady_clock::now();
+    std::atomic<size_t> next{0};
+    std::vector<std::thread> threads;
+    threads.reserve(workers);
+    for (int i = 0; i < workers; ++i)
+    {
+        threads.emplace_back([&] {
+            for (size_t idx; (idx = next.fetch_add(1)) < records.size();)
+                process_file(records[idx], output_dir);
+        });
+    }
+    for (auto &thread : threads)
+        thread.join();
+    const double wall_time = seconds_since(start);
+
+    const auto summary_path = output_dir / "summary.json";
+    write_text(summary_path, make_summary(records, workers, wall_time));
+
+    const auto failed = std::count_if(records.begin(), records.end(), [](const FileRecord &r) { return !r.ok; });
+    std::cout << "Batch completed in " << wall_time << "s: " << records.size() - failed << " succeeded, " << failed
+              << " failed. Summary written to: " << summary_path.string() << std::endl;
+    return failed ? -1 : 0;
+}
@@ -0,0 +1,14 @@
+#pragma once
+#include <string>
+
+struct BatchOptions
+{
+    std::string input;      // 目录（其中所有 .json 文件）或文件名带 * ? 通配符的路径
+    std::string output_dir; // 结果及 summary.json 的输出目录，不存在时创建
+    int workers = 0;        // 求解线程数，<=0 时取硬件并发数
+};
+
+// 批量求解，游戏数据需预先载入。每个输入文件可以是玩家数据或 RunWithJsonParams 的请求，
+// 结果写入 <output_dir>/<不含扩展名的文件名>.result.json，各文件的状态与耗时汇总写入 <output_dir>/summary.json。
+// 全部成功时返回 0。
+int run_batch(const BatchOptions &options);
@@ -0,0 +1,19 @@
+#pragma once
+#include <fstream>
+#include <stdexcept>
+#include <string>
+
+// 按文件大小一次读入，避免经过 stringstream 再复制出字符串
+inline std::string read_file(const std::string &filename)
+{
+    std::ifstream ifs(filename, std::ios::binary | std::ios::ate);
+    if (!ifs.is_open())
+    {
+        throw std::runtime_error("Could not open file: " + filename);
+    }
+    std::string content(static_cast<size_t>(ifs.tellg()), '\0');
+    ifs.seekg(0);
+    ifs.read(content.data(), static_cast<std::streamsize>(content.size()));
+    content.resize(static_cast<size_t>(ifs.gcount()));
+    return content;
+}
@@ -0,0 +1,80 @@
+#pragma once
+#include <cmath>
+#include <cstdio>
+#include <string>
+
+// 转义为带引号的 JSON 字符串
+inline std::string json_quote(const std::string &str)
+{
+    std::string quoted = "\"";
+    for (const char ch : str)
+    {
+        switch (ch)
+        {
+        case '"':
+            quoted += "\\\"";
+            break;
+        case '\\':
+            quoted += "\\\\";
+            break;
+        default:
+            if (static_cast<unsigned char>(ch) < 0x20)
+            {
+                char buf[8];
+                std::snprintf(buf, sizeof(buf), "\\u%04x", ch);
+                quoted += buf;
+            }
+            else
+            {
+                quoted.push_back(ch);
+            }
+        }
+    }
+    return quoted + "\"";
+}
+
+// JSON 不支持 NaN 与无穷大，输出为 null
+inline std::string json_number(double value)
+{
+    if (!std::isfinite(value))
+        return "null";
+
+    char buf[32];
+    std::snprintf(buf, sizeof(buf), "%.17g", value);
+    return buf;
+}
+
+// 顶层对象是否含有名为 key 的字段，只扫描顶层的键，不解析值，字符串中的内容与嵌套对象中的同名字段不计。
+// key 按原文比较，不处理转义
+inline bool json_has_top_level_key(const std::string &json, const std::string &key)
+{
+    int depth = 0;
+    for (size_t i = 0; i < json.size(); ++i)
+    {
+        const char ch = json[i];
+        if (ch == '{' || ch == '[')
+        {
+            ++depth;
+        }
+        else if (ch == '}' || ch == ']')
+        {
+            --depth;
+        }
+        else if (ch == '"')
+        {
+            const size_t start = i + 1;
+            for (++i; i < json.size() && json[i] != '"'; ++i)
+                if (json[i] == '\\')
+                    ++i;
+
+            if (depth != 1 || json.compare(start, i - start, key) != 0)
+                continue;
+
+            // 之后的第一个非空白字符为 ':' 时是键
+            const size_t next = json.find_first_not_of(" \t\r\n", i + 1);
+            if (next != std::string::npos && json[next] == ':')
+                return true;
+        }
+    }
+    return false;
+}
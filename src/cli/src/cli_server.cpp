@@ -0,0 +1,515 @@
+#include "cli_server.h"
+#include "albc/albc.h"
+#include "cli_json.h"
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstring>
+#include <deque>
+#include <iostream>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <system_error>
+#include <thread>
+#include <vector>
+
+#ifndef _WIN32
+#   include <cerrno>
+#   include <csignal>
+#   include <sys/socket.h>
+#   include <sys/stat.h>
+#   include <sys/un.h>
+#   include <unistd.h>
+#endif
+
+namespace
+{
+// 每个工作线程最多排队的请求数，读满后暂停读取，由客户端一侧承受背压
+constexpr size_t kQueuedRequestsPerWorker = 4;
+// 每条连接最多未写出的结果数（含求解中的请求），客户端不读取结果时只暂停该连接的读取
+constexpr size_t kPendingResponsesPerConnection = 64;
+
+// 库输出的是格式化的多行 JSON，字符串中的控制字符都已转义，去掉换行与制表符即为一行
+std::string to_single_line(const char *json)
+{
+    std::string line;
+    for (const char *p = json; *p; ++p)
+        if (*p != '\n' && *p != '\r' && *p != '\t')
+            line.push_back(*p);
+    return line;
+}
+
+std::string make_error_response(const std::string &message)
+{
+    return "{\"error\":" + json_quote(message) + "}";
+}
+
+std::string solve_request(const std::string &request)
+{
+    AlbcException *e = nullptr;
+    const auto result = albc::RunWithJsonParams(request.c_str(), &e);
+    if (e)
+    {
+        const std::string what = e->what;
+        albc::FreeException(e);
+        return make_error_response(what);
+    }
+    return to_single_line(result.c_str());
+}
+
+// 一条连接的输出端，结果按请求的接收顺序由该连接自己的写线程（Drain）写出，求解线程从不等待客户端 I/O
+class ResponseWriter
+{
+  public:
+    virtual ~ResponseWriter() = default;
+
+    // 由读取线程在提交请求前调用，未写出的结果达到上限时阻塞，暂停读取该连接
+    unsigned long long Reserve()
+    {
+        std::unique_lock lock(mutex_);
+        written_.wait(lock, [this] { return next_seq_ - next_write_seq_ < kPendingResponsesPerConnection; });
+        return next_seq_++;
+    }
+
+    // 由求解线程调用，只把结果交给写线程
+    void Complete(unsigned long long seq, std::string response)
+    {
+        {
+            std::lock_guard lock(mutex_);
+            pending_.emplace(seq, std::move(response));
+        }
+        ready_.notify_one();
+    }
+
+    // 读取线程不再提交请求，Drain 写完已提交的结果后返回
+    void Close()
+    {
+        {
+            std::lock_guard lock(mutex_);
+            closed_ = true;
+        }
+        ready_.notify_one();
+    }
+
+    // 在写线程上运行，按顺序写出结果
+    void Drain()
+    {
+        std::unique_lock lock(mutex_);
+        for (;;)
+        {
+            ready_.wait(lock, [this] {
+                return (!pending_.empty() && pending_.begin()->first == next_write_seq_) ||
+                       (closed_ && next_write_seq_ == next_seq_);
+            });
+            if (pending_.empty() || pending_.begin()->first != next_write_seq_)
+                return;
+
+            const auto node = pending_.extract(pending_.begin());
+            lock.unlock();
+            WriteLine(node.mapped());
+            lock.lock();
+            ++next_write_seq_;
+            written_.notify_one();
+        }
+    }
+
+  protected:
+    // 只在写线程上调用，不持有锁
+    virtual void WriteLine(const std::string &line) = 0;
+
+  private:
+    std::mutex mutex_;
+    std::condition_variable ready_;
+    std::condition_variable written_;
+    unsigned long long next_seq_ = 0;
+    unsigned long long next_write_seq_ = 0;
+    std::map<unsigned long long, std::string> pending_;
+    bool closed_ = false;
+};
+
+// 运行 fn 期间由另一个线程写出结果，返回前写完所有已提交请求的结果
+template <typename Fn> int with_drain_thread(ResponseWriter &writer, Fn &&fn)
+{
+    std::thread drain(&ResponseWriter::Drain, &writer);
+    const int ret = fn();
+    writer.Close();
+    drain.join();
+    return ret;
+}
+
+// 读取一行（不含换行符），超出 max_bytes 时返回 false，输入结束时 line 为空且 in 处于 eof
+bool read_line(std::istream &in, std::string &line, size_t max_bytes)
+{
+    using traits = std::istream::traits_type;
+    line.clear();
+    auto *buf = in.rdbuf();
+    for (auto c = buf->sbumpc(); !traits::eq_int_type(c, traits::eof()); c = buf->sbumpc())
+    {
+        if (traits::to_char_type(c) == '\n')
+            return true;
+
+        if (line.size() == max_bytes)
+            return false;
+
+        line.push_back(traits::to_char_type(c));
+    }
+    in.setstate(std::ios::eofbit);
+    return true;
+}
+
+std::string make_oversized_response(size_t max_request_bytes)
+{
+    return make_error_response("Request line exceeds " + std::to_string(max_request_bytes) +
+                               " bytes, closing connection.");
+}
+
+class StdoutResponseWriter : public ResponseWriter
+{
+  protected:
+    void WriteLine(const std::string &line) override
+    {
+        std::cout << line << '\n' << std::flush;
+    }
+};
+
+struct Job
+{
+    std::shared_ptr<ResponseWriter> writer;
+    unsigned long long seq;
+    std::string request;
+};
+
+class WorkerPool
+{
+  public:
+    explicit WorkerPool(int workers) : capacity_(kQueuedRequestsPerWorker * workers)
+    {
+        for (int i = 0; i < workers; ++i)
+            threads_.emplace_back(&WorkerPool::Run, this);
+    }
+
+    // 处理完已提交的请求后返回
+    ~WorkerPool()
+    {
+        {
+            std::lock_guard lock(mutex_);
+            stopping_ = true;
+        }
+        not_empty_.notify_all();
+        for (auto &thread : threads_)
+            thread.join();
+    }
+
+    // 队列已满时阻塞
+    void Submit(Job job)
+    {
+        std::unique_lock lock(mutex_);
+        not_full_.wait(lock, [this] { return queue_.size() < capacity_; });
+        queue_.push_back(std::move(job));
+        lock.unlock();
+        not_empty_.notify_one();
+    }
+
+  private:
+    void Run()
+    {
+        for (;;)
+        {
+            std::unique_lock lock(mutex_);
+            not_empty_.wait(lock, [this] { return stopping_ || !queue_.empty(); });
+            if (queue_.empty())
+                return;
+
+            Job job = std::move(queue_.front());
+            queue_.pop_front();
+            lock.unlock();
+            not_full_.notify_one();
+
+            job.writer->Complete(job.seq, solve_request(job.request));
+        }
+    }
+
+    const size_t capacity_;
+    std::mutex mutex_;
+    std::condition_variable not_empty_;
+    std::condition_variable not_full_;
+    std::deque<Job> queue_;
+    bool stopping_ = false;
+    std::vector<std::thread> threads_;
+};
+
+void submit_line(std::string line, const std::shared_ptr<ResponseWriter> &writer, WorkerPool &pool)
+{
+    if (!line.empty() && line.back() == '\r')
+        line.pop_back();
+
+    if (line.find_first_not_of(" \t") == std::string::npos)
+        return;
+
+    const auto seq = writer->Reserve();
+    pool.Submit({writer, seq, std::move(line)});
+}
+
+int serve_stdin(WorkerPool &pool, size_t max_request_bytes)
+{
+    const auto writer = std::make_shared<StdoutResponseWriter>();
+    return with_drain_thread(*writer, [&] {
+        std::string line;
+        while (!std::cin.eof())
+        {
+            if (!read_line(std::cin, line, max_request_bytes))
+            {
+                writer->Complete(writer->Reserve(), make_oversized_response(max_request_bytes));
+                return -1;
+            }
+            submit_line(std::move(line), writer, pool);
+        }
+        return 0;
+    });
+}
+
+#ifndef _WIN32
+class SocketResponseWriter : public ResponseWriter
+{
+  public:
+    explicit SocketResponseWriter(int fd) : fd_(fd)
+    {
+    }
+
+    // 写线程结束且所有求解线程都已交回结果后关闭连接
+    ~SocketResponseWriter() override
+    {
+        ::close(fd_);
+    }
+
+    // 客户端已断开，读取线程不再提交缓冲区中剩余的请求
+    [[nodiscard]] bool Broken() const
+    {
+        return broken_.load(std::memory_order_relaxed);
+    }
+
+  protected:
+    void WriteLine(const std::string &line) override
+    {
+        if (Broken())
+            return;
+
+        const std::string data = line + '\n';
+        size_t written = 0;
+        while (written < data.size())
+        {
+            const auto n = ::write(fd_, data.data() + written, data.size() - written);
+            if (n < 0 && errno == EINTR)
+                continue;
+
+            if (n <= 0)
+            {
+                broken_.store(true, std::memory_order_relaxed); // 客户端已断开，丢弃之后的结果
+                return;
+            }
+            written += static_cast<size_t>(n);
+        }
+    }
+
+  private:
+    int fd_;
+    std::atomic<bool> broken_ = false;
+};
+
+// 存活的连接数，达到上限时暂停 accept，新连接在监听队列中等待
+class ConnectionLimiter
+{
+  public:
+    explicit ConnectionLimiter(size_t max_connections) : max_connections_(max_connections)
+    {
+    }
+
+    void Acquire()
+    {
+        std::unique_lock lock(mutex_);
+        released_.wait(lock, [this] { return live_ < max_connections_; });
+        ++live_;
+    }
+
+    void Release()
+    {
+        // 持锁通知：WaitIdle 返回后 limiter 即可能析构
+        std::lock_guard lock(mutex_);
+        --live_;
+        released_.notify_all();
+    }
+
+    void WaitIdle()
+    {
+        std::unique_lock lock(mutex_);
+        released_.wait(lock, [this] { return live_ == 0; });
+    }
+
+  private:
+    const size_t max_connections_;
+    std::mutex mutex_;
+    std::condition_variable released_;
+    size_t live_ = 0;
+};
+
+void serve_connection(int fd, WorkerPool &pool, size_t max_request_bytes)
+{
+    const auto writer = std::make_shared<SocketResponseWriter>(fd);
+    // 已提交请求的结果仍按顺序写出，之后随 writer 析构关闭连接
+    const auto reject_oversized = [&] {
+        writer->Complete(writer->Reserve(), make_oversized_response(max_request_bytes));
+        return -1;
+    };
+
+    with_drain_thread(*writer, [&] {
+        std::string buffer;
+        char chunk[64 * 1024];
+        for (;;)
+        {
+            const auto n = ::read(fd, chunk, sizeof(chunk));
+            if (n < 0 && errno == EINTR)
+                continue;
+
+            if (n <= 0)
+                break;
+
+            buffer.append(chunk, static_cast<size_t>(n));
+            size_t start = 0;
+            for (size_t end; (end = buffer.find('\n', start)) != std::string::npos; start = end + 1)
+            {
+                if (writer->Broken())
+                    return -1;
+
+                if (end - start > max_request_bytes)
+                    return reject_oversized();
+
+                submit_line(buffer.substr(start, end - start), writer, pool);
+            }
+
+            buffer.erase(0, start);
+            if (buffer.size() > max_request_bytes)
+                return reject_oversized();
+        }
+
+        // 最后一行可以没有换行符
+        submit_line(std::move(buffer), writer, pool);
+        return 0;
+    });
+}
+
+// 路径不存在或是 socket 时返回 true 并删除；其他类型的文件不删除，以免误删用户文件
+bool remove_socket_file(const std::string &path)
+{
+    struct stat st{};
+    if (::lstat(path.c_str(), &st) < 0)
+        return errno == ENOENT;
+
+    if (!S_ISSOCK(st.st_mode))
+        return false;
+
+    return ::unlink(path.c_str()) == 0 || errno == ENOENT;
+}
+
+int serve_socket(const ServerOptions &options, WorkerPool &pool)
+{
+    const auto &path = options.socket_path;
+    sockaddr_un addr{};
+    if (path.size() >= sizeof(addr.sun_path))
+    {
+        std::cerr << "Socket path too long: " << path << std::endl;
+        return -1;
+    }
+
+    const int listen_fd = ::socket(AF_UNIX, SOCK_STREAM, 0);
+    if (listen_fd < 0)
+    {
+        std::cerr << "Unable to create socket: " << std::strerror(errno) << std::endl;
+        return -1;
+    }
+
+    addr.sun_family = AF_UNIX;
+    std::strncpy(addr.sun_path, path.c_str(), sizeof(addr.sun_path) - 1);
+    if (!remove_socket_file(path)) // 上次异常退出时残留的 socket 文件
+    {
+        std::cerr << "Refusing to replace " << path << ": it exists and is not a socket." << std::endl;
+        ::close(listen_fd);
+        return -1;
+    }
+    if (::bind(listen_fd, reinterpret_cast<sockaddr *>(&addr), sizeof(addr)) < 0 || ::listen(listen_fd, SOMAXCONN) < 0)
+    {
+        std::cerr << "Unable to listen on " << path << ": " << std::strerror(errno) << std::endl;
+        ::close(listen_fd);
+        return -1;
+    }
+
+    // 客户端断开后写入不应终止进程
+    std::signal(SIGPIPE, SIG_IGN);
+    std::cerr << "Listening on " << path << std::endl;
+
+    // 连接线程分离运行，结束时归还名额；退出前等待所有连接线程结束，它们引用着 pool 与 limiter
+    ConnectionLimiter limiter(static_cast<size_t>(std::max(options.max_connections, 1)));
+    for (;;)
+    {
+        limiter.Acquire();
+        const int fd = ::accept(listen_fd, nullptr, nullptr);
+        if (fd < 0)
+        {
+            limiter.Release();
+            if (errno == EINTR || errno == ECONNABORTED)
+                continue;
+
+            std::cerr << "accept failed: " << std::strerror(errno) << std::endl;
+            break;
+        }
+
+        try
+        {
+            std::thread([fd, &pool, &limiter, max_request_bytes = options.max_request_bytes] {
+                try
+                {
+                    serve_connection(fd, pool, max_request_bytes);
+                }
+                catch (const std::system_error &e)
+                {
+                    std::cerr << "Unable to start response thread: " << e.what() << std::endl;
+                }
+                limiter.Release();
+            }).detach();
+        }
+        catch (const std::system_error &e)
+        {
+            std::cerr << "Unable to start connection thread: " << e.what() << std::endl;
+            ::close(fd);
+            limiter.Release();
+        }
+    }
+
+    ::close(listen_fd);
+    remove_socket_file(path);
+    limiter.WaitIdle();
+
+    return -1;
+}
+#endif
+} // namespace
+
+int run_server(const ServerOptions &options)
+{
+    const int workers =
+        options.workers > 0 ? options.workers : std::max(1, static_cast<int>(std::thread::hardware_concurrency()));
+    WorkerPool pool(workers);
+    std::cerr << "Serving with " << workers << " workers." << std::endl;
+
+    if (options.socket_path.empty())
+        return serve_stdin(pool, options.max_request_bytes);
+
+#ifndef _WIN32
+    return serve_socket(options, pool);
+#else
+    std::cerr << "Unix domain sockets are not supported on this platform." << std::endl;
+    return -1;
+#endif
+}
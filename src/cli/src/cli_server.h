@@ -0,0 +1,17 @@
+#pragma once
+#include <cstddef>
+#include <string>
+
+struct ServerOptions
+{
+    int workers = 0;                                  // 求解线程数，<=0 时取硬件并发数
+    std::string socket_path;                          // Unix domain socket 路径，为空时读写 stdin/stdout
+    int max_connections = 64;                         // socket 模式同时服务的连接数上限，达到上限时新连接在监听队列中等待
+    std::size_t max_request_bytes = 16 * 1024 * 1024; // 单行请求的长度上限，超出时返回错误并关闭连接（stdin 模式下结束服务）
+};
+
+// 常驻服务模式，游戏数据需预先载入。每行一个 RunWithJsonParams 格式的请求，每个请求返回一行 JSON 结果，
+// 失败时返回 {"error": "..."}。同一连接上可以连续发送请求而不必等待结果，请求由线程池并行求解，
+// 结果按请求的接收顺序由各连接自己的写线程写回，不读取结果的客户端只会暂停自身连接的读取。
+// stdin 模式在输入结束且所有请求完成后返回。
+int run_server(const ServerOptions &options);
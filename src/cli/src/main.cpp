@@ -1,5 +1,9 @@
 #include "albc/albc.h"
+#include "cli_batch.h"
+#include "cli_file.h"
+#include "cli_server.h"
 
+#include <cstring>
 #include <fstream>
 
 #define PROGRAMOPTIONS_NO_COLORS
@@ -14,15 +18,172 @@
 #endif
 
 
-void read_file_to_ss(const std::string &filename, std::stringstream &ss)
+std::string read_input_file(const std::string &filename)
 {
-    std::ifstream ifs(filename);
-    if (!ifs.is_open())
+    auto content = read_file(filename);
+    std::cout << "Read file: " << filename << ", size: " << content.size() << std::endl;
+    return content;
+}
+
+void write_string_to_file(const std::string &filename, const std::string &content)
+{
+    std::ofstream ofs(filename);
+    if (!ofs.is_open())
     {
         throw std::runtime_error("Could not open file: " + filename);
     }
-    ss << ifs.rdbuf();
-    std::cout << "Read file: " << filename << ", size: " << ss.str().size() << std::endl;
+    ofs << content;
+    std::cout << "Written file: " << filename << ", size: " << content.size() << std::endl;
+}
+
+void throw_if_failed(AlbcException *e)
+{
+    if (!e)
+        return;
+
+    const std::string what = e->what;
+    albc::FreeException(e);
+    throw std::runtime_error(what);
+}
+
+// 载入游戏数据，路径为空的表跳过
+void load_game_data(const std::string &game_data, const std::string &character_table,
+                    const std::string &char_meta_table)
+{
+    AlbcException *e = nullptr;
+    albc::LoadGameDataFile(ALBC_GAME_DATA_DB_BUILDING_DATA, game_data.c_str(), &e);
+    throw_if_failed(e);
+    if (!character_table.empty())
+    {
+        albc::LoadGameDataFile(ALBC_GAME_DATA_DB_CHARACTER_TABLE, character_table.c_str(), &e);
+        throw_if_failed(e);
+    }
+    if (!char_meta_table.empty())
+    {
+        albc::LoadGameDataFile(ALBC_GAME_DATA_DB_CHAR_META_TABLE, char_meta_table.c_str(), &e);
+        throw_if_failed(e);
+    }
+}
+
+// 服务模式下 stdout 只用于输出结果，日志改写到 stderr
+bool log_to_stderr(unsigned long, const char *message, void *)
+{
+    std::cerr << message;
+    const size_t len = std::strlen(message);
+    if (len == 0 || message[len - 1] != '\n')
+        std::cerr << '\n';
+    return true;
+}
+
+bool flush_log_to_stderr(unsigned long, void *)
+{
+    std::cerr.flush();
+    return true;
+}
+
+// 重放捕获文件并打印报告，结果与捕获时不一致时返回-1
+int run_replay(const std::string &replay_path, int iterations, const std::string &game_data,
+               const std::string &character_table, const std::string &char_meta_table, const std::string &trace_file)
+{
+    if (game_data.empty())
+    {
+        std::cerr << "must specify the path to building data file!" << std::endl;
+        return -1;
+    }
+
+    try
+    {
+        load_game_data(game_data, character_table, char_meta_table);
+        AlbcException *e = nullptr;
+
+        if (!trace_file.empty())
+            albc::SetTraceEnabled(true);
+
+        std::cout << "Replaying capture: " << replay_path << ", iterations: " << iterations << std::endl;
+        const auto report = albc::ReplayCapture(replay_path.c_str(), iterations, &e);
+        throw_if_failed(e);
+        std::cout << report.c_str() << std::endl;
+
+        if (!trace_file.empty())
+        {
+            albc::SetTraceEnabled(false);
+            albc::WriteTraceFile(trace_file.c_str());
+            std::cout << "Trace written to: " << trace_file << std::endl;
+        }
+        albc::FlushLog();
+
+        const std::string report_str = report.c_str();
+        const std::string match_key = "\"result_match\"";
+        const auto key_pos = report_str.find(match_key);
+        const auto value_pos = key_pos == std::string::npos
+                                   ? std::string::npos
+                                   : report_str.find_first_not_of(" \t\r\n:", key_pos + match_key.size());
+        if (value_pos == std::string::npos || report_str.compare(value_pos, 4, "true") != 0)
+        {
+            std::cerr << "Replay result differs from the capture." << std::endl;
+            return -1;
+        }
+        return 0;
+    }
+    catch (const std::exception &ex)
+    {
+        std::cerr << "Exception: " << ex.what() << std::endl;
+        return -1;
+    }
+}
+
+// 载入游戏数据后以服务模式处理 RunWithJsonParams 请求
+int run_serve(const ServerOptions &options, const std::string &game_data, const std::string &character_table,
+              const std::string &char_meta_table, const std::string &log_level_str)
+{
+    if (game_data.empty() || character_table.empty() || char_meta_table.empty())
+    {
+        std::cerr << "must specify the paths to building data, character table and char meta table files!"
+                  << std::endl;
+        return -1;
+    }
+
+    try
+    {
+        albc::SetLogHandler(log_to_stderr, nullptr);
+        albc::SetFlushLogHandler(flush_log_to_stderr, nullptr);
+        albc::SetLogLevel(albc::ParseLogLevel(log_level_str.c_str(), ALBC_LOG_LEVEL_WARN));
+        load_game_data(game_data, character_table, char_meta_table);
+        const int ret = run_server(options);
+        albc::FlushLog();
+        return ret;
+    }
+    catch (const std::exception &ex)
+    {
+        std::cerr << "Exception: " << ex.what() << std::endl;
+        return -1;
+    }
+}
+
+// 载入游戏数据后批量求解输入目录中的文件
+int run_batch_files(const BatchOptions &options, const std::string &game_data, const std::string &character_table,
+                    const std::string &char_meta_table, const std::string &log_level_str)
+{
+    if (game_data.empty() || character_table.empty() || char_meta_table.empty())
+    {
+        std::cerr << "must specify the paths to building data, character table and char meta table files!"
+                  << std::endl;
+        return -1;
+    }
+
+    try
+    {
+        albc::SetLogLevel(albc::ParseLogLevel(log_level_str.c_str(), ALBC_LOG_LEVEL_WARN));
+        load_game_data(game_data, character_table, char_meta_table);
+        const int ret = run_batch(options);
+        albc::FlushLog();
+        return ret;
+    }
+    catch (const std::exception &ex)
+    {
+        std::cerr << "Exception: " << ex.what() << std::endl;
+        return -1;
+    }
 }
 
 int main(const int argc, char *argv[])
@@ -32,13 +193,23 @@ int main(const int argc, char *argv[])
 #endif
 
     po::parser parser;
-    std::string game_data, player_data, character_table;
-    std::stringstream player_data_json, game_data_json, character_table_json;
+    std::string game_data, player_data, character_table, char_meta_table;
+    std::string synthetic_config, synthetic_out, synthetic_params_out;
+    std::string player_data_json, game_data_json, character_table_json;
     std::string log_level_str;
     std::string model_time_limit_str = "57600";
     std::string solve_time_limit_str = "60";
     std::string albc_test_mode_str;
     std::string albc_test_param_str = "0";
+    std::string load_duration_str = "0";
+    std::string load_requests_str = "0";
+    std::string trace_file;
+    std::string replay_path;
+    std::string replay_iterations_str = "1";
+    std::string socket_path;
+    std::string workers_str = "0";
+    std::string batch_input;
+    std::string batch_out = "batch_out";
 
     // add options to parser
     // add playerdata and gamedata to parser
@@ -61,6 +232,33 @@ int main(const int argc, char *argv[])
                      "PATH                            : string")
         .bind(character_table);
 
+    parser["char-meta-table"]
+        .abbreviation('M')
+        .description("Path to char meta table file. Optional, used by synthetic input.\n"
+                     "PATH                            : string")
+        .bind(char_meta_table);
+
+    parser["synthetic"]
+        .abbreviation('y')
+        .description("Generate player data from a synthetic input config (JSON) instead of reading --playerdata.\n"
+                     "Keys: seed, operators, manufactureWeight, tradingWeight, otherWeight, alternateDensity,\n"
+                     "maxLevelRatio, minMorale, maxMorale, manufactureRooms, tradingRooms, powerRooms,\n"
+                     "minSlots, maxSlots, prodTypes, orderTypes.\n"
+                     "PATH                            : string")
+        .bind(synthetic_config);
+
+    parser["synthetic-out"]
+        .abbreviation('o')
+        .description("Write the generated synthetic player data to file.\n"
+                     "PATH                            : string")
+        .bind(synthetic_out);
+
+    parser["synthetic-params"]
+        .abbreviation('J')
+        .description("Write the same synthetic input as RunWithJsonParams input to file.\n"
+                     "PATH                            : string")
+        .bind(synthetic_params_out);
+
     parser["log-level"]
         .abbreviation('l')
         .description("Log level.\nDefault is WARN.\n"
@@ -94,6 +292,75 @@ int main(const int argc, char *argv[])
                      "NUM_CONCURRENCY|NUM_ITERATIONS  : int")
         .bind(albc_test_param_str);
 
+    parser["duration"]
+        .abbreviation('D')
+        .description("PARALLEL test: keep sending requests for this many seconds.\n"
+                     "Reports requests/s and latency percentiles.\n"
+                     "TIME                            : double")
+        .bind(load_duration_str);
+
+    parser["requests"]
+        .abbreviation('R')
+        .description("PARALLEL test: total number of requests when no duration is set.\n"
+                     "Default is one per concurrent worker.\n"
+                     "NUM_REQUESTS                    : int")
+        .bind(load_requests_str);
+
+    parser["trace"]
+        .abbreviation('r')
+        .description("Write scope timings of all threads to a Chrome trace file.\n"
+                     "Open it in chrome://tracing or Perfetto.\n"
+                     "PATH                            : string")
+        .bind(trace_file);
+
+    parser["replay"]
+        .abbreviation('X')
+        .description("Replay a capture file written with SetCaptureDirectory and compare results and timings.\n"
+                     "Only --gamedata is required; --character-table and --char-meta-table are optional.\n"
+                     "PATH                            : string")
+        .bind(replay_path);
+
+    parser["replay-iterations"]
+        .abbreviation('N')
+        .description("Number of times to replay the capture.\n"
+                     "Default is 1.\n"
+                     "NUM_ITERATIONS                  : int")
+        .bind(replay_iterations_str);
+
+    parser["socket"]
+        .abbreviation('u')
+        .description("Serve mode: listen on this Unix domain socket instead of stdin/stdout.\n"
+                     "PATH                            : string")
+        .bind(socket_path);
+
+    parser["workers"]
+        .abbreviation('w')
+        .description("Serve and batch mode: number of solver threads.\n"
+                     "Default is the number of hardware threads.\n"
+                     "NUM_WORKERS                     : int")
+        .bind(workers_str);
+
+    parser["batch"]
+        .abbreviation('b')
+        .description("Solve every player data or RunWithJsonParams file in a directory (*.json)\n"
+                     "or matching a file name pattern with * and ?, loading game data once.\n"
+                     "Requires --gamedata, --character-table and --char-meta-table.\n"
+                     "PATH                            : string")
+        .bind(batch_input);
+
+    parser["batch-out"]
+        .abbreviation('O')
+        .description("Batch mode: directory for <name>.result.json and summary.json.\n"
+                     "Default is batch_out.\n"
+                     "PATH                            : string")
+        .bind(batch_out);
+
+    auto &serve = parser["serve"].abbreviation('d').description(
+        "Load game data once and serve newline-delimited\n"
+        "RunWithJsonParams requests, one JSON result per line.\n"
+        "This is also the default without --test-mode.\n"
+        "Requires --gamedata, --character-table and --char-meta-table. : FLAG");
+
     auto &gen_lp = parser["lp-file"].abbreviation('L').description(
         "Generate a lp-format file describing the problem.         : FLAG");
 
@@ -120,13 +387,40 @@ int main(const int argc, char *argv[])
         return 0;
     }
 
+    if (!replay_path.empty())
+        return run_replay(replay_path, std::stoi(replay_iterations_str), game_data, character_table, char_meta_table,
+                          trace_file);
+
     bool test_enabled = !albc_test_mode_str.empty();
     AlbcTestMode test_mode = albc::ParseTestMode(albc_test_mode_str.c_str(), ALBC_TEST_MODE_ONCE);
+
+    // 普通模式即服务模式：既不测试也不生成模拟数据时，载入游戏数据后处理 stdin 上的请求
+    const bool normal_mode = !test_enabled && synthetic_config.empty() && batch_input.empty();
+    if (serve.was_set() || normal_mode)
+    {
+        if (normal_mode && !player_data.empty())
+            std::cerr << "--playerdata is only used by --test-mode; requests carry their own parameters." << std::endl;
+
+        ServerOptions options;
+        options.workers = std::stoi(workers_str);
+        options.socket_path = socket_path;
+        return run_serve(options, game_data, character_table, char_meta_table, log_level_str);
+    }
+
+    if (!batch_input.empty())
+    {
+        BatchOptions options;
+        options.input = batch_input;
+        options.output_dir = batch_out;
+        options.workers = std::stoi(workers_str);
+        return run_batch_files(options, game_data, character_table, char_meta_table, log_level_str);
+    }
+
     // check if all required options are set
     try
     {
         // print missing options name
-        if (player_data.empty())
+        if (player_data.empty() && synthetic_config.empty())
         {
             std::cerr << "must specify the path to player data file!" << std::endl;
             throw std::invalid_argument("playerdata");
@@ -155,13 +449,48 @@ int main(const int argc, char *argv[])
     try
     {
         std::cout << "Main process started." << std::endl;
+        if (!trace_file.empty())
+            albc::SetTraceEnabled(true);
+
         std::cout << "Reading game data file: " << game_data << std::endl;
-        read_file_to_ss(game_data, game_data_json);
-        read_file_to_ss(character_table, character_table_json);
-        //albc::InitCharacterTableFromJson(character_table_json.str().c_str());
-        //albc::InitBuildingDataFromJson(game_data_json.str().c_str());
-        std::cout << "Reading player data file: " << player_data << std::endl;
-        read_file_to_ss(player_data, player_data_json);
+        game_data_json = read_input_file(game_data);
+        character_table_json = read_input_file(character_table);
+        //albc::InitCharacterTableFromJson(character_table_json.c_str());
+        //albc::InitBuildingDataFromJson(game_data_json.c_str());
+        if (synthetic_config.empty())
+        {
+            std::cout << "Reading player data file: " << player_data << std::endl;
+            player_data_json = read_input_file(player_data);
+        }
+        else
+        {
+            const auto synthetic_config_json = read_input_file(synthetic_config);
+
+            AlbcException *e = nullptr;
+            albc::LoadGameDataJson(ALBC_GAME_DATA_DB_BUILDING_DATA, game_data_json.c_str(), &e);
+            throw_if_failed(e);
+            if (!char_meta_table.empty())
+            {
+                albc::LoadGameDataFile(ALBC_GAME_DATA_DB_CHAR_META_TABLE, char_meta_table.c_str(), &e);
+                throw_if_failed(e);
+            }
+
+            const auto generated = albc::GenSyntheticInput(synthetic_config_json.c_str(),
+                                                           ALBC_SYNTHETIC_INPUT_PLAYER_DATA, &e);
+            throw_if_failed(e);
+            player_data_json = generated.c_str();
+            std::cout << "Generated synthetic player data from: " << synthetic_config << std::endl;
+            if (!synthetic_out.empty())
+                write_string_to_file(synthetic_out, generated.c_str());
+
+            if (!synthetic_params_out.empty())
+            {
+                const auto params = albc::GenSyntheticInput(synthetic_config_json.c_str(),
+                                                             ALBC_SYNTHETIC_INPUT_JSON_PARAMS, &e);
+                throw_if_failed(e);
+                write_string_to_file(synthetic_params_out, params.c_str());
+            }
+        }
 
         const char* skills[] = {u8"异格者", u8"热能充能·γ"};
         std::unique_ptr<albc::ICharQuery> query1(albc::QueryChar(2, skills));
@@ -178,18 +507,22 @@ int main(const int argc, char *argv[])
             test_cfg->mode = test_mode;
             test_cfg->param = std::stoi(albc_test_param_str);
             test_cfg->show_all_ops = all_ops.was_set();
+            test_cfg->duration = std::stod(load_duration_str);
+            test_cfg->requests = std::stoi(load_requests_str);
 
             auto &sp = test_cfg->base_parameters.solver_parameters;
             sp.gen_lp_file = gen_lp.was_set();
             sp.gen_all_solution_details = gen_sol_details.was_set();
             sp.model_time_limit = std::stod(model_time_limit_str);
             sp.solve_time_limit = std::stod(solve_time_limit_str);
-            albc::RunTest(game_data_json.str().c_str(), player_data_json.str().c_str(), test_cfg.get());
+            albc::RunTest(game_data_json.c_str(), player_data_json.c_str(), test_cfg.get());
         }
-        else // if (test_enabled)
+
+        if (!trace_file.empty())
         {
-            // TODO: normal mode
-            std::cout << "Normal mode" << std::endl;
+            albc::SetTraceEnabled(false);
+            albc::WriteTraceFile(trace_file.c_str());
+            std::cout << "Trace written to: " << trace_file << std::endl;
         }
 
         albc::FlushLog();
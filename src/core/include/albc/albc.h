@@ -6,8 +6,23 @@
 
 namespace albc
 {
+class IAsyncJsonResult;
+
 ALBC_API String RunWithJsonParams(const char* json, ALBC_E_PTR);
 
+// 与 RunWithJsonParams 相同，但以一块连续的缓冲区返回结果（布局见 AlbcFlatResult），需用 FreeFlatResult 释放。
+// flags 为 AlbcFlatResultFlags 的组合。失败时返回空指针。
+ALBC_API AlbcFlatResult* RunWithJsonParamsFlat(const char* json, unsigned int flags, ALBC_E_PTR);
+
+// 释放扁平结果缓冲区。
+ALBC_API void FreeFlatResult(AlbcFlatResult* result) noexcept;
+
+// 在共享线程池中执行 RunWithJsonParams，立即返回句柄。callback 可为空，完成（含失败、取消）时在工作线程中调用。
+// 线程池大小为 std::thread::hardware_concurrency()（与 GetResultAsync 共用），超出的任务以 PENDING 状态排队。
+// 输入中的 "deadline" 字段为整个流程的挂钟时间上限（秒）。
+ALBC_API IAsyncJsonResult* RunWithJsonParamsAsync(const char* json, AlbcAsyncCallback callback = nullptr,
+                                                  void* user_data = nullptr, ALBC_E_PTR);
+
 class ALBC_API_CLASS Character
 {
   public:
@@ -79,6 +94,7 @@ class ALBC_API_CLASS IRoomResult
     ALBC_MEM_DELEGATE
 };
 
+// 备选方案（altPlans / altExclusionPlans）目前只在 RunWithJsonParams 的 JSON 结果中输出，IResult 与 flat result 不包含
 class ALBC_API_CLASS IResult
 {
   public:
@@ -86,11 +102,42 @@ class ALBC_API_CLASS IResult
     ALBC_NODISCARD ALBC_API_MEMBER virtual int GetStatus() const noexcept = 0;
     // 获取各个房间的生产方案。
     ALBC_NODISCARD ALBC_API_MEMBER virtual ICollection< IRoomResult* /* ref */ >* /* ref */ GetRoomDetails() const noexcept = 0;
+    // 获取本次求解的性能统计。
+    ALBC_NODISCARD ALBC_API_MEMBER virtual AlbcSolveStats GetStats() const noexcept = 0;
     ALBC_API_MEMBER virtual ~IResult() noexcept = default;
 
     ALBC_MEM_DELEGATE
 };
 
+class ALBC_API_CLASS IAsyncTask
+{
+  public:
+    // 查询当前状态，不阻塞。
+    ALBC_NODISCARD ALBC_API_MEMBER virtual AlbcAsyncStatus Poll() const noexcept = 0;
+    // 等待任务结束。timeout_sec < 0 时一直等待。返回任务是否已结束。
+    ALBC_API_MEMBER virtual bool Wait(double timeout_sec) const noexcept = 0;
+    // 请求取消。枚举及求解会在下一个检查点停止，状态变为CANCELLED。
+    ALBC_API_MEMBER virtual void Cancel() noexcept = 0;
+    // 释放时若任务未结束，则先取消任务并等待其结束。仍在排队的任务直接结束，其回调在释放句柄的线程中调用。
+    ALBC_API_MEMBER virtual ~IAsyncTask() noexcept = default;
+
+    ALBC_MEM_DELEGATE
+};
+
+class ALBC_API_CLASS IAsyncResult : public IAsyncTask
+{
+  public:
+    // 获取求解结果，所有权转移给调用者，只能获取一次。未成功结束时返回空指针并设置异常。
+    ALBC_NODISCARD ALBC_API_MEMBER virtual IResult* GetResult(ALBC_E_PTR) noexcept = 0;
+};
+
+class ALBC_API_CLASS IAsyncJsonResult : public IAsyncTask
+{
+  public:
+    // 获取JSON格式的求解结果。未成功结束时返回"{}"并设置异常。
+    ALBC_NODISCARD ALBC_API_MEMBER virtual String GetResult(ALBC_E_PTR) const noexcept = 0;
+};
+
 class ALBC_API_CLASS ICharQuery
 {
   public:
@@ -112,7 +159,7 @@ class ALBC_API_CLASS ICharQuery
 class ALBC_API_CLASS Model
 {
   public:
-    // 根据玩家数据创建一个模型
+    // 根据玩家数据创建一个模型。文件的读取方式与 LoadGameDataFile 相同，读取期间文件不得被截断或改写
     ALBC_API_MEMBER static Model *FromFile(const char *player_data_path, ALBC_E_PTR) noexcept;
     // 根据玩家数据创建一个模型
     ALBC_API_MEMBER static Model *FromJson(const char *player_data_json, ALBC_E_PTR) noexcept;
@@ -133,6 +180,14 @@ class ALBC_API_CLASS Model
     ALBC_API_MEMBER void SetDblParam(AlbcModelParamType type, double value, ALBC_E_PTR) noexcept;
     // 对模型求解。
     ALBC_API_MEMBER IResult *GetResult(ALBC_E_PTR) noexcept;
+    // 对模型求解，以一块连续的缓冲区返回结果（布局见 AlbcFlatResult），需用 FreeFlatResult 释放。
+    // flags 为 AlbcFlatResultFlags 的组合。
+    ALBC_API_MEMBER AlbcFlatResult *GetFlatResult(unsigned int flags, ALBC_E_PTR) noexcept;
+    // 在共享线程池中对模型求解，立即返回句柄（排队规则同 RunWithJsonParamsAsync）。
+    // callback 可为空，完成（含失败、取消）时在工作线程中调用。
+    // 模型数据在调用时即被复制，之后对模型的修改不影响本次求解。
+    ALBC_API_MEMBER IAsyncResult *GetResultAsync(AlbcAsyncCallback callback = nullptr, void *user_data = nullptr,
+                                                 ALBC_E_PTR) noexcept;
 
     ALBC_PIMPL
     ALBC_MEM_DELEGATE
@@ -149,8 +204,29 @@ ALBC_API bool SetGlobalLocale(const char* locale) noexcept;
 // https://github.com/Kengxxiao/ArknightsGameData/blob/master/zh_CN/gamedata/excel/character_table.json
 // https://github.com/Kengxxiao/ArknightsGameData/blob/master/zh_CN/gamedata/excel/char_meta_table.json
 ALBC_API void LoadGameDataJson(AlbcGameDataDbType data_type, const char* json, ALBC_E_PTR);
+// 普通文件以内存映射方式读取，读取期间文件不得被截断或改写，否则进程会收到 SIGBUS；管道等非普通文件按流读取。
 ALBC_API void LoadGameDataFile(AlbcGameDataDbType data_type, const char* path, ALBC_E_PTR);
 
+// 将当前已载入的游戏数据（及据此构建的技能查询表）编译为二进制快照文件。
+// 快照与生成它的库版本和平台绑定，升级库或更换平台后需重新生成。
+ALBC_API void CompileGameDataSnapshot(const char* path, ALBC_E_PTR);
+
+// 以内存映射方式载入 CompileGameDataSnapshot 生成的快照，无需解析 JSON 和重建查询表。
+// 快照中包含的游戏数据会覆盖已载入的同类数据。
+ALBC_API void LoadGameDataSnapshot(const char* path, ALBC_E_PTR);
+
+// 根据参数生成合成的输入，用于测量求解规模与耗时。参数为JSON，字段见 api_synthetic.h 中的 SyntheticConfig，缺省字段取默认值，
+// 相同参数总是生成相同的输入。需要载入BuildingData，载入CharMetaTable后才会按 alternateDensity 加入异格干员。
+ALBC_API String GenSyntheticInput(const char *config_json, AlbcSyntheticInputType type, ALBC_E_PTR);
+
+// 设置请求捕获目录，空指针或空字符串关闭捕获。开启后 RunWithJsonParams 系列与 Model::GetResult 每次求解都会
+// 在该目录下写出一个捕获文件，包含原始输入、解析后的参数、游戏数据版本哈希、结果与耗时，供 ReplayCapture 离线重放。
+ALBC_API void SetCaptureDirectory(const char *dir, ALBC_E_PTR) noexcept;
+
+// 以当前载入的游戏数据重新求解捕获文件 iterations 次，返回 JSON 报告：游戏数据版本与结果是否一致、不一致的房间，
+// 以及各阶段耗时与捕获时的对比。
+ALBC_API String ReplayCapture(const char *path, int iterations, ALBC_E_PTR);
+
 // 根据单个技能的ID或名称查询角色。支持提供角色ID或名称来进行更加精确的查询。
 // 需要初始化BuildingData。如果使用角色名字作为char_key，或则需要在查询结果中获取角色名字，还需初始化CharacterTable。
 ALBC_API ICharQuery* QueryChar(const char *skill_key, const char* char_key = nullptr);
@@ -168,11 +244,20 @@ ALBC_API void SetLogLevel(AlbcLogLevel level, ALBC_E_PTR) noexcept;
 ALBC_API void FlushLog(ALBC_E_PTR) noexcept;
 
 // 设置输出日志的方式。设为空指针来还原成默认值。如果回调函数返回了false，则使用默认日志方式输出。
+// 默认构建中回调在写日志的线程上调用；以 ALBC_ENABLE_THREADED_LOGGING 构建时（默认关闭），回调在日志后台线程上调用，
+// FlushLog 期间则在调用 FlushLog 的线程上调用，回调需自行保证线程安全。
+// 该模式的后台线程在进程退出（atexit）时才停止，库会被动态卸载时不要启用。
 ALBC_API void SetLogHandler(AlbcLogHandler handler, void *user_data, ALBC_E_PTR) noexcept;
 
 // 设置清空日志缓冲区的方式。设为空指针来还原成默认值。如果回调函数返回了false，则使用默认日志方式输出
 ALBC_API void SetFlushLogHandler(AlbcFlushLogHandler handler, void *user_data, ALBC_E_PTR) noexcept;
 
+// 启用或停止记录各线程计时作用域的追踪事件。启用时开始新的记录，丢弃此前的事件
+ALBC_API void SetTraceEnabled(bool enabled, ALBC_E_PTR) noexcept;
+
+// 将已记录的追踪事件写出为 Chrome trace JSON 文件，可用 chrome://tracing 或 Perfetto 打开
+ALBC_API void WriteTraceFile(const char *path, ALBC_E_PTR) noexcept;
+
 // 解析日志等级字符串(ALL, DEBUG, INFO, WARN, ERROR, NONE)，大小写不敏感
 ALBC_API AlbcLogLevel ParseLogLevel(const char *level, AlbcLogLevel default_level, ALBC_E_PTR) noexcept;
 
@@ -182,6 +267,7 @@ ALBC_API AlbcTestMode ParseTestMode(const char *mode, AlbcTestMode default_mode,
 // 根据给定的游戏数据和玩家数据运行一次测试
 ALBC_API void RunTest(const char *game_data_json, const char *player_data_json, const AlbcTestConfig *config, ALBC_E_PTR);
 
+// 获取库的运行信息，包括自进程启动以来所有求解的性能统计汇总（次数、各阶段平均及最大耗时等）。
 ALBC_API ICollection<String>* GetInfo(ALBC_E_PTR);
 } // namespace albc
 #endif // ALBC_H
\ No newline at end of file
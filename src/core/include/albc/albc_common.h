@@ -8,6 +8,7 @@
 #ifndef __cplusplus
 #include <stdbool.h>
 #endif // __cplusplus
+#include <stdint.h>
 
 #if defined(__MINGW32__) || defined(__CYGWIN__)
 #   define ALBC_CONFIG_WIN_GCC
@@ -62,12 +63,19 @@ typedef enum AlbcTestMode
     ALBC_TEST_MODE_PARALLEL = 2
 } AlbcTestMode;
 
+#define ALBC_MAX_SHIFT_COUNT 8     // shift_count 的上限，模型规模随班次数线性增长
+#define ALBC_MAX_ALT_PLAN_COUNT 32 // alt_plan_count 的上限，每个次优方案都要追加一行割并重新求解
+
 typedef struct AlbcSolverParameters
 {
     bool gen_lp_file;
     bool gen_all_solution_details;
     double solve_time_limit;
     double model_time_limit;
+    int alt_plan_count;       // 在最优方案之外依次求出的次优方案数，<=0 时不求，至多 ALBC_MAX_ALT_PLAN_COUNT。备选方案目前只在 JSON 结果中输出
+    bool alt_exclusion_plans; // 为最优方案中的每名干员求出不使用该干员时的最优方案
+    int shift_count;          // 班次数，取 1 到 ALBC_MAX_SHIFT_COUNT（0 视为 1），每个班次长 model_time_limit，>1 时在一个模型中排出所有班次，干员心情在班次间结转
+    double rest_recovery;     // 多班次：干员每休息一个班次恢复的可工作时间（秒，1X倍率）
 } AlbcSolverParameters;
 
 typedef struct AlbcParameters
@@ -80,8 +88,10 @@ typedef struct AlbcTestConfig
 {
     AlbcParameters base_parameters;
     AlbcTestMode mode;
-    int param;
+    int param;              // SEQUENTIAL: 迭代次数；PARALLEL: 并发数
     bool show_all_ops;
+    double duration;        // PARALLEL: 压测持续时间（秒），>0 时按时长运行
+    int requests;           // PARALLEL: duration<=0 时的总请求数，<=0 时为并发数
 } AlbcTestConfig;
 
 typedef struct AlbcException
@@ -138,6 +148,7 @@ typedef enum AlbcModelParamType
 {
     ALBC_MODEL_PARAM_DURATION = 0,
     ALBC_MODEL_PARAM_SOLVE_TIME_LIMIT = 1,
+    ALBC_MODEL_PARAM_DEADLINE = 2, // 整个求解流程的挂钟时间上限（秒），<=0 为不限
 } AlbcModelParamType;
 
 typedef enum AlbcRoomParamType
@@ -159,6 +170,85 @@ typedef enum AlbcGameDataDbType
     ALBC_GAME_DATA_DB_CHAR_META_TABLE = 3,// char_meta_table.json, UTF-8 encoded string
 } AlbcGameDataDbType;
 
+typedef enum AlbcSyntheticInputType
+{
+    ALBC_SYNTHETIC_INPUT_PLAYER_DATA = 0, // player_data.json 格式，可用于 Model::FromJson 及 RunTest
+    ALBC_SYNTHETIC_INPUT_JSON_PARAMS = 1, // RunWithJsonParams 的输入格式
+} AlbcSyntheticInputType;
+
+typedef enum AlbcAsyncStatus
+{
+    ALBC_ASYNC_STATUS_PENDING = 0,   // 已提交，尚未开始
+    ALBC_ASYNC_STATUS_RUNNING = 1,   // 正在求解
+    ALBC_ASYNC_STATUS_SUCCEEDED = 2, // 求解完成，可获取结果
+    ALBC_ASYNC_STATUS_FAILED = 3,    // 求解出错
+    ALBC_ASYNC_STATUS_CANCELLED = 4, // 已被取消
+    ALBC_ASYNC_STATUS_DEADLINE_EXCEEDED = 5, // 超过截止时间
+} AlbcAsyncStatus;
+
+/*
+ * 扁平结果缓冲区：一次分配的连续内存，由调用方通过 AlbcFlatResultFree / albc::FreeFlatResult 释放。
+ * 布局：AlbcFlatResult | AlbcFlatRoomRecord[room_count] | uint32_t[char_count] | uint32_t[error_count] | 字符串表
+ * 所有 *_offset 字段均为相对缓冲区起始地址的字节偏移；字符串引用均为相对字符串表起始的偏移，字符串以'\0'结尾，UTF-8编码。
+ */
+#define ALBC_FLAT_RESULT_VERSION 1u
+#define ALBC_FLAT_NO_STRING 0xFFFFFFFFu
+
+typedef enum AlbcFlatResultFlags
+{
+    ALBC_FLAT_RESULT_DEFAULT = 0,
+    ALBC_FLAT_RESULT_READABLE_INFO = 1 << 0, // 生成每个房间的方案信息（较慢）
+} AlbcFlatResultFlags;
+
+typedef struct AlbcFlatRoomRecord
+{
+    double score;           // 房间产能
+    double duration;        // 方案可持续时间
+    uint32_t identifier;    // 房间标识符
+    uint32_t readable_info; // 方案信息，未生成时为 ALBC_FLAT_NO_STRING
+    uint32_t char_begin;    // 该房间的干员在干员数组中的起始下标
+    uint32_t char_count;    // 该房间的干员数量
+} AlbcFlatRoomRecord;
+
+typedef struct AlbcFlatResult
+{
+    uint32_t version;       // ALBC_FLAT_RESULT_VERSION
+    uint32_t total_size;    // 整个缓冲区的字节数
+    int32_t status;         // 求解状态，0为正常
+    uint32_t flags;         // 生成时使用的 AlbcFlatResultFlags
+    uint32_t room_count;
+    uint32_t room_offset;   // AlbcFlatRoomRecord[room_count]
+    uint32_t char_count;
+    uint32_t char_offset;   // uint32_t[char_count]，元素为干员标识符
+    uint32_t error_count;
+    uint32_t error_offset;  // uint32_t[error_count]，元素为错误信息（无法创建的干员、房间等）
+    uint32_t string_offset; // 字符串表
+    uint32_t string_size;   // 字符串表字节数
+} AlbcFlatResult;
+
+// 一次求解的性能统计。时间单位为秒，未执行的阶段为0
+typedef struct AlbcSolveStats
+{
+    double data_feed_time;   // 由输入构建干员、Buff、房间模型的耗时
+    double filter_time;      // 各房间筛选可用干员的耗时之和
+    double enum_time;        // 各房间枚举干员组合的耗时之和
+    double solve_time;       // 整数规划求解耗时
+    double total_time;       // 以上全部及其余步骤的总耗时
+    double gap;              // 求解结束时的相对最优性间隙，未得到可行解时为-1
+    uint64_t calc_cnt;       // 计算过的组合数
+    uint64_t matrix_nnz;     // 约束矩阵的非零元数
+    uint64_t peak_memory;    // 本次求解的模型与求解数据占用内存的峰值（字节）
+    uint32_t room_cnt;       // 参与求解的房间数
+    uint32_t col_cnt;        // 整数规划的列数（候选组合数）
+    uint32_t row_cnt;        // 整数规划的行数（约束数）
+    uint32_t node_cnt;       // 分支定界节点数
+    uint32_t lp_iterations;  // LP迭代次数
+} AlbcSolveStats;
+
+// 异步求解完成回调，在工作线程中调用（任务在排队时被释放则在释放句柄的线程中调用）。status 为最终状态。
+// 回调占用线程池的线程，不要在其中等待其他异步任务，否则线程全忙时可能死锁。
+typedef void (*AlbcAsyncCallback)(AlbcAsyncStatus status, void *user_data);
+
 // log callback
 typedef bool (*AlbcLogHandler)(unsigned long logger_id, const char *message, void *user_data);
 typedef bool (*AlbcFlushLogHandler)(unsigned long logger_id, void *user_data);
@@ -14,6 +14,7 @@ extern "C"
 // 该API中所有字符串入参、出参均为UTF-8编码
 
 CALBC_HANDLE_DECL (AlbcString)
+CALBC_HANDLE_DECL (AlbcAsyncJsonResult)
 
 /*
  * 资源释放函数
@@ -22,6 +23,12 @@ CALBC_HANDLE_DECL (AlbcString)
 // 释放一个AlbcString对象
 CALBC_API void AlbcStringDel(AlbcString* string);
 
+// 释放扁平结果缓冲区
+CALBC_API void AlbcFlatResultFree(AlbcFlatResult* result);
+
+// 释放一个异步任务句柄。若任务未结束，则先取消任务。
+CALBC_API void AlbcAsyncJsonResultDel(AlbcAsyncJsonResult* result);
+
 /*
  * AlbcString 成员函数
  */
@@ -35,6 +42,38 @@ CALBC_API void AlbcStringCopyTo(AlbcString* string, char* buffer, size_t buffer_
 // 获取字符串内容，包括结束符
 CALBC_API const char* AlbcStringGetContent(AlbcString* string);
 
+/*
+ * AlbcFlatResult 访问函数，亦可按 AlbcFlatResult 中的偏移直接访问
+ */
+
+// 获取房间记录数组，长度为 result->room_count
+CALBC_API const AlbcFlatRoomRecord* AlbcFlatResultGetRooms(const AlbcFlatResult* result);
+
+// 根据字符串表偏移获取字符串，offset 为 ALBC_FLAT_NO_STRING 时返回空指针
+CALBC_API const char* AlbcFlatResultGetString(const AlbcFlatResult* result, uint32_t offset);
+
+// 获取第 index 个干员的标识符，index 范围为 [0, result->char_count)
+CALBC_API const char* AlbcFlatResultGetCharIdentifier(const AlbcFlatResult* result, uint32_t index);
+
+// 获取第 index 条错误信息，index 范围为 [0, result->error_count)
+CALBC_API const char* AlbcFlatResultGetError(const AlbcFlatResult* result, uint32_t index);
+
+/*
+ * AlbcAsyncJsonResult 成员函数
+ */
+
+// 查询异步任务的当前状态，不阻塞
+CALBC_API AlbcAsyncStatus AlbcAsyncJsonResultPoll(AlbcAsyncJsonResult* result);
+
+// 等待异步任务结束。timeout_sec < 0 时一直等待。返回任务是否已结束。
+CALBC_API bool AlbcAsyncJsonResultWait(AlbcAsyncJsonResult* result, double timeout_sec);
+
+// 请求取消异步任务
+CALBC_API void AlbcAsyncJsonResultCancel(AlbcAsyncJsonResult* result);
+
+// 获取JSON格式的求解结果。未成功结束时返回"{}"并设置异常。
+CALBC_API AlbcString* AlbcAsyncJsonResultGetResult(AlbcAsyncJsonResult* result, CALBC_E_PTR);
+
 /*
  * 全局函数
  */
@@ -44,6 +83,23 @@ CALBC_API const char* AlbcStringGetContent(AlbcString* string);
  */
 CALBC_API AlbcString* AlbcRunWithJsonParams(const char* json, CALBC_E_PTR);
 
+// 与 AlbcRunWithJsonParams 相同，但以一块连续的缓冲区返回结果（布局见 albc_common.h 中的 AlbcFlatResult），
+// 需用 AlbcFlatResultFree 释放。flags 为 AlbcFlatResultFlags 的组合。失败时返回空指针。
+CALBC_API AlbcFlatResult* AlbcRunWithJsonParamsFlat(const char* json, unsigned int flags, CALBC_E_PTR);
+
+// 异步执行 AlbcRunWithJsonParams，立即返回句柄。callback 可为空，完成时在工作线程中调用。
+// 任务在 hardware_concurrency 个线程的共享线程池中执行，超出的任务排队。
+CALBC_API AlbcAsyncJsonResult* AlbcRunWithJsonParamsAsync(const char* json, AlbcAsyncCallback callback, void* user_data, CALBC_E_PTR);
+
+// 根据参数生成合成的玩家数据或 AlbcRunWithJsonParams 的输入，用于规模测试。需要载入BuildingData。
+CALBC_API AlbcString* AlbcGenSyntheticInput(const char* config_json, AlbcSyntheticInputType type, CALBC_E_PTR);
+
+// 设置请求捕获目录，空指针或空字符串关闭捕获
+CALBC_API void AlbcSetCaptureDirectory(const char* dir, CALBC_E_PTR);
+
+// 重新求解捕获文件并返回比较结果与耗时的 JSON 报告
+CALBC_API AlbcString* AlbcReplayCapture(const char* path, int iterations, CALBC_E_PTR);
+
 
 // 设定输出字符串的编码。
 CALBC_API bool AlbcSetGlobalLocale(const char* locale);
@@ -61,8 +117,13 @@ CALBC_API void AlbcTest(const char *game_data_json, const char *player_data_json
 // https://github.com/Kengxxiao/ArknightsGameData/blob/master/zh_CN/gamedata/excel/character_table.json
 // https://github.com/Kengxxiao/ArknightsGameData/blob/master/zh_CN/gamedata/excel/char_meta_table.json
 CALBC_API void AlbcLoadGameDataJson(AlbcGameDataDbType type, const char *json, CALBC_E_PTR);
+// 普通文件以内存映射方式读取，读取期间文件不得被截断或改写，否则进程会收到 SIGBUS
 CALBC_API void AlbcLoadGameDataFile(AlbcGameDataDbType type, const char *path, CALBC_E_PTR);
 
+// 将当前已载入的游戏数据编译为二进制快照文件，之后可通过 AlbcLoadGameDataSnapshot 快速载入
+CALBC_API void AlbcCompileGameDataSnapshot(const char *path, CALBC_E_PTR);
+CALBC_API void AlbcLoadGameDataSnapshot(const char *path, CALBC_E_PTR);
+
 // 设置全局日志等级。从ALL输出所有，到NONE不输出，将输出指定等级（包括）及以上等级的日志
 CALBC_API void AlbcSetLogLevel(AlbcLogLevel level, CALBC_E_PTR);
 
@@ -72,6 +133,12 @@ CALBC_API void AlbcFlushLog(CALBC_E_PTR);
 // 打印一条日志。供测试目的用。
 CALBC_API void AlbcDoLog(AlbcLogLevel level, const char* msg, CALBC_E_PTR);
 
+// 启用或停止记录追踪事件。启用时开始新的记录，丢弃此前的事件
+CALBC_API void AlbcSetTraceEnabled(bool enabled, CALBC_E_PTR);
+
+// 将已记录的追踪事件写出为 Chrome trace JSON 文件
+CALBC_API void AlbcWriteTraceFile(const char *path, CALBC_E_PTR);
+
 // 解析日志等级字符串(ALL, DEBUG, INFO, WARN, ERROR, NONE)，大小写不敏感
 CALBC_API AlbcLogLevel AlbcParseLogLevel(const char* level, AlbcLogLevel default_level, CALBC_E_PTR);
 
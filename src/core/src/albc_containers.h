@@ -0,0 +1,458 @@
+#pragma once
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+namespace albc::util
+{
+// FlatHashMap 使用的哈希函数，std::string 键支持以 std::string_view / const char* 直接查找而无需构造临时字符串
+template <typename TKey> struct FlatHash : std::hash<TKey>
+{
+};
+
+template <> struct FlatHash<std::string>
+{
+    using is_transparent = void;
+
+    size_t operator()(std::string_view str) const noexcept
+    {
+        return std::hash<std::string_view>()(str);
+    }
+};
+
+/**
+ * @brief 开放寻址（线性探测）的扁平哈希表，用于载入后只做查找的表。
+ * 元素连续存放并按插入顺序遍历，因此对同样的输入遍历顺序是确定的，但与键的大小顺序无关；
+ * 槽位中只保存元素下标与哈希值的低位，探测时很少需要比较键本身。
+ * 不支持删除元素；插入元素会使已有元素的引用与迭代器失效。
+ */
+template <typename TKey, typename TValue, typename THash = FlatHash<TKey>, typename TKeyEqual = std::equal_to<>>
+class FlatHashMap
+{
+  public:
+    using key_type = TKey;
+    using mapped_type = TValue;
+    using value_type = std::pair<TKey, TValue>;
+    using size_type = size_t;
+    using iterator = typename std::vector<value_type>::iterator;
+    using const_iterator = typename std::vector<value_type>::const_iterator;
+
+    FlatHashMap() = default;
+
+    [[nodiscard]] iterator begin() noexcept
+    {
+        return entries_.begin();
+    }
+
+    [[nodiscard]] iterator end() noexcept
+    {
+        return entries_.end();
+    }
+
+    [[nodiscard]] const_iterator begin() const noexcept
+    {
+        return entries_.begin();
+    }
+
+    [[nodiscard]] const_iterator end() const noexcept
+    {
+        return entries_.end();
+    }
+
+    [[nodiscard]] size_type size() const noexcept
+    {
+        return entries_.size();
+    }
+
+    [[nodiscard]] bool empty() const noexcept
+    {
+        return entries_.empty();
+    }
+
+    void clear() noexcept
+    {
+        entries_.clear();
+        slots_.clear();
+        shift_ = kInitialShift;
+    }
+
+    void reserve(size_type count)
+    {
+        entries_.reserve(count);
+        if (count * kMaxLoadDen > slots_.size() * kMaxLoadNum)
+            Rehash(count);
+    }
+
+    template <typename TFind> [[nodiscard]] iterator find(const TFind &key)
+    {
+        const auto pos = FindIndex(key);
+        return pos == kNotFound ? end() : begin() + static_cast<std::ptrdiff_t>(pos);
+    }
+
+    template <typename TFind> [[nodiscard]] const_iterator find(const TFind &key) const
+    {
+        const auto pos = FindIndex(key);
+        return pos == kNotFound ? end() : begin() + static_cast<std::ptrdiff_t>(pos);
+    }
+
+    template <typename TFind> [[nodiscard]] size_type count(const TFind &key) const
+    {
+        return FindIndex(key) == kNotFound ? 0 : 1;
+    }
+
+    template <typename TFind> [[nodiscard]] TValue &at(const TFind &key)
+    {
+        const auto pos = FindIndex(key);
+        if (pos == kNotFound)
+            throw std::out_of_range("FlatHashMap::at: key not found");
+        return entries_[pos].second;
+    }
+
+    template <typename TFind> [[nodiscard]] const TValue &at(const TFind &key) const
+    {
+        const auto pos = FindIndex(key);
+        if (pos == kNotFound)
+            throw std::out_of_range("FlatHashMap::at: key not found");
+        return entries_[pos].second;
+    }
+
+    TValue &operator[](const TKey &key)
+    {
+        return try_emplace(key).first->second;
+    }
+
+    TValue &operator[](TKey &&key)
+    {
+        return try_emplace(std::move(key)).first->second;
+    }
+
+    template <typename TKeyArg, typename... TArgs> std::pair<iterator, bool> try_emplace(TKeyArg &&key, TArgs &&...args)
+    {
+        const size_t hash = Mix(hasher_(key));
+        if (const auto pos = FindIndex(key, hash); pos != kNotFound)
+            return {begin() + static_cast<std::ptrdiff_t>(pos), false};
+
+        entries_.emplace_back(std::piecewise_construct, std::forward_as_tuple(std::forward<TKeyArg>(key)),
+                              std::forward_as_tuple(std::forward<TArgs>(args)...));
+        InsertSlot(hash);
+        return {std::prev(end()), true};
+    }
+
+    template <typename... TArgs> std::pair<iterator, bool> emplace(TArgs &&...args)
+    {
+        value_type value(std::forward<TArgs>(args)...);
+        return try_emplace(std::move(value.first), std::move(value.second));
+    }
+
+    template <typename... TArgs> iterator emplace_hint(const_iterator, TArgs &&...args)
+    {
+        return emplace(std::forward<TArgs>(args)...).first;
+    }
+
+    std::pair<iterator, bool> insert(value_type value)
+    {
+        return try_emplace(std::move(value.first), std::move(value.second));
+    }
+
+    template <typename TKeyArg, typename TValueArg>
+    std::pair<iterator, bool> insert_or_assign(TKeyArg &&key, TValueArg &&value)
+    {
+        if (const auto it = find(key); it != end())
+        {
+            it->second = std::forward<TValueArg>(value);
+            return {it, false};
+        }
+        return try_emplace(std::forward<TKeyArg>(key), std::forward<TValueArg>(value));
+    }
+
+  private:
+    // 槽位：0 表示空，否则为 元素下标 + 1；tag 为混合后哈希值的低 32 位
+    struct Slot
+    {
+        uint32_t index_plus_one;
+        uint32_t tag;
+    };
+
+    static constexpr size_t kNotFound = static_cast<size_t>(-1);
+    static constexpr unsigned kInitialShift = sizeof(size_t) * 8;
+    static constexpr size_t kMinSlots = 8;
+    static constexpr size_t kMaxLoadNum = 3; // 最大装载率 3/4
+    static constexpr size_t kMaxLoadDen = 4;
+
+    std::vector<value_type> entries_;
+    std::vector<Slot> slots_;
+    unsigned shift_ = kInitialShift; // 槽位下标 = 混合后哈希值 >> shift_
+    THash hasher_;
+    TKeyEqual key_equal_;
+
+    // 斐波那契散列：取乘积的高位作为槽位下标，对 Atom 编号、整数等分布不均的哈希值同样有效
+    static size_t Mix(size_t hash) noexcept
+    {
+        if constexpr (sizeof(size_t) == 8)
+            return hash * 0x9E3779B97F4A7C15ull;
+        else
+            return hash * 0x9E3779B9u;
+    }
+
+    template <typename TFind> [[nodiscard]] size_t FindIndex(const TFind &key) const
+    {
+        if (entries_.empty())
+            return kNotFound;
+        return FindIndex(key, Mix(hasher_(key)));
+    }
+
+    template <typename TFind> [[nodiscard]] size_t FindIndex(const TFind &key, size_t hash) const
+    {
+        if (slots_.empty())
+            return kNotFound;
+
+        const size_t mask = slots_.size() - 1;
+        const auto tag = static_cast<uint32_t>(hash);
+        for (size_t i = hash >> shift_;; i = (i + 1) & mask)
+        {
+            const auto &slot = slots_[i];
+            if (slot.index_plus_one == 0)
+                return kNotFound;
+
+            if (slot.tag == tag && key_equal_(entries_[slot.index_plus_one - 1].first, key))
+                return slot.index_plus_one - 1;
+        }
+    }
+
+    // 新元素已追加到 entries_ 末尾
+    void InsertSlot(size_t hash)
+    {
+        if (entries_.size() * kMaxLoadDen > slots_.size() * kMaxLoadNum)
+        {
+            Rehash(entries_.size());
+            return;
+        }
+
+        Place(hash, static_cast<uint32_t>(entries_.size()));
+    }
+
+    void Place(size_t hash, uint32_t index_plus_one) noexcept
+    {
+        const size_t mask = slots_.size() - 1;
+        size_t i = hash >> shift_;
+        while (slots_[i].index_plus_one != 0)
+            i = (i + 1) & mask;
+        slots_[i] = {index_plus_one, static_cast<uint32_t>(hash)};
+    }
+
+    void Rehash(size_t min_entries)
+    {
+        size_t slot_count = kMinSlots;
+        unsigned shift = kInitialShift - 3;
+        while (min_entries * kMaxLoadDen > slot_count * kMaxLoadNum)
+        {
+            slot_count <<= 1;
+            --shift;
+        }
+
+        slots_.assign(slot_count, Slot{0, 0});
+        shift_ = shift;
+        for (size_t i = 0; i < entries_.size(); ++i)
+            Place(Mix(hasher_(entries_[i].first)), static_cast<uint32_t>(i + 1));
+    }
+};
+
+/**
+ * @brief 有序数组实现的映射，用于元素较少、遍历顺序会影响输出的表。
+ * 遍历顺序与 std::map 相同；按序插入时追加到末尾，查找为二分查找。
+ * 插入与删除会使已有元素的引用与迭代器失效。
+ */
+template <typename TKey, typename TValue, typename TCompare = std::less<>> class SortedVectorMap
+{
+  public:
+    using key_type = TKey;
+    using mapped_type = TValue;
+    using value_type = std::pair<TKey, TValue>;
+    using size_type = size_t;
+    using iterator = typename std::vector<value_type>::iterator;
+    using const_iterator = typename std::vector<value_type>::const_iterator;
+
+    SortedVectorMap() = default;
+
+    [[nodiscard]] iterator begin() noexcept
+    {
+        return entries_.begin();
+    }
+
+    [[nodiscard]] iterator end() noexcept
+    {
+        return entries_.end();
+    }
+
+    [[nodiscard]] const_iterator begin() const noexcept
+    {
+        return entries_.begin();
+    }
+
+    [[nodiscard]] const_iterator end() const noexcept
+    {
+        return entries_.end();
+    }
+
+    [[nodiscard]] size_type size() const noexcept
+    {
+        return entries_.size();
+    }
+
+    [[nodiscard]] bool empty() const noexcept
+    {
+        return entries_.empty();
+    }
+
+    void clear() noexcept
+    {
+        entries_.clear();
+    }
+
+    void reserve(size_type count)
+    {
+        entries_.reserve(count);
+    }
+
+    template <typename TFind> [[nodiscard]] iterator find(const TFind &key)
+    {
+        const auto it = LowerBound(key);
+        return it != end() && !compare_(key, it->first) ? it : end();
+    }
+
+    template <typename TFind> [[nodiscard]] const_iterator find(const TFind &key) const
+    {
+        const auto it = LowerBound(key);
+        return it != end() && !compare_(key, it->first) ? it : end();
+    }
+
+    template <typename TFind> [[nodiscard]] size_type count(const TFind &key) const
+    {
+        return find(key) == end() ? 0 : 1;
+    }
+
+    template <typename TFind> [[nodiscard]] TValue &at(const TFind &key)
+    {
+        const auto it = find(key);
+        if (it == end())
+            throw std::out_of_range("SortedVectorMap::at: key not found");
+        return it->second;
+    }
+
+    template <typename TFind> [[nodiscard]] const TValue &at(const TFind &key) const
+    {
+        const auto it = find(key);
+        if (it == end())
+            throw std::out_of_range("SortedVectorMap::at: key not found");
+        return it->second;
+    }
+
+    TValue &operator[](const TKey &key)
+    {
+        return try_emplace(key).first->second;
+    }
+
+    TValue &operator[](TKey &&key)
+    {
+        return try_emplace(std::move(key)).first->second;
+    }
+
+    template <typename TKeyArg, typename... TArgs> std::pair<iterator, bool> try_emplace(TKeyArg &&key, TArgs &&...args)
+    {
+        // 按序插入的快速路径
+        auto it = entries_.empty() || compare_(entries_.back().first, key) ? end() : LowerBound(key);
+        if (it != end() && !compare_(key, it->first))
+            return {it, false};
+
+        it = entries_.emplace(it, std::piecewise_construct, std::forward_as_tuple(std::forward<TKeyArg>(key)),
+                              std::forward_as_tuple(std::forward<TArgs>(args)...));
+        return {it, true};
+    }
+
+    template <typename... TArgs> std::pair<iterator, bool> emplace(TArgs &&...args)
+    {
+        value_type value(std::forward<TArgs>(args)...);
+        return try_emplace(std::move(value.first), std::move(value.second));
+    }
+
+    template <typename... TArgs> iterator emplace_hint(const_iterator, TArgs &&...args)
+    {
+        return emplace(std::forward<TArgs>(args)...).first;
+    }
+
+    std::pair<iterator, bool> insert(value_type value)
+    {
+        return try_emplace(std::move(value.first), std::move(value.second));
+    }
+
+    template <typename TKeyArg, typename TValueArg>
+    std::pair<iterator, bool> insert_or_assign(TKeyArg &&key, TValueArg &&value)
+    {
+        if (const auto it = find(key); it != end())
+        {
+            it->second = std::forward<TValueArg>(value);
+            return {it, false};
+        }
+        return try_emplace(std::forward<TKeyArg>(key), std::forward<TValueArg>(value));
+    }
+
+    iterator erase(const_iterator pos)
+    {
+        return entries_.erase(pos);
+    }
+
+    template <typename TFind> size_type erase(const TFind &key)
+    {
+        const auto it = find(key);
+        if (it == end())
+            return 0;
+        entries_.erase(it);
+        return 1;
+    }
+
+    friend bool operator==(const SortedVectorMap &lhs, const SortedVectorMap &rhs)
+    {
+        return lhs.entries_ == rhs.entries_;
+    }
+
+    friend bool operator!=(const SortedVectorMap &lhs, const SortedVectorMap &rhs)
+    {
+        return !(lhs == rhs);
+    }
+
+  private:
+    std::vector<value_type> entries_;
+    TCompare compare_;
+
+    template <typename TFind> [[nodiscard]] iterator LowerBound(const TFind &key)
+    {
+        return std::lower_bound(entries_.begin(), entries_.end(), key,
+                                [this](const value_type &entry, const TFind &k) { return compare_(entry.first, k); });
+    }
+
+    template <typename TFind> [[nodiscard]] const_iterator LowerBound(const TFind &key) const
+    {
+        return std::lower_bound(entries_.begin(), entries_.end(), key,
+                                [this](const value_type &entry, const TFind &k) { return compare_(entry.first, k); });
+    }
+};
+
+// 按键的大小顺序返回映射中各元素的指针，用于在 FlatHashMap 上按确定且与插入顺序无关的顺序遍历
+template <typename TMap> std::vector<const typename TMap::value_type *> sorted_entries(const TMap &map)
+{
+    std::vector<const typename TMap::value_type *> entries;
+    entries.reserve(map.size());
+    for (const auto &entry : map)
+        entries.push_back(&entry);
+
+    std::sort(entries.begin(), entries.end(), [](const auto *lhs, const auto *rhs) { return lhs->first < rhs->first; });
+    return entries;
+}
+} // namespace albc::util
@@ -1,5 +1,6 @@
 #pragma once
 #include "albc_config.h"
+#include "albc_containers.h"
 #pragma clang diagnostic push
 #pragma ide diagnostic ignored "OCUnusedStructInspection"
 
@@ -20,6 +21,24 @@ namespace albc
 template <typename TKey, typename TValue>
 using Dictionary = std::map<TKey, TValue>;
 
+// 容器策略：
+// HashDictionary  载入后只做查找的表，开放寻址扁平哈希表，按插入顺序遍历
+// SmallDictionary 元素较少且遍历顺序影响输出的表，有序数组，遍历顺序与 Dictionary 相同
+// 定义 ALBC_CONFIG_STD_CONTAINERS 时两者均回退为 std::map，用于对比测试与排查问题
+#ifdef ALBC_CONFIG_STD_CONTAINERS
+template <typename TKey, typename TValue>
+using HashDictionary = std::map<TKey, TValue, std::less<>>;
+
+template <typename TKey, typename TValue>
+using SmallDictionary = std::map<TKey, TValue, std::less<>>;
+#else
+template <typename TKey, typename TValue>
+using HashDictionary = util::FlatHashMap<TKey, TValue>;
+
+template <typename TKey, typename TValue>
+using SmallDictionary = util::SortedVectorMap<TKey, TValue>;
+#endif
+
 template <typename T>
 using List = std::list<T>;
 
@@ -35,6 +54,10 @@ using Array = std::array<T1, N>;
 template <std::size_t N>
 using BitSet = std::bitset<N>;
 
+using UInt8 = uint8_t;
+
+using UInt16 = uint16_t;
+
 using Int32 = int32_t;
 
 using UInt32 = uint32_t;
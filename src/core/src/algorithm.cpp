@@ -3,20 +3,48 @@
 #include "util_time.h"
 #include "model_simulator.h"
 
+#include "CbcEventHandler.hpp"
 #include "CbcModel.hpp"
 #include "CoinModel.hpp"
+#include "CoinPackedVector.hpp"
+#include "CoinWarmStartBasis.hpp"
 #include "OsiClpSolverInterface.hpp"
 
 #include <bitset>
+#include <climits>
 #include <fstream>
 #include <numeric>
+#include <optional>
 #include <random>
 #include <regex>
+#include <stdexcept>
+#include <unordered_map>
 #include <unordered_set>
 
 
 namespace albc::algorithm
 {
+// 将取消令牌传递给Cbc，在分支定界的各个节点检查是否需要停止
+class AlbcCbcEventHandler : public CbcEventHandler
+{
+    const util::CancelToken *token_;
+  public:
+    explicit AlbcCbcEventHandler(const util::CancelToken *token) : token_(token)
+    {
+    }
+
+    CbcAction event(CbcEvent which_event) override
+    {
+        (void)which_event;
+        return token_ && token_->ShouldStop() ? stop : noAction;
+    }
+
+    [[nodiscard]] CbcEventHandler *clone() const override
+    {
+        return new AlbcCbcEventHandler(*this);
+    }
+};
+
 class AlbcCoinMessageHandler : public CoinMessageHandler
 {
     util::Logger logger;
@@ -54,19 +82,21 @@ class AlbcCoinMessageHandler : public CoinMessageHandler
     }
 };
 
-static void ResolveSpCharGroup(const Vector<model::OperatorModel*>& ops,
-                               Dictionary<std::string, Vector<UInt32 /* index of op */  >>& group_ops_map)
+// 按异格组名的字典序遍历，使互斥组与约束行的顺序不依赖于驻留顺序
+using SpCharGroupMap = std::map<util::Atom, Vector<UInt32 /* index of op */>, util::Atom::LexicalLess>;
+
+static void ResolveSpCharGroup(const Vector<model::OperatorModel*>& ops, SpCharGroupMap& group_ops_map)
 {
     group_ops_map.clear();
-    std::unordered_multiset<size_t> group_ops_set;
+    std::unordered_map<util::Atom, UInt32> group_op_cnt;
     for (const auto* op: ops)
         if (!op->sp_char_group.empty())
-            group_ops_set.insert(std::hash<std::string>()(op->sp_char_group));
+            ++group_op_cnt[op->sp_char_group];
 
     for (size_t i = 0; i < ops.size(); ++i)
     {
         if (ops[i]->sp_char_group.empty()
-            || group_ops_set.count(std::hash<std::string>()(ops[i]->sp_char_group)) <= 1)
+            || group_op_cnt[ops[i]->sp_char_group] <= 1)
             continue;
 
         group_ops_map[ops[i]->sp_char_group].push_back(static_cast<UInt32>(i));
@@ -89,14 +119,14 @@ std::string SolutionData::ToString() const
             break;
         }
 
-        append_snprintf(p, size, "**** Operator #%d: %-20s ****\n", n_op, op->char_id.c_str());
+        append_snprintf(p, size, "**** Operator #%d: %-20s ****\n", n_op, std::string(op->char_id.str()).c_str());
 
         int n_buff = 1;
         for (const auto &buff : op->buffs)
         {
-            append_snprintf(p, size, "\tBuff #%d: %8s %s\n", n_buff, buff->name.c_str(),
-                            buff->buff_id.c_str());
-            append_snprintf(p, size, "\t%s\n", buff->description.c_str());
+            append_snprintf(p, size, "\tBuff #%d: %8s %s\n", n_buff, buff->meta->name.c_str(),
+                            std::string(buff->meta->buff_id.str()).c_str());
+            append_snprintf(p, size, "\t%s\n", buff->meta->description.c_str());
             append_snprintf(p, size, "\tMod:      %s\n\tFinal Mod:%s\n\tCost Mod: %s\n\n",
                             snapshot[n_op - 1][n_buff - 1].room_mod.to_string().c_str(),
                             snapshot[n_op - 1][n_buff - 1].final_mod.to_string().c_str(),
@@ -161,24 +191,70 @@ void CombMaker::MakeComb(const Vector<model::OperatorModel *> &operators, UInt32
     }
 }
 
-void IAlgorithm::FilterOperators(const model::buff::RoomModel *room)
+UInt64 RoomEligibilityIndex::MakeKey(const model::buff::RoomModel *room)
+{
+    return static_cast<UInt64>(room->type) << 32 |
+           static_cast<UInt64>(room->room_attributes.prod_type) << 16 |
+           static_cast<UInt64>(room->room_attributes.order_type);
+}
+
+BitSet<model::buff::kOperatorMaxBuffs> RoomEligibilityIndex::GetEnabledBuffs(const model::OperatorModel *op,
+                                                                            const model::buff::RoomModel *room)
+{
+    BitSet<model::buff::kOperatorMaxBuffs> result;
+    int i = 0;
+    for (auto *buff : op->buffs)
+    {
+        if (buff != nullptr && util::check_flag(buff->meta->room_type, room->type) && buff->ValidateTarget(room))
+            result.set(i);
+
+        ++i;
+    }
+    return result;
+}
+
+const RoomEligibilityIndex::Entry &RoomEligibilityIndex::Acquire(const Vector<model::OperatorModel *> &operators,
+                                                                  const model::buff::RoomModel *room)
 {
-    inbound_ops_.clear();
+    auto &entry = entries_[MakeKey(room)];
+    if (entry)
+        return *entry;
 
-    for (auto *const ops : all_ops_)
+    entry = std::make_unique<Entry>();
+    for (auto *const op : operators)
     {
-        if (ops->buffs.empty())
+        if (op->buffs.empty())
             continue;
 
-        if (!util::check_flag(ops->room_type_mask, room->type))
+        if (!util::check_flag(op->room_type_mask, room->type))
             continue;
 
-        if (std::all_of(ops->buffs.begin(), ops->buffs.end(),
+        if (std::all_of(op->buffs.begin(), op->buffs.end(),
                         [room](model::buff::RoomBuff *buff) -> bool { return !buff->ValidateTarget(room); }))
             continue;
 
-        inbound_ops_.push_back(ops);
+        entry->operators.push_back(op);
+        entry->enabled_buffs.try_emplace(op, GetEnabledBuffs(op, room));
     }
+    return *entry;
+}
+
+const RoomEligibilityIndex::Entry *RoomEligibilityIndex::Find(const model::buff::RoomModel *room) const
+{
+    const auto it = entries_.find(MakeKey(room));
+    return it == entries_.end() ? nullptr : it->second.get();
+}
+
+void RoomEligibilityIndex::Remove(const model::OperatorModel *op)
+{
+    for (auto &[key, entry] : entries_)
+        entry->operators.erase(std::remove(entry->operators.begin(), entry->operators.end(), op),
+                               entry->operators.end());
+}
+
+void IAlgorithm::FilterOperators(const model::buff::RoomModel *room)
+{
+    inbound_ops_ = eligibility_index_.Acquire(all_ops_, room).operators;
     LOG_D("Filtered ", inbound_ops_.size(), " operators for room: ", room->id,
           " : [P]", util::enum_to_string(room->room_attributes.prod_type),
           " [O]", util::enum_to_string(room->room_attributes.order_type));
@@ -206,19 +282,17 @@ ALBC_FLATTEN void CombMaker::MakePartialComb(const Vector<model::OperatorModel *
     UInt32 buff_cnt[kRoomMaxBuffSlots]{}; // 第i层递归的buff数量
     bool status[kRoomMaxBuffSlots]{};     // 第i层递归的状态，false为正在入栈，true为正在出栈
 
+    // 经过 FilterOperators 的房间直接取索引中的结果，其余调用（如基准程序直接枚举）现场计算
+    const auto *eligibility = eligibility_index_.Find(room);
     Array<BitSet<kOperatorMaxBuffs>, kAlgOperatorSize> cached_enabled_buff;
     std::transform(operators.begin(), operators.end(), cached_enabled_buff.begin(),
-                   [room](model::OperatorModel *op) -> BitSet<kOperatorMaxBuffs>{
-                       BitSet<kOperatorMaxBuffs> result;
-                       int i = 0;
-                       for (auto *buff : op->buffs)
+                   [room, eligibility](model::OperatorModel *op) -> BitSet<kOperatorMaxBuffs> {
+                       if (eligibility)
                        {
-                           if (buff != nullptr && util::check_flag(buff->room_type, room->type) && buff->ValidateTarget(room))
-                               result.set(i);
-
-                           ++i;
+                           if (const auto it = eligibility->enabled_buffs.find(op); it != eligibility->enabled_buffs.end())
+                               return it->second;
                        }
-                       return result;
+                       return RoomEligibilityIndex::GetEnabledBuffs(op, room);
                    });
 
     Array<model::OperatorModel *, kRoomMaxOperators> current = {}; // 当前递归选中的干员
@@ -252,6 +326,16 @@ ALBC_FLATTEN void CombMaker::MakePartialComb(const Vector<model::OperatorModel *
                     double result, duration;
                     Simulator::DoCalc(room, max_duration, result, duration);
                     solution_holder.OnSolutionFound(current, result, duration);
+
+                    if (cancel_token_ && calc_cnt % kCancelCheckInterval == 0 && cancel_token_->ShouldStop())
+                    {
+                        // 还原房间内的buff栈后退出
+                        for (UInt32 d = 0; d <= dep; ++d)
+                            room->n_buff -= buff_cnt[d];
+
+                        solution_holder.UpdateCalcCnt(calc_cnt);
+                        cancel_token_->ThrowIfStopped();
+                    }
                 }
                 else
                 {
@@ -285,6 +369,12 @@ ALBC_FLATTEN void CombMaker::MakePartialComb(const Vector<model::OperatorModel *
     solution_holder.UpdateCalcCnt(calc_cnt);
 }
 
+// 基准程序（src/bench）按房间单独测量组合枚举，需要可链接的实例
+template void CombMaker::MakeComb<AllSolutionHolder>(const Vector<model::OperatorModel *> &, UInt32,
+                                                     model::buff::RoomModel *, AllSolutionHolder &);
+template void CombMaker::MakeComb<GreedySolutionHolder>(const Vector<model::OperatorModel *> &, UInt32,
+                                                        model::buff::RoomModel *, GreedySolutionHolder &);
+
 void CombMaker::Run(AlgorithmResult &result)
 {
     result.Clear();
@@ -327,10 +417,10 @@ HardMutexResolver::HardMutexResolver(const Vector<model::OperatorModel *> &ops,
     // 用于处理不能同时生效的Buff和异格干员
     static constexpr size_t buff_type_cnt = util::enum_size<model::buff::RoomBuffType>::value;
     UInt32 buff_type_mutex_group_map[buff_type_cnt];
-    Dictionary<std::string /*sp_char_group*/, UInt32> sp_char_group_mutex_group_map;
+    std::unordered_map<util::Atom /*sp_char_group*/, UInt32> sp_char_group_mutex_group_map;
     std::fill_n(buff_type_mutex_group_map, buff_type_cnt, UINT32_MAX);
 
-    Dictionary<std::string, Vector<UInt32>> sp_char_group_map;
+    SpCharGroupMap sp_char_group_map;
     ResolveSpCharGroup(ops, sp_char_group_map);
 
     for (const auto& [sp_char_group, op_indices] : sp_char_group_map)
@@ -363,16 +453,16 @@ HardMutexResolver::HardMutexResolver(const Vector<model::OperatorModel *> &ops,
             bool op_is_mutex = mutex_ops[op_idx];
             for (const auto buff : op->buffs)
             {
-                if (buff->room_type == room_type && buff->is_mutex)
+                if (buff->meta->room_type == room_type && buff->meta->is_mutex)
                 {
                     if (op_is_mutex)
                     {
                         LOG_E("Logic error: operator ", op->char_id, " has more than one mutex buff or operator is SP char! "
-                                                                     "The buff: ", buff->buff_id, " will be ignored");
+                                                                     "The buff: ", buff->meta->buff_id, " will be ignored");
                         continue;
                     }
 
-                    auto &type_pos_in_mutex_groups = buff_type_mutex_group_map[static_cast<UInt32>(buff->inner_type)];
+                    auto &type_pos_in_mutex_groups = buff_type_mutex_group_map[static_cast<UInt32>(buff->meta->inner_type)];
                     if (type_pos_in_mutex_groups == UINT32_MAX)
                     {
                         type_pos_in_mutex_groups = static_cast<UInt32>(mutex_groups_.size());
@@ -488,16 +578,33 @@ void MultiRoomGreedy::Run(AlgorithmResult &result)
                                                            op) != solution_holder.max_solution.operators.end();
                                       }),
                        all_ops_.end());
+        for (const auto *op : solution_holder.max_solution.operators)
+        {
+            if (op)
+                eligibility_index_.Remove(op);
+        }
     }
 }
 
 void MultiRoomIntegerProgramming::Run(AlgorithmResult &out_result)
 {
     out_result.Clear();
-    Vector<Vector<SolutionData>> room_solutions;
+    // 参数错误不能当作空方案返回，与 JsonInParams 一致抛出异常
+    if (params_.shift_count < 0 || params_.shift_count > ALBC_MAX_SHIFT_COUNT)
+        throw std::invalid_argument("Invalid shift count: " + std::to_string(params_.shift_count) +
+                                    ", expected 0 to " + std::to_string(ALBC_MAX_SHIFT_COUNT) + " (0 is treated as 1)");
+    if (params_.alt_plan_count > ALBC_MAX_ALT_PLAN_COUNT)
+        throw std::invalid_argument("Invalid alternative plan count: " + std::to_string(params_.alt_plan_count) +
+                                    ", expected at most " + std::to_string(ALBC_MAX_ALT_PLAN_COUNT));
+
+    auto &stats = out_result.stats;
+    Vector<SolutionVector> room_solutions;
     Vector<UInt32> room_ranges;
     UInt32 total_solution_count = 0;
-    GenCombForRooms(room_solutions, room_ranges, total_solution_count);
+    {
+        const mem::MemPhaseScope enum_scope(stats.memory[mem::MemPhase::ENUMERATION]);
+        GenCombForRooms(room_solutions, room_ranges, total_solution_count, stats);
+    }
 
     if (total_solution_count < 1)
     {
@@ -514,8 +621,19 @@ void MultiRoomIntegerProgramming::Run(AlgorithmResult &out_result)
      * 对于一个房间, xi1 + ... + xin <= 1 (每个房间最多选择一个组合)
      * 对于组合中的某个干员, 包含其的组合的集为Z, ΣZ ∈ {0, 1} (每个干员最多选中一次)
      * max W = Σ(xi * wi)
+     *
+     * 多班次（shift_count > 1）时，每个班次长 model_time_limit，组合只枚举一次，按班次复制为列 (房间, 组合, 班次)，
+     * 列与上述各行均按班次依次排列，每个班次各自满足上述约束。
+     * 干员的可工作时间（心情）在班次间结转：组合的持续时间即其中每名干员消耗的可工作时间（1X倍率），
+     * 干员每休息一个班次恢复 R = rest_recovery，第s班结束时的剩余时间不能为负：
+     * Σ(t <= s) Σ(c ∋ op) (duration_c + R) * x_ct <= D_op + R * (s + 1)
+     * 只为前 s + 1 个班次满负荷工作会超出 D_op 的干员与班次建立该行。心情上限未建模，R > 0 时结果偏乐观
      */
+    const UInt32 shift_cnt = static_cast<UInt32>(std::max(params_.shift_count, 1));
 
+    // 约束矩阵在整个求解期间都要使用，构建完成后即结束此阶段
+    std::optional<mem::MemPhaseScope> matrix_scope;
+    matrix_scope.emplace(stats.memory[mem::MemPhase::MATRIX]);
 
     RowRangeMap row_range_map;
     // 干员行定义
@@ -541,7 +659,7 @@ void MultiRoomIntegerProgramming::Run(AlgorithmResult &out_result)
     UInt32 sp_op_elem_cnt = 0;
     Vector<UInt32> op_row_to_sp_group_row_map(all_ops_.size(), UINT32_MAX);
     {
-        Dictionary<std::string, Vector<UInt32>> sp_char_group_map;
+        SpCharGroupMap sp_char_group_map;
         ResolveSpCharGroup(all_ops_, sp_char_group_map);
         auto sp_group_row_start_idx = row_range_map[RowType::ROOM_CONS].End();
         sp_group_cnt = static_cast<UInt32>(sp_char_group_map.size());
@@ -562,21 +680,79 @@ void MultiRoomIntegerProgramming::Run(AlgorithmResult &out_result)
         }
     }
 
-    const UInt32 col_cnt = total_solution_count;
-    const auto row_cnt = static_cast<UInt32>(all_ops_.size() + rooms_.size() + sp_group_cnt);
-    UInt32 elem_reserve_cnt = sp_op_elem_cnt;
+    const UInt32 shift_col_cnt = total_solution_count;
+    const auto shift_row_cnt = static_cast<UInt32>(all_ops_.size() + rooms_.size() + sp_group_cnt);
+    UInt64 shift_elem_reserve_cnt = sp_op_elem_cnt;
     UInt32 elem_cnt = 0;
     for (int i = 0; i < (int)room_solutions.size(); ++i)
-        elem_reserve_cnt += (1 + rooms_[i]->max_slot_count) * static_cast<UInt32>(room_solutions[i].size());
+        shift_elem_reserve_cnt += (1 + rooms_[i]->max_slot_count) * static_cast<UInt64>(room_solutions[i].size());
+
+    // 心情结转行，morale_rows[op_idx * shift_cnt + s] 为干员在第s班结束时的约束行，UINT32_MAX 为无需约束
+    const double rest_recovery = std::max(params_.rest_recovery, 0.);
+    Vector<Vector<UInt32>> op_cols;
+    Vector<UInt32> morale_rows;
+    Vector<double> morale_row_ub;
+    UInt64 morale_elem_cnt = 0;
+    if (shift_cnt > 1)
+    {
+        op_cols.resize(all_ops_.size());
+        UInt32 c = 0;
+        for (const auto &solutions : room_solutions)
+        {
+            for (const auto &solution : solutions)
+            {
+                for (const auto op : solution.operators)
+                    if (op)
+                        op_cols[op_inst_id_to_op_row_map[op->inst_id] - row_range_map[RowType::OP_CONS].start].push_back(c);
+                c++;
+            }
+        }
 
-    Vector<double> obj(col_cnt);
-    Vector<double> elems(elem_reserve_cnt, 1);
-    Vector<int> row_indices(elem_reserve_cnt);
-    Vector<int> col_indices(elem_reserve_cnt);
-    Vector<double> row_lb(row_cnt, 0);
-    Vector<double> row_ub(row_cnt, 1);
-    Vector<double> col_lb(col_cnt, 0);
-    Vector<double> col_ub(col_cnt, 1);
+        morale_rows.resize(all_ops_.size() * shift_cnt, UINT32_MAX);
+        auto row = shift_row_cnt * shift_cnt;
+        for (UInt32 op_idx = 0; op_idx < all_ops_.size(); ++op_idx)
+        {
+            if (op_cols[op_idx].empty())
+                continue;
+
+            UInt32 later_rows = 0; // 第t班的列出现在第t班及之后各班的行中
+            for (UInt32 s = shift_cnt; s-- > 0;)
+            {
+                if (all_ops_[op_idx]->duration < (s + 1) * params_.model_time_limit)
+                {
+                    morale_rows[op_idx * shift_cnt + s] = row++;
+                    morale_row_ub.push_back(all_ops_[op_idx]->duration + rest_recovery * (s + 1));
+                    ++later_rows;
+                }
+                morale_elem_cnt += later_rows * static_cast<UInt64>(op_cols[op_idx].size());
+            }
+        }
+    }
+
+    // Cbc 以 int 索引行、列与非零元，班次复制后任一规模超出 INT_MAX 时放弃求解
+    const UInt64 col_cnt_64 = static_cast<UInt64>(shift_col_cnt) * shift_cnt;
+    const UInt64 row_cnt_64 = static_cast<UInt64>(shift_row_cnt) * shift_cnt + morale_row_ub.size();
+    const UInt64 elem_reserve_cnt_64 = shift_elem_reserve_cnt * shift_cnt + morale_elem_cnt;
+    if (col_cnt_64 > INT_MAX || row_cnt_64 > INT_MAX || elem_reserve_cnt_64 > INT_MAX)
+        throw std::runtime_error("Model too large: " + std::to_string(col_cnt_64) + " cols, " +
+                                 std::to_string(row_cnt_64) + " rows, " + std::to_string(elem_reserve_cnt_64) +
+                                 " elements with " + std::to_string(shift_cnt) + " shifts");
+
+    const auto col_cnt = static_cast<UInt32>(col_cnt_64);
+    const auto row_cnt = static_cast<UInt32>(row_cnt_64);
+    const auto elem_reserve_cnt = static_cast<UInt32>(elem_reserve_cnt_64);
+
+    // 约束矩阵三元组与上下界只在本次求解内使用，随 arena 一并释放
+    const mem::ArenaAllocator<double> dbl_alloc(arena_);
+    const mem::ArenaAllocator<int> int_alloc(arena_);
+    mem::ArenaVector<double> obj(col_cnt, 0, dbl_alloc);
+    mem::ArenaVector<double> elems(elem_reserve_cnt, 1, dbl_alloc);
+    mem::ArenaVector<int> row_indices(elem_reserve_cnt, 0, int_alloc);
+    mem::ArenaVector<int> col_indices(elem_reserve_cnt, 0, int_alloc);
+    mem::ArenaVector<double> row_lb(row_cnt, 0, dbl_alloc);
+    mem::ArenaVector<double> row_ub(row_cnt, 1, dbl_alloc);
+    mem::ArenaVector<double> col_lb(col_cnt, 0, dbl_alloc);
+    mem::ArenaVector<double> col_ub(col_cnt, 1, dbl_alloc);
 
     {
         UInt32 c = 0;
@@ -594,6 +770,9 @@ void MultiRoomIntegerProgramming::Run(AlgorithmResult &out_result)
                 c++;
             }
         }
+
+        for (UInt32 s = 1; s < shift_cnt; ++s)
+            std::copy_n(obj.begin(), shift_col_cnt, obj.begin() + s * shift_col_cnt);
     }
 
     {
@@ -632,10 +811,53 @@ void MultiRoomIntegerProgramming::Run(AlgorithmResult &out_result)
         }
     }
 
+    // 其余班次复制第一班的约束，行与列按班次平移
+    const UInt32 shift_elem_cnt = elem_cnt;
+    for (UInt32 s = 1; s < shift_cnt; ++s)
+    {
+        for (UInt32 i = 0; i < shift_elem_cnt; ++i)
+        {
+            row_indices[elem_cnt] = row_indices[i] + (int)(s * shift_row_cnt);
+            col_indices[elem_cnt] = col_indices[i] + (int)(s * shift_col_cnt);
+            elem_cnt++;
+        }
+    }
+
+    // 心情结转约束
+    for (UInt32 op_idx = 0; op_idx < op_cols.size(); ++op_idx)
+    {
+        for (const auto c : op_cols[op_idx])
+        {
+            const double consumption =
+                room_solutions[GetRoomIdx(c, room_ranges)][GetIndexInRoom(c, room_ranges)].duration + rest_recovery;
+            for (UInt32 t = 0; t < shift_cnt; ++t)
+            {
+                for (UInt32 s = t; s < shift_cnt; ++s)
+                {
+                    const UInt32 morale_row = morale_rows[op_idx * shift_cnt + s];
+                    if (morale_row == UINT32_MAX)
+                        continue;
+
+                    row_indices[elem_cnt] = (int)morale_row;
+                    col_indices[elem_cnt] = (int)(t * shift_col_cnt + c);
+                    elems[elem_cnt] = consumption;
+                    elem_cnt++;
+                }
+            }
+        }
+    }
+    std::copy(morale_row_ub.begin(), morale_row_ub.end(), row_ub.begin() + shift_row_cnt * shift_cnt);
+
     LOG_D("Inserted ", elem_cnt, " elements out of ", elem_reserve_cnt, " reserved.");
+    stats.totals.col_cnt = col_cnt;
+    stats.totals.row_cnt = row_cnt;
+    stats.totals.matrix_nnz = elem_cnt;
+    matrix_scope.reset();
+    util::throw_if_stopped(cancel_token_);
     LOG_I("Solving using Cbc solver");
     {
         const auto &sc = SCOPE_TIMER_WITH_TRACE("Solving using Cbc solver");
+        const mem::MemPhaseScope solver_scope(stats.memory[mem::MemPhase::SOLVER]);
         auto message_handler = std::make_unique<AlbcCoinMessageHandler>();
         OsiClpSolverInterface solver;
         solver.setHintParam(OsiDoReducePrint, true, OsiHintTry);
@@ -645,13 +867,26 @@ void MultiRoomIntegerProgramming::Run(AlgorithmResult &out_result)
         for (int c = 0; c < (int)col_cnt; ++c)
             solver.setInteger(c);
 
+        bool has_alternatives = params_.alt_exclusion_plans || params_.alt_plan_count > 0;
+        if (has_alternatives && shift_cnt > 1)
+        {
+            LOG_W("Alternative plans are not supported with multiple shifts, skipped.");
+            has_alternatives = false;
+        }
+        std::unique_ptr<CoinWarmStart> root_basis;
+        Vector<UInt32> best_cols;
+
         CbcModel model(solver);
-        model.passInMessageHandler(message_handler.get());
-        model.messageHandler()->setLogLevel(1);
-        model.setDblParam(CbcModel::CbcMaximumSeconds, params_.solve_time_limit);
-        model.setObjSense(-1);
-        model.initialSolve();
-        model.branchAndBound();
+        stats.totals.solve_time = SolveCbcModel(model, message_handler.get(), params_.solve_time_limit,
+                                                has_alternatives ? &root_basis : nullptr);
+        stats.totals.node_cnt = static_cast<UInt32>(model.getNodeCount());
+        stats.totals.lp_iterations = static_cast<UInt32>(model.getIterationCount());
+        if (model.getMinimizationObjValue() < 1e50)
+        {
+            const double obj_value = model.getObjValue();
+            stats.totals.gap = std::abs(model.getBestPossibleObjValue() - obj_value) / std::max(std::abs(obj_value), 1e-10);
+        }
+        util::throw_if_stopped(cancel_token_);
 
         switch (model.status())
         {
@@ -685,31 +920,36 @@ void MultiRoomIntegerProgramming::Run(AlgorithmResult &out_result)
             const double *solution = model.solver()->getColSolution();
 
             // print overall solution info
-            for (UInt32 c = 0; c < solution_cols; ++c)
+            if (util::GlobalLogConfig::CanLog(util::LogLevel::INFO))
             {
-                if (util::fp_eq(solution[c], 0.))
-                    continue;
+                for (UInt32 c = 0; c < solution_cols; ++c)
+                {
+                    if (util::fp_eq(solution[c], 0.))
+                        continue;
 
-                UInt32 room_idx = GetRoomIdx(c, room_ranges);
-                UInt32 sol_idx_in_room = GetIndexInRoom(c, room_ranges);
-                char buf[128];
-                char *p = buf;
-                size_t l = sizeof(buf);
-                double duration = room_solutions[room_idx][sol_idx_in_room].duration;
-                double prod = obj[c];
-                double time_eff = prod / duration;
-                const auto &room = *rooms_[room_idx];
-                util::append_snprintf(p, l, "Room#%d \"%-10s\" [Prod %10s][Ord %10s][nSlot %d]: avg %3.f%% (+%3.f%%) (%.2f / %.2f)",
-                                room_idx,
-                                room.id.c_str(),
-                                util::enum_to_string(room.room_attributes.prod_type).data(),
-                                util::enum_to_string(room.room_attributes.order_type).data(),
-                                room.max_slot_count,
-                                time_eff * 100,
-                                (time_eff - 1) * 100,
-                                prod,
-                                duration);
-                LOG_I(buf);
+                    UInt32 room_idx = GetRoomIdx(c % shift_col_cnt, room_ranges);
+                    UInt32 sol_idx_in_room = GetIndexInRoom(c % shift_col_cnt, room_ranges);
+                    char buf[144];
+                    char *p = buf;
+                    size_t l = sizeof(buf);
+                    if (shift_cnt > 1)
+                        util::append_snprintf(p, l, "Shift#%d ", static_cast<int>(c / shift_col_cnt));
+                    double duration = room_solutions[room_idx][sol_idx_in_room].duration;
+                    double prod = obj[c];
+                    double time_eff = prod / duration;
+                    const auto &room = *rooms_[room_idx];
+                    util::append_snprintf(p, l, "Room#%d \"%-10s\" [Prod %10s][Ord %10s][nSlot %d]: avg %3.f%% (+%3.f%%) (%.2f / %.2f)",
+                                    room_idx,
+                                    room.id.c_str(),
+                                    util::enum_to_string(room.room_attributes.prod_type).data(),
+                                    util::enum_to_string(room.room_attributes.order_type).data(),
+                                    room.max_slot_count,
+                                    time_eff * 100,
+                                    (time_eff - 1) * 100,
+                                    prod,
+                                    duration);
+                    LOG_I(buf);
+                }
             }
 
             // print solution details
@@ -718,23 +958,37 @@ void MultiRoomIntegerProgramming::Run(AlgorithmResult &out_result)
                 if (util::fp_eq(solution[c], 0.))
                     continue;
 
-                UInt32 room = GetRoomIdx(c, room_ranges);
-                UInt32 sol_idx_in_room = GetIndexInRoom(c, room_ranges);
-                LOG_D("***** Solution: col#", c, " at room#", room, " index#", sol_idx_in_room, " *****");
+                UInt32 room = GetRoomIdx(c % shift_col_cnt, room_ranges);
+                UInt32 sol_idx_in_room = GetIndexInRoom(c % shift_col_cnt, room_ranges);
+                LOG_D("***** Solution: col#", c, " at shift#", c / shift_col_cnt, " room#", room, " index#",
+                      sol_idx_in_room, " *****");
                 LOG_D(GetSolutionInfo(*rooms_[room], room_solutions[room][sol_idx_in_room]));
             }
 
-            for (UInt32 c = 0; c < solution_cols; ++c)
+            const mem::MemPhaseScope result_scope(stats.memory[mem::MemPhase::RESULT]);
+            best_cols = GetSelectedCols(solution, solution_cols);
+            if (shift_cnt > 1)
             {
-                if (util::fp_eq(solution[c], 0.))
-                    continue;
-
-                UInt32 room = GetRoomIdx(c, room_ranges);
-                UInt32 sol_idx_in_room = GetIndexInRoom(c, room_ranges);
-                auto &room_result = out_result.rooms.emplace_back();
-                room_result.room = rooms_[room];
-                room_result.solution = room_solutions[room][sol_idx_in_room];
+                // 各班次的列减去班次偏移后即为组合的列
+                Vector<Vector<UInt32>> shift_cols(shift_cnt);
+                for (const auto c : best_cols)
+                    shift_cols[c / shift_col_cnt].push_back(c % shift_col_cnt);
+
+                out_result.shifts.resize(shift_cnt);
+                for (UInt32 s = 0; s < shift_cnt; ++s)
+                    CollectRooms(shift_cols[s], room_solutions, room_ranges, out_result.shifts[s]);
+                out_result.rooms = out_result.shifts.front();
             }
+            else
+            {
+                CollectRooms(best_cols, room_solutions, room_ranges, out_result.rooms);
+            }
+        }
+
+        if (has_alternatives && !best_cols.empty())
+        {
+            SolveAlternativePlans(solver, message_handler.get(), root_basis, best_cols, op_inst_id_to_op_row_map,
+                                  room_solutions, room_ranges, out_result);
         }
     }
 
@@ -749,37 +1003,182 @@ void MultiRoomIntegerProgramming::Run(AlgorithmResult &out_result)
     }
 }
 
-void MultiRoomIntegerProgramming::GenCombForRooms(Vector<Vector<SolutionData>> &room_solutions,
-                                                  Vector<UInt32> &room_ranges, UInt32 &col_cnt)
+double MultiRoomIntegerProgramming::SolveCbcModel(CbcModel &model, CoinMessageHandler *handler, double max_seconds,
+                                                  std::unique_ptr<CoinWarmStart> *out_root_basis) const
+{
+    model.passInMessageHandler(handler);
+    model.messageHandler()->setLogLevel(1);
+
+    if (cancel_token_)
+    {
+        AlbcCbcEventHandler event_handler(cancel_token_);
+        model.passInEventHandler(&event_handler); // Cbc 内部会复制一份
+        max_seconds = std::min(max_seconds, cancel_token_->GetRemainingSeconds());
+    }
+    model.setDblParam(CbcModel::CbcMaximumSeconds, max_seconds);
+    model.setObjSense(-1);
+    return util::MeasureTime([&model, out_root_basis] {
+               model.initialSolve();
+               if (out_root_basis)
+                   out_root_basis->reset(model.solver()->getWarmStart());
+               model.branchAndBound();
+           }).count();
+}
+
+void MultiRoomIntegerProgramming::SolveAlternativePlans(OsiClpSolverInterface &solver, CoinMessageHandler *handler,
+                                                        std::unique_ptr<CoinWarmStart> &basis,
+                                                        const Vector<UInt32> &best_cols,
+                                                        const Vector<UInt32> &op_inst_id_to_op_row_map,
+                                                        const Vector<SolutionVector> &room_solutions,
+                                                        const Vector<UInt32> &room_ranges,
+                                                        AlgorithmResult &out_result) const
+{
+    const auto &sc = SCOPE_TIMER_WITH_TRACE("Solving alternative plans");
+    double remaining_seconds = params_.solve_time_limit - out_result.stats.totals.solve_time;
+
+    // 以当前的约束重新求解，未得到可行解（含超时）时返回 false
+    const auto resolve = [&](AlternativePlan &plan, Vector<UInt32> &cols) {
+        if (remaining_seconds <= 0)
+        {
+            LOG_W("Solving time limit exceeded, remaining alternative plans are skipped.");
+            return false;
+        }
+
+        // 追加的割行在基中记为基变量
+        if (auto *ws = dynamic_cast<CoinWarmStartBasis *>(basis.get()))
+        {
+            ws->resize(solver.getNumRows(), solver.getNumCols());
+            solver.setWarmStart(ws);
+        }
+
+        CbcModel model(solver);
+        plan.solve_time = SolveCbcModel(model, handler, remaining_seconds, &basis);
+        remaining_seconds -= plan.solve_time;
+        util::throw_if_stopped(cancel_token_);
+
+        // status 1 为超时等中止，保留已找到的可行解并标记为非最优，之后的方案因时间耗尽而跳过
+        if (model.status() > 1 || model.getMinimizationObjValue() >= 1e50)
+            return false;
+
+        plan.optimal = model.isProvenOptimal();
+        plan.objective = model.getObjValue();
+        cols = GetSelectedCols(model.solver()->getColSolution(), model.solver()->getNumCols());
+        CollectRooms(cols, room_solutions, room_ranges, plan.rooms);
+        return true;
+    };
+
+    if (params_.alt_exclusion_plans)
+    {
+        for (const auto c : best_cols)
+        {
+            const auto &solution = room_solutions[GetRoomIdx(c, room_ranges)][GetIndexInRoom(c, room_ranges)];
+            for (const auto *op : solution.operators)
+            {
+                if (!op)
+                    continue;
+
+                const auto op_row = static_cast<int>(op_inst_id_to_op_row_map[op->inst_id]);
+                AlternativePlan plan;
+                plan.excluded = op;
+                Vector<UInt32> cols;
+                solver.setRowUpper(op_row, 0);
+                const bool found = resolve(plan, cols);
+                solver.setRowUpper(op_row, 1);
+
+                if (found)
+                    out_result.alternatives.push_back(std::move(plan));
+                else if (remaining_seconds <= 0)
+                    return;
+            }
+        }
+    }
+
+    Vector<UInt32> last_cols = best_cols;
+    for (int k = 0; k < params_.alt_plan_count && !last_cols.empty(); ++k)
+    {
+        const Vector<int> indices(last_cols.begin(), last_cols.end());
+        const Vector<double> elements(indices.size(), 1.);
+        solver.addRow(CoinPackedVector(static_cast<int>(indices.size()), indices.data(), elements.data()),
+                      -solver.getInfinity(), static_cast<double>(indices.size()) - 1.);
+
+        AlternativePlan plan;
+        if (!resolve(plan, last_cols))
+            break;
+
+        out_result.alternatives.push_back(std::move(plan));
+    }
+}
+
+Vector<UInt32> MultiRoomIntegerProgramming::GetSelectedCols(const double *solution, UInt32 col_cnt)
+{
+    Vector<UInt32> cols;
+    for (UInt32 c = 0; c < col_cnt; ++c)
+    {
+        if (!util::fp_eq(solution[c], 0.))
+            cols.push_back(c);
+    }
+    return cols;
+}
+
+void MultiRoomIntegerProgramming::CollectRooms(const Vector<UInt32> &cols, const Vector<SolutionVector> &room_solutions,
+                                               const Vector<UInt32> &room_ranges, Vector<RoomResult> &out_rooms) const
+{
+    for (const auto c : cols)
+    {
+        UInt32 room = GetRoomIdx(c, room_ranges);
+        UInt32 sol_idx_in_room = GetIndexInRoom(c, room_ranges);
+        auto &room_result = out_rooms.emplace_back();
+        room_result.room = rooms_[room];
+        room_result.solution = room_solutions[room][sol_idx_in_room];
+    }
+}
+
+void MultiRoomIntegerProgramming::GenCombForRooms(Vector<SolutionVector> &room_solutions,
+                                                  Vector<UInt32> &room_ranges, UInt32 &col_cnt, SolveStats &stats)
 {
     const auto &sc = SCOPE_TIMER_WITH_TRACE("Generating combinations");
     for (auto room : this->rooms_)
     {
-        this->FilterOperators(room);
+        util::throw_if_stopped(cancel_token_);
+        const auto trace = TRACE_SCOPE_WITH_ID("GenCombForRoom", room->id);
+        auto &room_stats = stats.rooms.emplace_back();
+        room_stats.room_id = room->id;
+        room_stats.filter_time = util::MeasureTime(&MultiRoomIntegerProgramming::FilterOperators, this, room).count();
         if (inbound_ops_.empty())
         {
             LOG_W("No inbound operators for room#", room->id);
         }
 
-        AllSolutionHolder solution_holder;
-        this->MakeComb(this->inbound_ops_, room->max_slot_count, room, solution_holder);
+        AllSolutionHolder solution_holder(arena_);
+        room_stats.enum_time = util::MeasureTime(&MultiRoomIntegerProgramming::MakeComb<AllSolutionHolder>, this,
+                                                 inbound_ops_, room->max_slot_count, room, solution_holder)
+                                   .count();
 
         if (solution_holder.solutions.empty())
         {
             LOG_W("No solution for room ", room->id);
         }
 
+        room_stats.inbound_ops = static_cast<UInt32>(inbound_ops_.size());
+        room_stats.calc_cnt = solution_holder.calc_cnt;
+        room_stats.col_cnt = static_cast<UInt32>(solution_holder.solutions.size());
+        stats.totals.filter_time += room_stats.filter_time;
+        stats.totals.enum_time += room_stats.enum_time;
+        stats.totals.calc_cnt += room_stats.calc_cnt;
+
         room_ranges.push_back(col_cnt);
         col_cnt += static_cast<UInt32>(solution_holder.solutions.size());
         room_solutions.emplace_back(std::move(solution_holder.solutions));
     }
+    stats.totals.room_cnt = static_cast<UInt32>(rooms_.size());
+    stats.totals.col_cnt = col_cnt;
     LOG_I("Generated ", col_cnt, " combinations.");
 }
 
-void MultiRoomIntegerProgramming::GenLpFile(Vector<Vector<SolutionData>> &room_solutions, const Vector<double> &obj,
-                                            UInt32 row_cnt, UInt32 col_cnt, const Vector<double> &elems,
-                                            const Vector<int> &row_indices, Vector<int> &col_indices,
-                                            const RowRangeMap& ranges, const Vector<double> &row_ub) const
+void MultiRoomIntegerProgramming::GenLpFile(Vector<SolutionVector> &room_solutions, const mem::ArenaVector<double> &obj,
+                                            UInt32 row_cnt, UInt32 col_cnt, const mem::ArenaVector<double> &elems,
+                                            const mem::ArenaVector<int> &row_indices, mem::ArenaVector<int> &col_indices,
+                                            const RowRangeMap& ranges, const mem::ArenaVector<double> &row_ub) const
 {
     const auto lp_file_path = "./problem.lp";
     const auto &sc = SCOPE_TIMER_WITH_TRACE("Writing LP File");
@@ -816,11 +1215,12 @@ void MultiRoomIntegerProgramming::GenLpFile(Vector<Vector<SolutionData>> &room_s
 
                 col_name.append("_");
                 // extract char_name
+                const std::string char_id(op->char_id.str());
                 std::smatch m;
-                std::regex_search(op->char_id, m, e);
+                std::regex_search(char_id, m, e);
                 // if not matched, use char_id directly
                 if (m.empty())
-                    col_name.append(op->char_id);
+                    col_name.append(char_id);
                 else
                     col_name.append(m[2]);
             }
@@ -829,11 +1229,16 @@ void MultiRoomIntegerProgramming::GenLpFile(Vector<Vector<SolutionData>> &room_s
         ++room_idx;
     }
 
+    // 多班次时其余班次的列复制第一班的名称并加上班次后缀
+    for (UInt64 c = col; col > 0 && c < col_cnt; ++c)
+        col_name_map[c] = col_name_map[c % col] + "_s" + std::to_string(c / col);
+
     lp_file << R"(\Arknights building arrangement problem generated by algorithm.)" << std::endl;
     lp_file << R"(\Problem info:)" << std::endl;
     lp_file << R"(\  - Room count: )" << this->rooms_.size() << std::endl;
     lp_file << R"(\  - Combination count: )" << col_cnt << std::endl;
     lp_file << R"(\  - Model time limit: )" << this->params_.model_time_limit << std::endl;
+    lp_file << R"(\  - Shift count: )" << std::max(this->params_.shift_count, 1) << std::endl;
     lp_file
         << R"(\To view details of all combinations, please add cli parameter "--solution-detail"/"-S" or set AlbcSolverParameters.gen_all_solution_details to true in api.)"
         << std::endl;
@@ -868,7 +1273,7 @@ void MultiRoomIntegerProgramming::GenLpFile(Vector<Vector<SolutionData>> &room_s
             break;
 
         case RowType::OP_CONS:
-            row_name = this->all_ops_[row_index_in_type]->char_id;
+            row_name = this->all_ops_[row_index_in_type]->char_id.str();
             break;
 
         case RowType::ROOM_CONS:
@@ -896,7 +1301,7 @@ void MultiRoomIntegerProgramming::GenLpFile(Vector<Vector<SolutionData>> &room_s
 
             if (!util::fp_eq(elem, 1.))
             {
-                lp_file << elem << col_name_map[c];
+                lp_file << elem << ' ' << col_name_map[c];
             }
             else
             {
@@ -921,7 +1326,7 @@ void MultiRoomIntegerProgramming::GenLpFile(Vector<Vector<SolutionData>> &room_s
 }
 
 void MultiRoomIntegerProgramming::GenSolDetails(const Vector<model::buff::RoomModel *> &rooms,
-                                                const Vector<Vector<SolutionData>> &room_solutions,
+                                                const Vector<SolutionVector> &room_solutions,
                                                 Vector<UInt32> &room_ranges, size_t col_cnt)
 {
     const auto sol_details_file_path = "./solution_details.txt";
@@ -2,11 +2,50 @@
 
 #include "albc/calbc.h"
 #include "algorithm_params.h"
+#include "util_cancel.h"
 #include <bitset>
+#include <memory>
+
+class CbcModel;
+class CoinMessageHandler;
+class CoinWarmStart;
+class OsiClpSolverInterface;
 
 namespace albc::algorithm
 {
 
+/**
+ * @brief 房间可用干员索引
+ * 干员能否放入房间、放入后哪些Buff生效，只取决于房间类型、产品类型与订单类型（Buff的作用范围验证器只检查这些属性），
+ * 每次求解按这三者各缓存一份筛选结果，由同类房间以及互斥组合的各轮枚举共享，不再对每个房间重复验证每个干员的每个Buff
+ */
+class RoomEligibilityIndex
+{
+  public:
+    struct Entry
+    {
+        Vector<model::OperatorModel *> operators; // 可放入该类房间的干员，顺序与建立时的干员列表相同
+        HashDictionary<const model::OperatorModel *, BitSet<model::buff::kOperatorMaxBuffs>> enabled_buffs; // 在该类房间中生效的Buff
+    };
+
+    // 该类房间首次查询时由 operators 建立条目
+    const Entry &Acquire(const Vector<model::OperatorModel *> &operators, const model::buff::RoomModel *room);
+
+    // 尚未建立条目时返回空指针
+    [[nodiscard]] const Entry *Find(const model::buff::RoomModel *room) const;
+
+    // 从所有条目中剔除已被安排的干员
+    void Remove(const model::OperatorModel *op);
+
+    [[nodiscard]] static BitSet<model::buff::kOperatorMaxBuffs> GetEnabledBuffs(const model::OperatorModel *op,
+                                                                               const model::buff::RoomModel *room);
+
+  private:
+    mem::PtrHashDictionary<UInt64, Entry> entries_;
+
+    [[nodiscard]] static UInt64 MakeKey(const model::buff::RoomModel *room);
+};
+
 /**
  *
  * @brief The Algorithm class
@@ -17,25 +56,32 @@ class IAlgorithm
   public:
     virtual ~IAlgorithm() = default;
 
-    IAlgorithm(const Vector<model::buff::RoomModel *> &rooms, const mem::PtrVector<model::OperatorModel> &operators,
-              const AlbcSolverParameters &params)
-        : rooms_(rooms), all_ops_(mem::unwrap_ptr_vector(operators)), params_(params)
+    // arena 为本次求解的分配区域（见 AlgorithmParams::GetArena()），组合解与约束矩阵在其中分配
+    IAlgorithm(const Vector<model::buff::RoomModel *> &rooms, const Vector<model::OperatorModel *> &operators,
+              const AlbcSolverParameters &params, mem::Arena &arena)
+        : rooms_(rooms), all_ops_(operators), params_(params), arena_(arena)
     {
     }
 
-    IAlgorithm(const mem::PtrVector<model::buff::RoomModel> &rooms, const mem::PtrVector<model::OperatorModel> &operators,
-              const AlbcSolverParameters &params)
-        : IAlgorithm(mem::unwrap_ptr_vector(rooms), operators, params)
+    virtual void Run(AlgorithmResult &result) = 0; // 实现算法
+
+    // 设置取消令牌，算法在枚举和求解时轮询，令牌需在Run期间保持有效
+    void SetCancelToken(const util::CancelToken *token)
     {
+        cancel_token_ = token;
     }
 
-    virtual void Run(AlgorithmResult &result) = 0; // 实现算法
-
   protected:
     Vector<model::buff::RoomModel *> rooms_;
     Vector<model::OperatorModel *> all_ops_;
     Vector<model::OperatorModel *> inbound_ops_;
     AlbcSolverParameters params_;
+    mem::Arena &arena_;
+    const util::CancelToken *cancel_token_ = nullptr;
+    RoomEligibilityIndex eligibility_index_;
+
+    // 每枚举这么多个组合检查一次取消令牌，避免频繁读取时钟
+    static constexpr UInt32 kCancelCheckInterval = 4096;
 
     void FilterOperators(const model::buff::RoomModel *room);
 
@@ -163,15 +209,41 @@ class MultiRoomIntegerProgramming : public CombMaker
         }
     };
 
-    static void GenSolDetails(const Vector<model::buff::RoomModel *> &rooms, const Vector<Vector<SolutionData>> &room_solutions,
+    static void GenSolDetails(const Vector<model::buff::RoomModel *> &rooms, const Vector<SolutionVector> &room_solutions,
                               Vector<UInt32> &room_ranges, size_t col_cnt);
 
-    void GenLpFile(Vector<Vector<SolutionData>> &room_solutions, const Vector<double> &obj,
-                   UInt32 row_cnt, UInt32 col_cnt, const Vector<double> &elems,
-                   const Vector<int> &row_indices, Vector<int> &col_indices,
-                   const RowRangeMap& ranges, const Vector<double> &row_ub) const;
-
-    void GenCombForRooms(Vector<Vector<SolutionData>> &room_solutions, Vector<UInt32> &room_ranges, UInt32 &col_cnt);
+    void GenLpFile(Vector<SolutionVector> &room_solutions, const mem::ArenaVector<double> &obj,
+                   UInt32 row_cnt, UInt32 col_cnt, const mem::ArenaVector<double> &elems,
+                   const mem::ArenaVector<int> &row_indices, mem::ArenaVector<int> &col_indices,
+                   const RowRangeMap& ranges, const mem::ArenaVector<double> &row_ub) const;
+
+    void GenCombForRooms(Vector<SolutionVector> &room_solutions, Vector<UInt32> &room_ranges, UInt32 &col_cnt,
+                         SolveStats &stats);
+
+    // 设置并求解模型，返回耗时（秒）。out_root_basis 非空时保存根节点 LP 的基，供之后的求解热启动
+    double SolveCbcModel(CbcModel &model, CoinMessageHandler *handler, double max_seconds,
+                         std::unique_ptr<CoinWarmStart> *out_root_basis) const;
+
+    /**
+     * 在已载入最优方案模型的 solver 上求出备选方案，组合与约束矩阵不再重新构建：
+     * 排除方案将对应干员行的上界临时置为0后重新求解；
+     * 次优方案每次追加一行稀疏的 no-good 割 Σ(x_c, c∈S) <= |S| - 1 排除上一个方案 S 及其超集，割保留在模型中。
+     * 列的权重均为正，S 的可行超集目标值更高，若存在则早于 S 被求出或已被更早的割排除，
+     * 因此排除超集不会跳过任何方案，依次得到的仍是按目标值排列的方案。
+     * Cbc 无法在改动约束后沿用上一次的分支定界树，因此每个方案都新建 CbcModel 重新分支定界，
+     * 只从上一次求解的根节点基热启动，总耗时与最优方案共享 solve_time_limit。
+     * 超时时保留已找到的可行解，标记为非最优（AlternativePlan::optimal）
+     */
+    void SolveAlternativePlans(OsiClpSolverInterface &solver, CoinMessageHandler *handler,
+                               std::unique_ptr<CoinWarmStart> &basis, const Vector<UInt32> &best_cols,
+                               const Vector<UInt32> &op_inst_id_to_op_row_map,
+                               const Vector<SolutionVector> &room_solutions, const Vector<UInt32> &room_ranges,
+                               AlgorithmResult &out_result) const;
+
+    void CollectRooms(const Vector<UInt32> &cols, const Vector<SolutionVector> &room_solutions,
+                      const Vector<UInt32> &room_ranges, Vector<RoomResult> &out_rooms) const;
+
+    [[nodiscard]] static Vector<UInt32> GetSelectedCols(const double *solution, UInt32 col_cnt);
 
     [[nodiscard]] static UInt32 GetRoomIdx(UInt32 col, const Vector<UInt32> &room_ranges) ;
 
@@ -6,7 +6,12 @@
 #include "data_player.h"
 #include "util_time.h"
 #include "algorithm_iface_params.h"
+#include "algorithm_iface_runner.h"
+#include <atomic>
+#include <cmath>
 #include <future>
+#include <iomanip>
+#include <numeric>
 namespace albc::algorithm::iface
 {
 void launch_test(const Json::Value &player_data_json, const Json::Value &game_data_json,
@@ -31,80 +36,114 @@ void launch_test(const Json::Value &player_data_json, const Json::Value &game_da
     }
 }
 
-void test_once(const Json::Value &player_data_json, const Json::Value &game_data_json,
-               const AlbcTestConfig &test_config)
+namespace
+{
+struct TestData
 {
     std::shared_ptr<data::building::BuildingData> building_data;
     std::shared_ptr<data::player::PlayerDataModel> player_data;
+};
 
-    const auto orig_log_level = util::GlobalLogConfig::GetLogLevel();
-    util::make_defer([orig_log_level]() { util::GlobalLogConfig::SetLogLevel(orig_log_level); });
-    util::GlobalLogConfig::SetLogLevel(static_cast<util::LogLevel>(test_config.base_parameters.level));
-
-    const auto buff_map = model::buff::BuffMap::instance();
-
+TestData ParseTestData(const Json::Value &player_data_json, const Json::Value &game_data_json,
+                       const AlbcTestConfig &test_config)
+{
+    TestData data;
+    auto sc = SCOPE_TIMER_WITH_TRACE("Data feeding");
+    LOG_I("Parsing building json object.");
+    try
     {
-        auto sc = SCOPE_TIMER_WITH_TRACE("Data feeding");
-        LOG_I("Parsing building json object.");
-        try
-        {
-            building_data = std::make_shared<data::building::BuildingData>(game_data_json);
-            LOG_I("Loaded ", building_data->chars.size(), " building character definitions.");
-            LOG_I("Loaded ", building_data->buffs.size(), " building buff definitions.");
-        }
-        catch (const std::exception &e)
-        {
-            LOG_E("Error: Unable to parse game building data json object: ", e.what());
-            throw;
-        }
+        data.building_data = std::make_shared<data::building::BuildingData>(game_data_json);
+        LOG_I("Loaded ", data.building_data->chars.size(), " building character definitions.");
+        LOG_I("Loaded ", data.building_data->buffs.size(), " building buff definitions.");
+    }
+    catch (const std::exception &e)
+    {
+        LOG_E("Error: Unable to parse game building data json object: ", e.what());
+        throw;
+    }
 
-        int unsupported_buff_cnt = 0;
-        for (const auto &[buff_id, buff] : building_data->buffs)
+    int unsupported_buff_cnt = 0;
+    for (const auto &[buff_id, buff] : data.building_data->buffs)
+    {
+        if (!model::buff::BuffMap::Contains(buff_id))
         {
-            if (buff_map->count(buff_id) <= 0)
+            if (test_config.show_all_ops)
             {
-                if (test_config.show_all_ops)
-                {
-                    util::VariantPut(std::cout, "\"", buff->buff_id, "\": ", buff->buff_name, ": ",
-                               xml::strip_xml_tags(buff->description));
-                }
-                ++unsupported_buff_cnt;
+                util::VariantPut(std::cout, "\"", buff->buff_id, "\": ", buff->buff_name, ": ",
+                           xml::strip_xml_tags(buff->description));
             }
+            ++unsupported_buff_cnt;
         }
-        if (!test_config.show_all_ops)
-        {
-            LOG_D(unsupported_buff_cnt,
-                  R"( unsupported buff found in building data buff definitions. Add "--all-ops" param to check all.)");
-        }
+    }
+    if (!test_config.show_all_ops)
+    {
+        LOG_D(unsupported_buff_cnt,
+              R"( unsupported buff found in building data buff definitions. Add "--all-ops" param to check all.)");
+    }
 
-        LOG_I("Parsing player json object.");
-        try
-        {
-            player_data = std::make_shared<data::player::PlayerDataModel>(player_data_json);
-            LOG_I("Added ", player_data->troop.chars.size(), " existing character instance");
-            LOG_I("Added ", player_data->building.player_building_room.manufacture.size(), " factories.");
-            LOG_I("Added ", player_data->building.player_building_room.trading.size(), " trading posts.");
-            LOG_I("Player building data parsing completed.");
-        }
-        catch (std::exception &e)
-        {
-            LOG_E("Error: Unable to parse player data json object: ", e.what());
-            throw;
-        }
+    LOG_I("Parsing player json object.");
+    try
+    {
+        data.player_data = std::make_shared<data::player::PlayerDataModel>(player_data_json);
+        LOG_I("Added ", data.player_data->troop.chars.size(), " existing character instance");
+        LOG_I("Added ", data.player_data->building.player_building_room.manufacture.size(), " factories.");
+        LOG_I("Added ", data.player_data->building.player_building_room.trading.size(), " trading posts.");
+        LOG_I("Player building data parsing completed.");
     }
+    catch (std::exception &e)
+    {
+        LOG_E("Error: Unable to parse player data json object: ", e.what());
+        throw;
+    }
+    return data;
+}
+
+// 压测中一次请求的结果
+struct LoadTestSample
+{
+    double latency = 0; // 挂钟耗时，秒
+    AlbcSolveStats totals{};
+};
+
+// 输出一行耗时分布，values 的单位为秒
+void PutLatencyRow(std::ostream &os, const char *name, Vector<double> values)
+{
+    std::sort(values.begin(), values.end());
+    const auto percentile = [&values](double p) {
+        // 最近秩法
+        const auto rank = static_cast<size_t>(std::ceil(p * static_cast<double>(values.size())));
+        return values[std::clamp<size_t>(rank, 1, values.size()) - 1] * 1000.;
+    };
+    const double mean = std::accumulate(values.begin(), values.end(), 0.) / static_cast<double>(values.size());
+
+    os << "  " << std::left << std::setw(12) << name << std::right << std::fixed << std::setprecision(3)
+       << std::setw(12) << mean * 1000. << std::setw(12) << percentile(.50) << std::setw(12) << percentile(.95)
+       << std::setw(12) << percentile(.99) << std::setw(12) << values.back() * 1000. << '\n';
+}
+} // namespace
+
+void test_once(const Json::Value &player_data_json, const Json::Value &game_data_json,
+               const AlbcTestConfig &test_config)
+{
+    const auto orig_log_level = util::GlobalLogConfig::GetLogLevel();
+    const auto restore_log_level =
+        util::make_defer([orig_log_level]() { util::GlobalLogConfig::SetLogLevel(orig_log_level); });
+    util::GlobalLogConfig::SetLogLevel(static_cast<util::LogLevel>(test_config.base_parameters.level));
+
+    const auto [building_data, player_data] = ParseTestData(player_data_json, game_data_json, test_config);
 
     GenTestModePlayerData(*player_data, *building_data);
     AlgorithmParams params(*player_data, *building_data);
     const auto sc = SCOPE_TIMER_WITH_TRACE("Solving");
     Vector<model::buff::RoomModel *> all_rooms;
-    const auto &manu_rooms = mem::unwrap_ptr_vector(params.GetRoomsOfType(data::building::RoomType::MANUFACTURE));
-    const auto &trade_rooms = mem::unwrap_ptr_vector(params.GetRoomsOfType(data::building::RoomType::TRADING));
+    const auto &manu_rooms = params.GetRoomsOfType(data::building::RoomType::MANUFACTURE);
+    const auto &trade_rooms = params.GetRoomsOfType(data::building::RoomType::TRADING);
 
     all_rooms.insert(all_rooms.end(), manu_rooms.begin(), manu_rooms.end());
     all_rooms.insert(all_rooms.end(), trade_rooms.begin(), trade_rooms.end());
 
     algorithm::MultiRoomIntegerProgramming alg_all(all_rooms, params.GetOperators(),
-                                        test_config.base_parameters.solver_parameters);
+                                        test_config.base_parameters.solver_parameters, params.GetArena());
 
     algorithm::AlgorithmResult result;
     alg_all.Run(result);
@@ -115,19 +154,90 @@ void run_parallel_test(const Json::Value &player_data_json, const Json::Value &g
 {
     const auto sc = SCOPE_TIMER_WITH_TRACE("Parallel test");
 
-    LOG_I("Running parallel test for ", test_config.param, " concurrency");
+    const auto orig_log_level = util::GlobalLogConfig::GetLogLevel();
+    const auto restore_log_level =
+        util::make_defer([orig_log_level]() { util::GlobalLogConfig::SetLogLevel(orig_log_level); });
+    util::GlobalLogConfig::SetLogLevel(static_cast<util::LogLevel>(test_config.base_parameters.level));
+
+    // 数据只解析一次，各请求共享只读的游戏数据与玩家数据，每个请求只包含建模与求解
+    const auto data = ParseTestData(player_data_json, game_data_json, test_config);
+    GenTestModePlayerData(*data.player_data, *data.building_data);
 
-    Vector<std::future<void>> futures;
-    for (int i = 0; i < test_config.param; ++i)
+    const int concurrency = std::max(1, test_config.param);
+    const bool timed = test_config.duration > 0;
+    const Int64 max_requests = test_config.requests > 0 ? test_config.requests : concurrency;
+    if (timed)
+        LOG_I("Running load test for ", test_config.duration, "s at ", concurrency, " concurrency");
+    else
+        LOG_I("Running load test for ", max_requests, " requests at ", concurrency, " concurrency");
+
+    const auto start_time = util::PerfClock::now();
+    const auto deadline =
+        start_time + std::chrono::duration_cast<util::PerfClock::duration>(util::FloatingSeconds(test_config.duration));
+    std::atomic<Int64> issued = 0;
+    std::atomic<Int64> failed = 0;
+    const MultiRoomIntegerProgramRunner runner;
+
+    const auto worker = [&] {
+        Vector<LoadTestSample> samples;
+        while (timed ? util::PerfClock::now() < deadline : issued.fetch_add(1, std::memory_order_relaxed) < max_requests)
+        {
+            const auto t0 = util::PerfClock::now();
+            try
+            {
+                const AlgorithmParams params(*data.player_data, *data.building_data);
+                AlgorithmResult result;
+                runner.Run(params, test_config.base_parameters.solver_parameters, result);
+                samples.push_back({util::FloatingSeconds(util::PerfClock::now() - t0).count(), result.stats.totals});
+            }
+            catch (const std::exception &e)
+            {
+                failed.fetch_add(1, std::memory_order_relaxed);
+                LOG_E("Load test request failed: ", e.what());
+            }
+        }
+        return samples;
+    };
+
+    Vector<std::future<Vector<LoadTestSample>>> futures;
+    for (int i = 0; i < concurrency; ++i)
     {
-        futures.push_back(std::async(std::launch::async, test_once, player_data_json, game_data_json, test_config));
+        futures.push_back(std::async(std::launch::async, worker));
     }
 
-    // wait for all threads to finish
+    Vector<LoadTestSample> samples;
     for (auto &f : futures)
     {
-        f.wait();
+        auto worker_samples = f.get();
+        samples.insert(samples.end(), worker_samples.begin(), worker_samples.end());
+    }
+    const double elapsed = util::FloatingSeconds(util::PerfClock::now() - start_time).count();
+
+    std::ostringstream report;
+    report << "Load test: concurrency " << concurrency << ", " << samples.size() << " requests ("
+           << failed.load() << " failed) in " << std::fixed << std::setprecision(3) << elapsed << "s, "
+           << static_cast<double>(samples.size()) / elapsed << " requests/s\n";
+    if (!samples.empty())
+    {
+        const auto column = [&samples](auto field) {
+            Vector<double> values;
+            values.reserve(samples.size());
+            for (const auto &sample : samples)
+                values.push_back(field(sample));
+            return values;
+        };
+
+        report << "  " << std::left << std::setw(12) << "phase (ms)" << std::right << std::setw(12) << "mean"
+               << std::setw(12) << "p50" << std::setw(12) << "p95" << std::setw(12) << "p99" << std::setw(12)
+               << "max" << '\n';
+        PutLatencyRow(report, "latency", column([](const LoadTestSample &s) { return s.latency; }));
+        PutLatencyRow(report, "data_feed", column([](const LoadTestSample &s) { return s.totals.data_feed_time; }));
+        PutLatencyRow(report, "filter", column([](const LoadTestSample &s) { return s.totals.filter_time; }));
+        PutLatencyRow(report, "enum", column([](const LoadTestSample &s) { return s.totals.enum_time; }));
+        PutLatencyRow(report, "solve", column([](const LoadTestSample &s) { return s.totals.solve_time; }));
+        PutLatencyRow(report, "total", column([](const LoadTestSample &s) { return s.totals.total_time; }));
     }
+    std::cout << report.str() << std::flush;
 
     LOG_I("Parallel test completed.");
 }
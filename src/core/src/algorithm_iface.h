@@ -23,6 +23,8 @@ void launch_test(const Json::Value &player_data_json, const Json::Value &game_da
 void test_once(const Json::Value &player_data_json, const Json::Value &game_data_json, 
     const AlbcTestConfig& test_config);
 
+// 压测：以 param 个并发持续发起建模与求解请求，直到达到 duration 秒或 requests 个请求，
+// 输出吞吐量与延迟及各阶段耗时的分布。游戏数据与玩家数据只解析一次
 void run_parallel_test(const Json::Value &player_data_json, const Json::Value &game_data_json, 
     const AlbcTestConfig& test_config);
 
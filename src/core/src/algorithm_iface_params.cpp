@@ -2,6 +2,8 @@
 // Created by Nonary on 2022/4/24.
 //
 #include "algorithm_iface_params.h"
+#include "model_buff_map.h"
+#include "util_time.h"
 #include <unordered_set>
 
 namespace albc::algorithm::iface
@@ -55,11 +57,10 @@ model::buff::GlobalAttributeFields GlobalAttributeFactory(const data::player::Pl
 
     return attr;
 }
-std::unique_ptr<model::buff::RoomModel> RoomFactory(const std::string &id,
-                                                    const data::player::PlayerBuildingManufacture &manufacture_room,
-                                                    int level)
+model::buff::RoomModel *RoomFactory(mem::Arena &arena, const std::string &id,
+                                    const data::player::PlayerBuildingManufacture &manufacture_room, int level)
 {
-    auto room = std::make_unique<model::buff::RoomModel>();
+    auto *room = arena.New<model::buff::RoomModel>();
     room->type = data::building::RoomType::MANUFACTURE;
     room->id = id;
     room->max_slot_count = level;
@@ -91,10 +92,10 @@ std::unique_ptr<model::buff::RoomModel> RoomFactory(const std::string &id,
 
     return room;
 }
-std::unique_ptr<model::buff::RoomModel> RoomFactory(const std::string &id,
-                                                    const data::player::PlayerBuildingTrading &trading_room, int level)
+model::buff::RoomModel *RoomFactory(mem::Arena &arena, const std::string &id,
+                                    const data::player::PlayerBuildingTrading &trading_room, int level)
 {
-    auto room = std::make_unique<model::buff::RoomModel>();
+    auto *room = arena.New<model::buff::RoomModel>();
     room->type = data::building::RoomType::TRADING;
     room->id = id;
     room->max_slot_count = level;
@@ -106,9 +107,9 @@ std::unique_ptr<model::buff::RoomModel> RoomFactory(const std::string &id,
 
     return room;
 }
-std::unique_ptr<model::buff::RoomModel> RoomFactory(const CustomRoomData &room_data)
+model::buff::RoomModel *RoomFactory(mem::Arena &arena, const CustomRoomData &room_data)
 {
-    auto room = std::make_unique<model::buff::RoomModel>();
+    auto *room = arena.New<model::buff::RoomModel>();
     room->type = room_data.type;
     room->id = room_data.identifier;
     room->max_slot_count = room_data.max_slot_cnt;
@@ -154,27 +155,33 @@ void GenTestModePlayerData(data::player::PlayerDataModel &player_data,
 AlgorithmParams::AlgorithmParams(const data::player::PlayerDataModel &player_data,
                                  const data::building::BuildingData &building_data)
 {
+    const auto start_time = util::PerfClock::now();
+    const mem::MemPhaseScope data_feed_scope(memory_stats_[mem::MemPhase::DATA_FEED]);
     data::player::PlayerTroopLookup lookup(player_data.troop);
+    model::buff::RoomBuffMetaCache buff_meta(building_data);
 
-    for (const auto &[inst_id, player_char] : player_data.troop.chars)
     {
-        if (player_data.building.chars.count(inst_id) <= 0)
+        const mem::MemPhaseScope op_build_scope(memory_stats_[mem::MemPhase::OPERATOR_BUILD]);
+        for (const auto &[inst_id, player_char] : player_data.troop.chars)
         {
-            LOG_E("Unable to find troop character in building characters! : ", player_char->char_id);
-            continue;
-        }
-        if (building_data.chars.count(player_char->char_id) <= 0)
-        {
-            LOG_E("Unable to find building data definition for character with given ID! Is building data "
-                  "outdated? : ",
-                  player_char->char_id);
-            continue;
-        }
+            if (player_data.building.chars.count(inst_id) <= 0)
+            {
+                LOG_E("Unable to find troop character in building characters! : ", player_char->char_id);
+                continue;
+            }
+            if (building_data.chars.count(player_char->char_id) <= 0)
+            {
+                LOG_E("Unable to find building data definition for character with given ID! Is building data "
+                      "outdated? : ",
+                      player_char->char_id);
+                continue;
+            }
 
-        const auto op = new model::OperatorModel(*player_char, *player_data.building.chars.at(inst_id));
-        op->identifier = player_char->char_id;
-        op->Empower(lookup, *player_char, building_data);
-        operators_.emplace_back(op);
+            const auto op = arena_->New<model::OperatorModel>(*player_char, *player_data.building.chars.at(inst_id));
+            op->identifier = player_char->char_id;
+            op->Empower(lookup, *player_char, buff_meta, *arena_);
+            operators_.push_back(op);
+        }
     }
 
     Dictionary<std::string, int> room_level_map;
@@ -187,24 +194,29 @@ AlgorithmParams::AlgorithmParams(const data::player::PlayerDataModel &player_dat
 
     for (const auto &[id, manu_room] : player_data.building.player_building_room.manufacture)
     {
-        auto room = RoomFactory(id, manu_room, room_level_map[id]);
+        auto *room = RoomFactory(*arena_, id, manu_room, room_level_map[id]);
         room->global_attributes = global_attr;
-        AddRoom(data::building::RoomType::MANUFACTURE, std::move(room));
+        AddRoom(data::building::RoomType::MANUFACTURE, room);
     }
 
     for (const auto &[id, trade_room] : player_data.building.player_building_room.trading)
     {
-        auto room = RoomFactory(id, trade_room, room_level_map[id]);
+        auto *room = RoomFactory(*arena_, id, trade_room, room_level_map[id]);
         room->global_attributes = global_attr;
-        AddRoom(data::building::RoomType::TRADING, std::move(room));
+        AddRoom(data::building::RoomType::TRADING, room);
     }
+
+    build_time_ = util::FloatingSeconds(util::PerfClock::now() - start_time).count();
 }
 AlgorithmParams::AlgorithmParams(const CustomPackedInput &custom_input,
                                  const data::building::BuildingData &building_data)
 {
+    const auto start_time = util::PerfClock::now();
+    const mem::MemPhaseScope data_feed_scope(memory_stats_[mem::MemPhase::DATA_FEED]);
     Vector<std::pair<int, std::string>> char_ids;
     // 只添加基本信息和PlayerTroopLookup所需信息
     {
+        const mem::MemPhaseScope op_build_scope(memory_stats_[mem::MemPhase::OPERATOR_BUILD]);
         UInt32 inst_id_counter = 0;
         for (const auto &custom_char : custom_input.characters)
         {
@@ -214,54 +226,60 @@ AlgorithmParams::AlgorithmParams(const CustomPackedInput &custom_input,
             else
                 char_ids.emplace_back(inst_id_counter, "CUSTOM_CHAR_" + std::to_string(inst_id_counter));
 
-            auto op = std::make_unique<model::OperatorModel>(inst_id_counter, custom_char.resolved_char_id,
-                                                             static_cast<UInt32>(3600. * custom_char.morale));
+            auto *op = arena_->New<model::OperatorModel>(inst_id_counter, custom_char.resolved_char_id,
+                                                         static_cast<UInt32>(3600. * custom_char.morale));
             op->identifier = custom_char.identifier;
-            op->sp_char_group = custom_char.sp_char_group;
-            operators_.emplace_back(std::move(op));
+            op->sp_char_group = util::Atom::Find(custom_char.sp_char_group);
+            operators_.push_back(op);
         }
     }
 
     data::player::PlayerTroopLookup lookup(char_ids);
+    model::buff::RoomBuffMetaCache buff_meta(building_data);
 
     // 添加干员Buff
-    for (UInt32 i = 0; i < custom_input.characters.size(); ++i)
     {
-        const auto &custom_char = custom_input.characters[i];
-        const auto &op = operators_[i];
-        const auto &[inst_id, char_id] = char_ids[i];
-        if (custom_char.is_regular_character)
+        const mem::MemPhaseScope op_build_scope(memory_stats_[mem::MemPhase::OPERATOR_BUILD]);
+        for (UInt32 i = 0; i < custom_input.characters.size(); ++i)
         {
-            data::player::PlayerCharacter player_char;
-            player_char.inst_id = inst_id;
-            player_char.char_id = char_id;
-            player_char.level = custom_char.level;
-            player_char.evolve_phase = custom_char.phase;
+            const auto &custom_char = custom_input.characters[i];
+            const auto &op = operators_[i];
+            const auto &[inst_id, char_id] = char_ids[i];
+            if (custom_char.is_regular_character)
+            {
+                data::player::PlayerCharacter player_char;
+                player_char.inst_id = inst_id;
+                player_char.char_id = char_id;
+                player_char.level = custom_char.level;
+                player_char.evolve_phase = custom_char.phase;
 
-            op->Empower(lookup, player_char, building_data);
-        }
-        else
-        {
-            for (const auto &buff_id : custom_char.resolved_skill_ids)
+                op->Empower(lookup, player_char, buff_meta, *arena_);
+            }
+            else
             {
-                if (!op->AddBuff(lookup, building_data, buff_id))
-                    LOG_W("Unable to add buff to operator! : ", buff_id, " Operator ID : ", custom_char.identifier);
+                for (const auto &buff_id : custom_char.resolved_skill_ids)
+                {
+                    if (!op->AddBuff(lookup, buff_meta, *arena_, buff_id))
+                        LOG_W("Unable to add buff to operator! : ", buff_id, " Operator ID : ", custom_char.identifier);
+                }
+                op->ResolvePatches();
             }
-            op->ResolvePatches();
-        }
 
-        if (op->buffs.empty())
-        {
-            LOG_W("Operator has no buffs! : ", custom_char.identifier);
+            if (op->buffs.empty())
+            {
+                LOG_W("Operator has no buffs! : ", custom_char.identifier);
+            }
         }
     }
 
     for (const auto &custom_room : custom_input.rooms)
     {
-        auto room = RoomFactory(custom_room);
+        auto *room = RoomFactory(*arena_, custom_room);
         room->global_attributes = custom_input.global_data.global_attributes;
-        AddRoom(custom_room.type, std::move(room));
+        AddRoom(custom_room.type, room);
     }
+
+    build_time_ = util::FloatingSeconds(util::PerfClock::now() - start_time).count();
 }
 void AlgorithmParams::UpdateGlobalAttributes(const model::buff::GlobalAttributeFields &global_attr) const
 {
@@ -269,7 +287,7 @@ void AlgorithmParams::UpdateGlobalAttributes(const model::buff::GlobalAttributeF
         for (const auto &room : rooms)
             room->global_attributes = global_attr;
 }
-const mem::PtrVector<model::buff::RoomModel> &AlgorithmParams::GetRoomsOfType(data::building::RoomType type) const
+const Vector<model::buff::RoomModel *> &AlgorithmParams::GetRoomsOfType(data::building::RoomType type) const
 {
     if (UInt32 type_val = static_cast<UInt32>(type), idx = util::ctz(type_val);
         util::is_pow_of_two(type_val) && idx > 0 && idx < static_cast<UInt32>(rooms_map_.size()))
@@ -286,8 +304,8 @@ int AlgorithmParams::GetRoomTypeIndex(const data::building::RoomType type)
 {
     return util::ctz(static_cast<UInt32>(type));
 }
-void AlgorithmParams::AddRoom(const data::building::RoomType type, std::unique_ptr<model::buff::RoomModel> &&room)
+void AlgorithmParams::AddRoom(const data::building::RoomType type, model::buff::RoomModel *room)
 {
-    rooms_map_[GetRoomTypeIndex(type)].emplace_back(std::move(room));
+    rooms_map_[GetRoomTypeIndex(type)].push_back(room);
 }
 }
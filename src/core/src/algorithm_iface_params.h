@@ -14,22 +14,24 @@
 namespace albc::algorithm::iface
 {
 
-using PlayerBuildingRoomMap = Array<mem::PtrVector<model::buff::RoomModel>, data::building::kRoomTypeCount>;
+using PlayerBuildingRoomMap = Array<Vector<model::buff::RoomModel *>, data::building::kRoomTypeCount>;
 
 model::buff::GlobalAttributeFields GlobalAttributeFactory(const data::player::PlayerBuilding &building);
 
-std::unique_ptr<model::buff::RoomModel> RoomFactory(
-    const std::string &id, const data::player::PlayerBuildingManufacture &manufacture_room, int level);
+// 房间模型在 arena 中分配，随 arena 一并销毁
+model::buff::RoomModel *RoomFactory(mem::Arena &arena, const std::string &id,
+                                    const data::player::PlayerBuildingManufacture &manufacture_room, int level);
 
-std::unique_ptr<model::buff::RoomModel> RoomFactory(const std::string &id,
-                                                           const data::player::PlayerBuildingTrading &trading_room,
-                                                           int level);
+model::buff::RoomModel *RoomFactory(mem::Arena &arena, const std::string &id,
+                                    const data::player::PlayerBuildingTrading &trading_room, int level);
 
-std::unique_ptr<model::buff::RoomModel> RoomFactory(const CustomRoomData &room_data);
+model::buff::RoomModel *RoomFactory(mem::Arena &arena, const CustomRoomData &room_data);
 
 [[maybe_unused]] void GenTestModePlayerData(data::player::PlayerDataModel &player_data,
                                                    const data::building::BuildingData &building_data);
 
+// 一次求解的全部输入。干员、Buff实例与房间模型都分配在自身持有的 arena 中，
+// 求解过程中的组合解与约束矩阵也使用同一个 arena（见 GetArena()），求解结束后随本对象一次释放
 class AlgorithmParams
 {
   public:
@@ -39,19 +41,40 @@ class AlgorithmParams
 
     [[maybe_unused]] void UpdateGlobalAttributes(const model::buff::GlobalAttributeFields &global_attr) const;
 
-    [[nodiscard]] const mem::PtrVector<model::buff::RoomModel> &GetRoomsOfType(data::building::RoomType type) const;
+    [[nodiscard]] const Vector<model::buff::RoomModel *> &GetRoomsOfType(data::building::RoomType type) const;
 
-    [[nodiscard]] const mem::PtrVector<model::OperatorModel> &GetOperators() const
+    [[nodiscard]] const Vector<model::OperatorModel *> &GetOperators() const
     {
         return operators_;
     }
 
+    // 本次求解的 arena，非线程安全，同一时刻只能有一个求解使用
+    [[nodiscard]] mem::Arena &GetArena() const
+    {
+        return *arena_;
+    }
+
+    // 构建干员、Buff与房间模型的耗时，秒
+    [[nodiscard]] double GetBuildTime() const
+    {
+        return build_time_;
+    }
+
+    // 构建过程中 DATA_FEED 与 OPERATOR_BUILD 阶段的内存分配
+    [[nodiscard]] const mem::MemPhaseStats &GetMemoryStats() const
+    {
+        return memory_stats_;
+    }
+
   private:
+    std::unique_ptr<mem::Arena> arena_ = std::make_unique<mem::Arena>(); // 独立分配，移动本对象时地址不变
     PlayerBuildingRoomMap rooms_map_;
-    mem::PtrVector<model::OperatorModel> operators_;
+    Vector<model::OperatorModel *> operators_;
+    double build_time_ = 0;
+    mem::MemPhaseStats memory_stats_{};
 
     [[nodiscard]] static int GetRoomTypeIndex(data::building::RoomType type);
 
-    void AddRoom(data::building::RoomType type, std::unique_ptr<model::buff::RoomModel> &&room);
+    void AddRoom(data::building::RoomType type, model::buff::RoomModel *room);
 };
 } // namespace albc::algorithm::iface
\ No newline at end of file
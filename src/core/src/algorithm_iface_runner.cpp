@@ -7,12 +7,12 @@ namespace albc::algorithm::iface
 {
 
 void MultiRoomIntegerProgramRunner::Run(const AlgorithmParams &params, const AlbcSolverParameters &solver_params,
-                                        AlgorithmResult &out_result) const
+                                        AlgorithmResult &out_result, const util::CancelToken *cancel_token) const
 {
     using namespace algorithm;
     Vector<model::buff::RoomModel *> all_rooms;
-    const auto &manu_rooms = mem::unwrap_ptr_vector(params.GetRoomsOfType(data::building::RoomType::MANUFACTURE));
-    const auto &trade_rooms = mem::unwrap_ptr_vector(params.GetRoomsOfType(data::building::RoomType::TRADING));
+    const auto &manu_rooms = params.GetRoomsOfType(data::building::RoomType::MANUFACTURE);
+    const auto &trade_rooms = params.GetRoomsOfType(data::building::RoomType::TRADING);
     all_rooms.insert(all_rooms.end(), manu_rooms.begin(), manu_rooms.end());
     all_rooms.insert(all_rooms.end(), trade_rooms.begin(), trade_rooms.end());
 
@@ -20,13 +20,24 @@ void MultiRoomIntegerProgramRunner::Run(const AlgorithmParams &params, const Alb
     if (actual_solver_params.model_time_limit <= 0) actual_solver_params.model_time_limit = kDefaultModelTimeLimit;
     if (actual_solver_params.solve_time_limit <= 0) actual_solver_params.solve_time_limit = kDefaultSolveTimeLimit;
 
-    MultiRoomIntegerProgramming alg_all(all_rooms, params.GetOperators(), actual_solver_params);
-    alg_all.Run(out_result);
+    MultiRoomIntegerProgramming alg_all(all_rooms, params.GetOperators(), actual_solver_params, params.GetArena());
+    alg_all.SetCancelToken(cancel_token);
+    const double run_time = util::MeasureTime(&MultiRoomIntegerProgramming::Run, alg_all, out_result).count();
+
+    auto &totals = out_result.stats.totals;
+    totals.data_feed_time = params.GetBuildTime();
+    totals.total_time = totals.data_feed_time + run_time;
+    totals.peak_memory = params.GetArena().GetBytesReserved(); // 单调分配，结束时即为峰值
+
+    auto &memory = out_result.stats.memory;
+    for (const auto phase : {mem::MemPhase::DATA_FEED, mem::MemPhase::OPERATOR_BUILD})
+        memory[phase] = params.GetMemoryStats()[phase];
+    SolveStatsAggregator::Record(out_result.stats);
 }
 void TestRunner::Run(const AlgorithmParams &params, const AlbcSolverParameters &solver_params,
-                     AlgorithmResult &out_result) const
+                     AlgorithmResult &out_result, const util::CancelToken *cancel_token) const
 {
-    (void)params; (void)solver_params; (void)out_result;
+    (void)params; (void)solver_params; (void)out_result; (void)cancel_token;
     throw std::runtime_error("TestRunner is not implemented");
 }
 }
\ No newline at end of file
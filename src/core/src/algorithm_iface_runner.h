@@ -10,20 +10,24 @@ namespace albc::algorithm::iface
 class IRunner
 {
 public:
-    virtual void Run(const algorithm::iface::AlgorithmParams & params, const AlbcSolverParameters& solver_params, algorithm::AlgorithmResult& out_result) const = 0;
+    // cancel_token 可为空；非空时在求解过程中轮询，取消或超时将抛出 util::OperationCancelledException
+    virtual void Run(const algorithm::iface::AlgorithmParams & params, const AlbcSolverParameters& solver_params, algorithm::AlgorithmResult& out_result,
+                     const util::CancelToken* cancel_token = nullptr) const = 0;
 };
 
 class MultiRoomIntegerProgramRunner : public IRunner
 {
 public:
     MultiRoomIntegerProgramRunner() = default;
-    void Run(const algorithm::iface::AlgorithmParams & params, const AlbcSolverParameters& solver_params, algorithm::AlgorithmResult& out_result) const override;
+    void Run(const algorithm::iface::AlgorithmParams & params, const AlbcSolverParameters& solver_params, algorithm::AlgorithmResult& out_result,
+             const util::CancelToken* cancel_token = nullptr) const override;
 };
 
 class TestRunner : public IRunner
 {
 public:
     TestRunner() = default;
-    void Run(const algorithm::iface::AlgorithmParams & params, const AlbcSolverParameters& solver_params, algorithm::AlgorithmResult& out_result) const override;
+    void Run(const algorithm::iface::AlgorithmParams & params, const AlbcSolverParameters& solver_params, algorithm::AlgorithmResult& out_result,
+             const util::CancelToken* cancel_token = nullptr) const override;
 };
 }
\ No newline at end of file
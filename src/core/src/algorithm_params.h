@@ -1,6 +1,7 @@
 #pragma once
 #include "albc_types.h"
 #include "algorithm_primitives.h"
+#include "algorithm_stats.h"
 
 namespace albc::algorithm
 {
@@ -11,13 +12,29 @@ struct RoomResult
     model::buff::RoomModel* room = nullptr;
 };
 
+// 备选方案，见 AlbcSolverParameters::alt_plan_count 与 alt_exclusion_plans
+struct AlternativePlan
+{
+    Vector<RoomResult> rooms;
+    double objective = 0;
+    double solve_time = 0;
+    bool optimal = false;                           // 为 false 时是超时求解给出的可行解，不保证最优
+    const model::OperatorModel* excluded = nullptr; // 排除的干员，次优方案为空
+};
+
 struct AlgorithmResult
 {
     Vector<RoomResult> rooms;
+    Vector<AlternativePlan> alternatives; // 先为各干员的排除方案，再按目标值降序排列次优方案
+    Vector<Vector<RoomResult>> shifts;    // 多班次时各班次的方案，rooms 与第一班相同
+    SolveStats stats;
 
     void Clear()
     {
         rooms.clear();
+        alternatives.clear();
+        shifts.clear();
+        stats.Clear();
     }
 };
 
@@ -27,6 +27,10 @@ class SolutionData
 
     [[nodiscard]] std::string ToString() const;
 };
+
+// 一个房间的全部组合解，分配在本次求解的 arena 中
+using SolutionVector = mem::ArenaVector<SolutionData>;
+
 struct GreedySolutionHolder
 {
     SolutionData max_solution;
@@ -66,13 +70,17 @@ struct GreedySolutionHolder
 
 struct AllSolutionHolder
 {
-    Vector<SolutionData> solutions;
+    SolutionVector solutions;
     UInt32 calc_cnt = 0;
     size_t sol_cnt = 0;
 
+    explicit AllSolutionHolder(mem::Arena &arena) : solutions(mem::ArenaAllocator<SolutionData>(arena))
+    {
+    }
+
     void Reserve(size_t size)
     {
-        Vector<SolutionData> tmp(size);
+        SolutionVector tmp(size, solutions.get_allocator());
         solutions.swap(tmp);
         sol_cnt = 0;
     }
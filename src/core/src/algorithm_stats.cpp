@@ -0,0 +1,101 @@
+#include "algorithm_stats.h"
+
+#include <cstdio>
+#include <mutex>
+#include <string_view>
+
+namespace albc::algorithm
+{
+namespace
+{
+struct Accumulator
+{
+    double sum = 0;
+    double max = 0;
+
+    void Add(double value)
+    {
+        sum += value;
+        max = std::max(max, value);
+    }
+};
+
+struct AggregatedStats
+{
+    UInt64 solve_cnt = 0;
+    Accumulator data_feed_time;
+    Accumulator filter_time;
+    Accumulator enum_time;
+    Accumulator solve_time;
+    Accumulator total_time;
+    Accumulator calc_cnt;
+    Accumulator col_cnt;
+    Accumulator matrix_nnz;
+    Accumulator node_cnt;
+    Accumulator lp_iterations;
+    Accumulator peak_memory;
+    Array<Accumulator, mem::kMemPhaseCount> phase_peak_bytes{};
+};
+
+std::mutex g_mutex;
+AggregatedStats g_stats;
+
+// unit 为空时按计数输出整数
+std::string DescribeItem(std::string_view name, const Accumulator &acc, UInt64 cnt, const char *unit = "")
+{
+    const char *fmt = *unit ? "solve.%.*s: mean %.6g%s, max %.6g%s" : "solve.%.*s: mean %.0f%s, max %.0f%s";
+    char buf[160];
+    std::snprintf(buf, sizeof(buf), fmt, static_cast<int>(name.size()), name.data(),
+                  cnt ? acc.sum / static_cast<double>(cnt) : 0., unit, acc.max, unit);
+    return buf;
+}
+} // namespace
+
+void SolveStatsAggregator::Record(const SolveStats &stats)
+{
+    const auto &t = stats.totals;
+    std::lock_guard lock(g_mutex);
+    ++g_stats.solve_cnt;
+    g_stats.data_feed_time.Add(t.data_feed_time);
+    g_stats.filter_time.Add(t.filter_time);
+    g_stats.enum_time.Add(t.enum_time);
+    g_stats.solve_time.Add(t.solve_time);
+    g_stats.total_time.Add(t.total_time);
+    g_stats.calc_cnt.Add(static_cast<double>(t.calc_cnt));
+    g_stats.col_cnt.Add(t.col_cnt);
+    g_stats.matrix_nnz.Add(static_cast<double>(t.matrix_nnz));
+    g_stats.node_cnt.Add(t.node_cnt);
+    g_stats.lp_iterations.Add(t.lp_iterations);
+    g_stats.peak_memory.Add(static_cast<double>(t.peak_memory));
+    for (size_t i = 0; i < mem::kMemPhaseCount; ++i)
+        g_stats.phase_peak_bytes[i].Add(static_cast<double>(stats.memory[i].peak_bytes));
+}
+
+Vector<std::string> SolveStatsAggregator::Describe()
+{
+    AggregatedStats s;
+    {
+        std::lock_guard lock(g_mutex);
+        s = g_stats;
+    }
+
+    Vector<std::string> lines;
+    lines.emplace_back("solve.count: " + std::to_string(s.solve_cnt));
+    lines.emplace_back(DescribeItem("data_feed_time", s.data_feed_time, s.solve_cnt, "s"));
+    lines.emplace_back(DescribeItem("filter_time", s.filter_time, s.solve_cnt, "s"));
+    lines.emplace_back(DescribeItem("enum_time", s.enum_time, s.solve_cnt, "s"));
+    lines.emplace_back(DescribeItem("solve_time", s.solve_time, s.solve_cnt, "s"));
+    lines.emplace_back(DescribeItem("total_time", s.total_time, s.solve_cnt, "s"));
+    lines.emplace_back(DescribeItem("calc_cnt", s.calc_cnt, s.solve_cnt));
+    lines.emplace_back(DescribeItem("col_cnt", s.col_cnt, s.solve_cnt));
+    lines.emplace_back(DescribeItem("matrix_nnz", s.matrix_nnz, s.solve_cnt));
+    lines.emplace_back(DescribeItem("node_cnt", s.node_cnt, s.solve_cnt));
+    lines.emplace_back(DescribeItem("lp_iterations", s.lp_iterations, s.solve_cnt));
+    lines.emplace_back(DescribeItem("peak_memory", s.peak_memory, s.solve_cnt));
+    for (size_t i = 0; i < mem::kMemPhaseCount; ++i)
+        lines.emplace_back(DescribeItem(std::string("memory.") + mem::GetMemPhaseName(static_cast<mem::MemPhase>(i)) +
+                                            ".peak_bytes",
+                                        s.phase_peak_bytes[i], s.solve_cnt));
+    return lines;
+}
+} // namespace albc::algorithm
@@ -0,0 +1,44 @@
+#pragma once
+#include "albc/albc_common.h"
+#include "albc_types.h"
+#include "util_mem.h"
+
+namespace albc::algorithm
+{
+// 单个房间的枚举统计
+struct RoomSolveStats
+{
+    std::string room_id;
+    double filter_time = 0; // 筛选可用干员的耗时，秒
+    double enum_time = 0;   // 枚举组合的耗时，秒
+    UInt32 inbound_ops = 0; // 筛选后可用的干员数
+    UInt64 calc_cnt = 0;    // 计算过的组合数
+    UInt32 col_cnt = 0;     // 产生的候选组合（列）数
+};
+
+// 一次求解的统计，汇总部分即公开API中的 AlbcSolveStats
+struct SolveStats
+{
+    AlbcSolveStats totals{};
+    Vector<RoomSolveStats> rooms;
+    mem::MemPhaseStats memory{}; // 各阶段的内存分配，见 mem::MemPhase
+
+    void Clear()
+    {
+        totals = AlbcSolveStats{};
+        totals.gap = -1;
+        rooms.clear();
+        memory = {};
+    }
+};
+
+// 进程内所有已完成求解的统计汇总，供 GetInfo 查询。线程安全
+class SolveStatsAggregator
+{
+  public:
+    static void Record(const SolveStats &stats);
+
+    // 每行一项，形如 "solve.enum_time: mean 0.012s, max 0.034s"
+    [[nodiscard]] static Vector<std::string> Describe();
+};
+} // namespace albc::algorithm
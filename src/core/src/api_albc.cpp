@@ -7,43 +7,37 @@
 #include "util_log.h"
 #include "util_mem.h"
 #include "util_time.h"
+#include "util_trace.h"
 #include "albc_types.h"
 #include "data_character_table.h"
 #include "api_json_params.h"
 #include "api_di.h"
+#include "api_capture.h"
+#include "api_flat_result.h"
+#include "api_synthetic.h"
+#include "util_mmap.h"
 
+#include <filesystem>
+#include <fstream>
 #include <memory>
 
 #pragma clang diagnostic push
 #pragma ide diagnostic ignored "OCUnusedGlobalDeclarationInspection"
 
-//#define ALBC_MEMORY_DEBUG_ENABLED
-
 namespace albc
     ALBC_PUBLIC_NAMESPACE
 {
 ALBC_API void * malloc(std::size_t size) noexcept
 {
-    auto ret = std::malloc(size);
-#ifdef ALBC_MEMORY_DEBUG_ENABLED
-    LOG_D("malloc(", size, ") = ", ret);
-#endif
-    return ret;
+    return mem::AccountedMalloc(size);
 }
 ALBC_API void free(void *ptr) noexcept
 {
-    std::free(ptr);
-#ifdef ALBC_MEMORY_DEBUG_ENABLED
-    LOG_D("free(", ptr, ")");
-#endif
+    mem::AccountedFree(ptr);
 }
 ALBC_API void *realloc(void *ptr, std::size_t size) noexcept
 {
-    auto ret = std::realloc(ptr, size);
-#ifdef ALBC_MEMORY_DEBUG_ENABLED
-    LOG_D("realloc(", ptr, ", ", size, ") = ", ret);
-#endif
-    return ret;
+    return mem::AccountedRealloc(ptr, size);
 }
 ALBC_API_MEMBER String::String() noexcept
 {
@@ -149,7 +143,7 @@ ALBC_API void FlushLog(AlbcException **e_ptr) noexcept
 {
     try
     {
-        util::SingletonLogger::instance()->Flush();
+        util::AsyncLogger::instance().Flush();
     }
     ALBC_API_CATCH_AND_TRANSLATE_EXCEPTION(e_ptr, "calling API")
 }
@@ -169,6 +163,22 @@ ALBC_API void SetFlushLogHandler(AlbcFlushLogHandler handler, void *user_data, A
     }
     ALBC_API_CATCH_AND_TRANSLATE_EXCEPTION(e_ptr, "calling API")
 }
+ALBC_API void SetTraceEnabled(bool enabled, AlbcException **e_ptr) noexcept
+{
+    try
+    {
+        util::TraceRecorder::SetEnabled(enabled);
+    }
+    ALBC_API_CATCH_AND_TRANSLATE_EXCEPTION(e_ptr, "calling API")
+}
+ALBC_API void WriteTraceFile(const char *path, AlbcException **e_ptr) noexcept
+{
+    try
+    {
+        util::TraceRecorder::WriteChromeTraceFile(path);
+    }
+    ALBC_API_CATCH_AND_TRANSLATE_EXCEPTION(e_ptr, "writing trace file")
+}
 ALBC_API AlbcLogLevel ParseLogLevel(const char *level, AlbcLogLevel default_level, AlbcException **e_ptr) noexcept
 {
     try
@@ -209,7 +219,7 @@ void LoadGameDataJson(AlbcGameDataDbType data_type, const char *json, AlbcExcept
 {
     try
     {
-        api::GetGlobalGameDataStorage().Store(data_type, util::read_json_from_char_array(json));
+        api::LoadGameData(api::GetGlobalGameDataRegistry(), data_type, json);
     }
     ALBC_API_CATCH_AND_TRANSLATE_EXCEPTION(e_ptr, "calling API")
 }
@@ -217,9 +227,90 @@ void LoadGameDataFile(AlbcGameDataDbType data_type, const char *path, AlbcExcept
 {
     try
     {
-        api::GetGlobalGameDataStorage().Store(data_type, util::read_json_from_file(path));
+        const util::MappedFile file(path);
+        api::LoadGameData(api::GetGlobalGameDataRegistry(), data_type, file.View());
+    }
+    ALBC_API_CATCH_AND_TRANSLATE_EXCEPTION(e_ptr, "calling API")
+}
+void CompileGameDataSnapshot(const char *path, AlbcException **e_ptr)
+{
+    try
+    {
+        const auto image = api::CompileGameDataSnapshot(*api::GetGlobalGameDataRegistry().Acquire());
+
+        // 先写入临时文件再替换，避免其他进程映射到写了一半的快照
+        const std::string tmp_path = std::string(path) + ".tmp";
+        {
+            std::ofstream ofs(tmp_path, std::ios::binary | std::ios::trunc);
+            if (!ofs.write(image.data(), static_cast<std::streamsize>(image.size())))
+                throw std::runtime_error("Unable to write file: " + tmp_path);
+        }
+
+        std::error_code ec;
+        std::filesystem::rename(tmp_path, path, ec);
+        if (ec)
+        {
+            std::filesystem::remove(tmp_path, ec);
+            throw std::runtime_error(std::string("Unable to write file: ") + path);
+        }
+    }
+    ALBC_API_CATCH_AND_TRANSLATE_EXCEPTION(e_ptr, "calling API")
+}
+void LoadGameDataSnapshot(const char *path, AlbcException **e_ptr)
+{
+    try
+    {
+        const util::MappedFile file(path);
+        api::LoadGameDataSnapshot(api::GetGlobalGameDataRegistry(), file.View());
+    }
+    ALBC_API_CATCH_AND_TRANSLATE_EXCEPTION(e_ptr, "calling API")
+}
+ALBC_API String GenSyntheticInput(const char *config_json, AlbcSyntheticInputType type, AlbcException **e_ptr)
+{
+    try
+    {
+        const api::SyntheticConfig config(util::read_json_from_char_array(config_json));
+        const auto game_data = api::di::AcquireGameData();
+        const auto bd = game_data->Get<data::building::BuildingData>();
+        const auto *cmt = game_data->char_meta_table.get();
+
+        Json::Value json;
+        switch (type)
+        {
+        case ALBC_SYNTHETIC_INPUT_PLAYER_DATA:
+            json = api::GenSyntheticPlayerData(config, *bd, cmt);
+            break;
+        case ALBC_SYNTHETIC_INPUT_JSON_PARAMS:
+            json = api::GenSyntheticJsonParams(config, *bd, cmt);
+            break;
+        default:
+            throw std::invalid_argument("Invalid synthetic input type: " + std::to_string(type));
+        }
+
+        auto i_json_writer = api::di::Resolve<api::IJsonWriter>();
+        return String { i_json_writer->Write(json).c_str() };
+    }
+    ALBC_API_CATCH_AND_TRANSLATE_EXCEPTION(e_ptr, "calling API")
+    return String("{}");
+}
+ALBC_API void SetCaptureDirectory(const char *dir, AlbcException **e_ptr) noexcept
+{
+    try
+    {
+        api::capture::SetDirectory(dir ? dir : "");
+    }
+    ALBC_API_CATCH_AND_TRANSLATE_EXCEPTION(e_ptr, "calling API")
+}
+ALBC_API String ReplayCapture(const char *path, int iterations, AlbcException **e_ptr)
+{
+    try
+    {
+        const auto report = api::capture::ReplayCapture(path, iterations);
+        auto i_json_writer = api::di::Resolve<api::IJsonWriter>();
+        return String { i_json_writer->Write(report).c_str() };
     }
     ALBC_API_CATCH_AND_TRANSLATE_EXCEPTION(e_ptr, "calling API")
+    return String("{}");
 }
 ALBC_API void RunTest(const char *game_data_json, const char *player_data_json, const AlbcTestConfig *config,
              AlbcException **e_ptr)
@@ -249,8 +340,9 @@ ALBC_API ICharQuery *QueryChar(const char *skill_key, const char *char_key)
         if (char_key)
             char_key_str.assign(char_key);
 
-        auto i_slt = api::di::Resolve<data::game::ISkillLookupTable>();
-        auto i_clt = api::di::Resolve<data::game::ICharacterLookupTable>();
+        const auto game_data = api::di::AcquireGameData();
+        auto i_slt = game_data->Get<data::game::ISkillLookupTable>();
+        auto i_clt = game_data->Get<data::game::ICharacterLookupTable>();
         result->item = i_slt->QueryCharWithBuff(skill_key, char_key_str);
         result->name = String {i_clt->IdToName(result->item.id).c_str() };
         return result.release();
@@ -271,8 +363,9 @@ ALBC_API ICharQuery *QueryChar(int n, const char* const* skill_keys, const char
         for (int i = 0; i < n; ++i)
             skill_key_strs.emplace_back(skill_keys[i]);
 
-        auto skill_lookup_table = api::di::Resolve<data::game::ISkillLookupTable>();
-        auto char_lookup_table = api::di::Resolve<data::game::ICharacterLookupTable>();
+        const auto game_data = api::di::AcquireGameData();
+        auto skill_lookup_table = game_data->Get<data::game::ISkillLookupTable>();
+        auto char_lookup_table = game_data->Get<data::game::ICharacterLookupTable>();
         result->item = skill_lookup_table->QueryCharWithBuffList(skill_key_strs, char_key_str);
         result->name = String { char_lookup_table->IdToName(result->item.id).c_str() };
         return result.release();
@@ -370,6 +463,25 @@ ALBC_API_MEMBER IResult *Model::GetResult(AlbcException **e_ptr) noexcept
     ALBC_API_CATCH_AND_TRANSLATE_EXCEPTION(e_ptr, "calling API")
     return nullptr;
 }
+ALBC_API_MEMBER AlbcFlatResult *Model::GetFlatResult(unsigned int flags, AlbcException **e_ptr) noexcept
+{
+    try
+    {
+        return impl_->GetFlatResult(flags);
+    }
+    ALBC_API_CATCH_AND_TRANSLATE_EXCEPTION(e_ptr, "calling API")
+    return nullptr;
+}
+ALBC_API_MEMBER IAsyncResult *Model::GetResultAsync(AlbcAsyncCallback callback, void *user_data,
+                                                    AlbcException **e_ptr) noexcept
+{
+    try
+    {
+        return impl_->GetResultAsync(callback, user_data);
+    }
+    ALBC_API_CATCH_AND_TRANSLATE_EXCEPTION(e_ptr, "calling API")
+    return nullptr;
+}
 ALBC_API_MEMBER Model::Model(AlbcException **e_ptr) noexcept
 {
     try
@@ -537,7 +649,11 @@ ALBC_API ICollection<String> *GetInfo(AlbcException **e_ptr)
 {
     try
     {
-        return new ICollectionVectorImpl<String>();
+        auto info = new ICollectionVectorImpl<String>();
+        for (const auto &line : algorithm::SolveStatsAggregator::Describe())
+            info->emplace_back(line.c_str());
+
+        return info;
     }
     ALBC_API_CATCH_AND_TRANSLATE_EXCEPTION(e_ptr, "calling API")
     return nullptr;
@@ -550,136 +666,223 @@ ALBC_API bool SetGlobalLocale(const char *locale) noexcept
     util::GlobalLocale::SetLocale(locale);
     return true;
 }
-ALBC_API String RunWithJsonParams(const char *json, AlbcException **e_ptr)
+static api::JsonInParams ReadJsonInParams(const char *json)
 {
-    using namespace model::buff;
-    try
-    {
-        auto i_json_reader = api::di::Resolve<api::IJsonReader>();
-        Json::Value in_params_json_obj = i_json_reader->Read(json);
+    auto i_json_reader = api::di::Resolve<api::IJsonReader>();
+    Json::Value in_params_json_obj = i_json_reader->Read(json);
+    api::JsonInParams in_params(in_params_json_obj);
+    if (api::capture::IsEnabled())
+        in_params.source = std::move(in_params_json_obj);
 
-        const api::JsonInParams in_params(in_params_json_obj);
-        api::JsonOutParams out_params;
-        algorithm::iface::CustomPackedInput input;
+    return in_params;
+}
+// on_result(const AlgorithmResult &, api::JsonOutParams &) 在算法参数释放前被调用，返回值即为本函数的返回值
+template <typename TOnResult>
+static auto RunWithJsonInParams(const api::JsonInParams &in_params, const util::CancelToken *cancel_token,
+                                TOnResult &&on_result)
+{
+    using namespace model::buff;
+    api::JsonOutParams out_params;
+    algorithm::iface::CustomPackedInput input;
 
-        for (const auto& [ident, room_data]: in_params.rooms)
+    for (const auto& [ident, room_data]: in_params.rooms)
+    {
+        try
         {
-            try
-            {
-                algorithm::iface::CustomRoom room;
-                room.SetType(room_data.type);
-                switch (room_data.type)  // NOLINT(clang-diagnostic-switch-enum)
-                {
-                case data::building::RoomType::MANUFACTURE:
-                    room.room_attributes.prod_type = room_data.prod_type;
-                    break;
-                case data::building::RoomType::TRADING:
-                    room.room_attributes.order_type = room_data.order_type;
-                    break;
-                default:
-                    LOG_E("Room: ", ident, " has unrecognized type: ", util::enum_to_string(room_data.type));
-                    break;
-                }
-
-                auto& attr = room.room_attributes;
-                attr.prod_cnt = room_data.attributes.prod_cnt;
-                attr.base_prod_eff = room_data.attributes.base_prod_eff;
-                attr.base_prod_cap = room_data.attributes.base_prod_cap;
-                attr.base_char_cost = room_data.attributes.base_char_cost;
-
-                room.SetIdentifier(ident);
-                room.SetMaxSlotCnt(room_data.slot_count);
-                if (auto opt_room_data = room.GenerateRoomData())
-                    input.rooms.emplace_back(std::move(*opt_room_data));
-                else
-                    throw std::runtime_error("failed to generate room data");
-            }
-            catch (const std::exception& e)
+            algorithm::iface::CustomRoom room;
+            room.SetType(room_data.type);
+            switch (room_data.type)  // NOLINT(clang-diagnostic-switch-enum)
             {
-                LOG_E("Error creating room: ", ident, ": ", e.what());
-                out_params.errors.rooms[ident] = e.what();
+            case data::building::RoomType::MANUFACTURE:
+                room.room_attributes.prod_type = room_data.prod_type;
+                break;
+            case data::building::RoomType::TRADING:
+                room.room_attributes.order_type = room_data.order_type;
+                break;
+            default:
+                LOG_E("Room: ", ident, " has unrecognized type: ", util::enum_to_string(room_data.type));
+                break;
             }
+
+            auto& attr = room.room_attributes;
+            attr.prod_cnt = room_data.attributes.prod_cnt;
+            attr.base_prod_eff = room_data.attributes.base_prod_eff;
+            attr.base_prod_cap = room_data.attributes.base_prod_cap;
+            attr.base_char_cost = room_data.attributes.base_char_cost;
+
+            room.SetIdentifier(ident);
+            room.SetMaxSlotCnt(room_data.slot_count);
+            if (auto opt_room_data = room.GenerateRoomData())
+                input.rooms.emplace_back(std::move(*opt_room_data));
+            else
+                throw std::runtime_error("failed to generate room data");
+        }
+        catch (const std::exception& e)
+        {
+            LOG_E("Error creating room: ", ident, ": ", e.what());
+            out_params.errors.rooms[ident] = e.what();
         }
+    }
 
-        auto i_slt = api::di::Resolve<data::game::ISkillLookupTable>();
-        auto cmt = api::di::Resolve<data::game::CharacterMetaTable>();
-        auto i_cr = api::di::Resolve<data::game::ICharacterResolver>();
-        for (const auto& [ident, char_data]: in_params.chars)
+    // 整个求解过程使用同一版本的游戏数据
+    const auto game_data = api::di::AcquireGameData();
+    auto i_slt = game_data->Get<data::game::ISkillLookupTable>();
+    auto cmt = game_data->Get<data::game::CharacterMetaTable>();
+    auto i_cr = game_data->Get<data::game::ICharacterResolver>();
+    for (const auto& [ident, char_data]: in_params.chars)
+    {
+        try
         {
-            try
+            algorithm::iface::CustomCharacter character(i_cr, cmt);
+
+            character.SetIdentifier(ident);
+
+            if (!char_data.name.empty())
+                character.SetIdResolveCond(char_data.name, data::game::CharIdentifierType::NAME);
+            else if (!char_data.id.empty())
+                character.SetIdResolveCond(char_data.id, data::game::CharIdentifierType::ID);
+
+            if (char_data.phase > (int)data::EvolvePhase::PHASE_2 || char_data.level > 90)
+                throw std::invalid_argument(std::string("invalid argument: ") +
+                                            "phase: " + std::to_string(char_data.phase) +
+                                            ", level: " + std::to_string(char_data.level));
+
+            if (char_data.phase >= 0 && char_data.level >= 0)
+                character.SetLevelCond((data::EvolvePhase)char_data.phase, char_data.level);
+
+            for (const auto& skill_ident: char_data.skills)
             {
-                algorithm::iface::CustomCharacter character(i_cr, cmt);
-
-                character.SetIdentifier(ident);
-
-                if (!char_data.name.empty())
-                    character.SetIdResolveCond(char_data.name, data::game::CharIdentifierType::NAME);
-                else if (!char_data.id.empty())
-                    character.SetIdResolveCond(char_data.id, data::game::CharIdentifierType::ID);
-
-                if (char_data.phase > (int)data::EvolvePhase::PHASE_2 || char_data.level > 90)
-                    throw std::invalid_argument(std::string("invalid argument: ") +
-                                                "phase: " + std::to_string(char_data.phase) +
-                                                ", level: " + std::to_string(char_data.level));
-
-                if (char_data.phase >= 0 && char_data.level >= 0)
-                    character.SetLevelCond((data::EvolvePhase)char_data.phase, char_data.level);
-
-                for (const auto& skill_ident: char_data.skills)
-                {
-                    if (i_slt->HasId(skill_ident))
-                        character.AddSkillById(skill_ident);
-                    else if (i_slt->HasName(skill_ident))
-                        character.AddSkillByName(skill_ident);
-                    else if (i_slt->HasIcon(skill_ident))
-                        character.AddSkillByIcon(skill_ident);
-                    else
-                        LOG_W("Unrecognized skill: ", skill_ident, " of character: ", ident);
-                }
-
-                character.SetMorale(char_data.morale);
-                if (auto opt_char_data = character.GenerateCharacterData())
-                    input.characters.emplace_back(std::move(*opt_char_data));
+                if (i_slt->HasId(skill_ident))
+                    character.AddSkillById(skill_ident);
+                else if (i_slt->HasName(skill_ident))
+                    character.AddSkillByName(skill_ident);
+                else if (i_slt->HasIcon(skill_ident))
+                    character.AddSkillByIcon(skill_ident);
                 else
-                    throw std::runtime_error("failed to generate character data");
-            }
-            catch (const std::exception& e)
-            {
-                LOG_E("Error creating character: ", ident, ": ", e.what());
-                out_params.errors.chars[ident] = e.what();
+                    LOG_W("Unrecognized skill: ", skill_ident, " of character: ", ident);
             }
+
+            character.SetMorale(char_data.morale);
+            if (auto opt_char_data = character.GenerateCharacterData())
+                input.characters.emplace_back(std::move(*opt_char_data));
+            else
+                throw std::runtime_error("failed to generate character data");
+        }
+        catch (const std::exception& e)
+        {
+            LOG_E("Error creating character: ", ident, ": ", e.what());
+            out_params.errors.chars[ident] = e.what();
         }
+    }
 
-        const auto bd = api::di::Resolve<data::building::BuildingData>();
-        algorithm::iface::AlgorithmParams alg_params(input, *bd);
+    util::throw_if_stopped(cancel_token);
+    const auto bd = game_data->Get<data::building::BuildingData>();
+    algorithm::iface::AlgorithmParams alg_params(input, *bd);
 
-        const auto i_runner = api::di::Resolve<algorithm::iface::IRunner>();
-        algorithm::AlgorithmResult result;
-        AlbcSolverParameters solver_params {};
-        solver_params.solve_time_limit = in_params.solve_time_limit;
-        solver_params.model_time_limit = in_params.model_time_limit;
-        solver_params.gen_all_solution_details = in_params.gen_sol_details;
-        solver_params.gen_lp_file = in_params.gen_lp_file;
+    const auto i_runner = api::di::Resolve<algorithm::iface::IRunner>();
+    algorithm::AlgorithmResult result;
+    AlbcSolverParameters solver_params {};
+    solver_params.solve_time_limit = in_params.solve_time_limit;
+    solver_params.model_time_limit = in_params.model_time_limit;
+    solver_params.gen_all_solution_details = in_params.gen_sol_details;
+    solver_params.gen_lp_file = in_params.gen_lp_file;
+    solver_params.alt_plan_count = in_params.alt_plan_count;
+    solver_params.alt_exclusion_plans = in_params.alt_exclusion_plans;
+    solver_params.shift_count = in_params.shift_count;
+    solver_params.rest_recovery = in_params.rest_recovery;
 
-        i_runner->Run(alg_params, solver_params, result);
-        for (const auto& room: result.rooms)
-        {
-            api::JsonOutRoomStruct out_room;
-            out_room.score = room.solution.productivity;
-            out_room.duration = room.solution.duration;
-            for (const auto* op: room.solution.operators)
-                if (op)
-                    out_room.chars.emplace_back(op->identifier);
-
-            out_params.rooms.emplace(room.room->id, std::move(out_room));
-        }
+    i_runner->Run(alg_params, solver_params, result, cancel_token);
+    if (api::capture::IsEnabled())
+        api::capture::CaptureSolve(api::capture::CaptureKind::JSON_PARAMS, in_params.source, &input, solver_params,
+                                   *game_data, result);
 
-        auto i_json_writer = api::di::Resolve<api::IJsonWriter>();
-        return String { i_json_writer->Write(static_cast<Json::Value>(out_params)).c_str() };
+    return on_result(static_cast<const algorithm::AlgorithmResult &>(result), out_params);
+}
+static void WriteJsonRooms(const Vector<algorithm::RoomResult> &rooms,
+                           SmallDictionary<std::string, api::JsonOutRoomStruct> &out_rooms)
+{
+    for (const auto& room: rooms)
+    {
+        api::JsonOutRoomStruct out_room;
+        out_room.score = room.solution.productivity;
+        out_room.duration = room.solution.duration;
+        for (const auto* op: room.solution.operators)
+            if (op)
+                out_room.chars.emplace_back(op->identifier);
+
+        out_rooms.emplace(room.room->id, std::move(out_room));
+    }
+}
+static std::string WriteJsonResult(const algorithm::AlgorithmResult &result, api::JsonOutParams &out_params)
+{
+    out_params.stats = api::JsonOutStatsStruct(result.stats);
+    WriteJsonRooms(result.rooms, out_params.rooms);
+    for (const auto& plan: result.alternatives)
+    {
+        auto &out_plan = out_params.alternatives.emplace_back();
+        out_plan.objective = plan.objective;
+        out_plan.solve_time = plan.solve_time;
+        out_plan.optimal = plan.optimal;
+        if (plan.excluded)
+            out_plan.excluded = plan.excluded->identifier;
+        WriteJsonRooms(plan.rooms, out_plan.rooms);
+    }
+    for (const auto& shift_rooms: result.shifts)
+        WriteJsonRooms(shift_rooms, out_params.shifts.emplace_back());
+
+    auto i_json_writer = api::di::Resolve<api::IJsonWriter>();
+    return i_json_writer->Write(static_cast<Json::Value>(out_params));
+}
+ALBC_API String RunWithJsonParams(const char *json, AlbcException **e_ptr)
+{
+    try
+    {
+        const auto in_params = ReadJsonInParams(json);
+        const util::CancelToken token(in_params.deadline);
+        return String { RunWithJsonInParams(in_params, &token, WriteJsonResult).c_str() };
     }
     ALBC_API_CATCH_AND_TRANSLATE_EXCEPTION(e_ptr, "calling API")
     return String("{}");
 }
+ALBC_API AlbcFlatResult *RunWithJsonParamsFlat(const char *json, unsigned int flags, AlbcException **e_ptr)
+{
+    try
+    {
+        const auto in_params = ReadJsonInParams(json);
+        const util::CancelToken token(in_params.deadline);
+        return RunWithJsonInParams(
+            in_params, &token, [flags](const algorithm::AlgorithmResult &result, const api::JsonOutParams &out_params) {
+                Vector<std::string> errors;
+                for (const auto &[ident, msg] : out_params.errors.chars)
+                    errors.emplace_back("char ").append(ident).append(": ").append(msg);
+                for (const auto &[ident, msg] : out_params.errors.rooms)
+                    errors.emplace_back("room ").append(ident).append(": ").append(msg);
+
+                return api::MakeFlatResult(0, result, errors, flags);
+            });
+    }
+    ALBC_API_CATCH_AND_TRANSLATE_EXCEPTION(e_ptr, "calling API")
+    return nullptr;
+}
+ALBC_API void FreeFlatResult(AlbcFlatResult *result) noexcept
+{
+    albc::free(result);
+}
+ALBC_API IAsyncJsonResult *RunWithJsonParamsAsync(const char *json, AlbcAsyncCallback callback, void *user_data,
+                                                  AlbcException **e_ptr)
+{
+    try
+    {
+        auto in_params = std::make_shared<api::JsonInParams>(ReadJsonInParams(json));
+        auto task = std::make_unique<AsyncJsonResultImpl>(callback, user_data, in_params->deadline);
+        task->Start([in_params](const util::CancelToken &token) {
+            return RunWithJsonInParams(*in_params, &token, WriteJsonResult);
+        });
+        return task.release();
+    }
+    ALBC_API_CATCH_AND_TRANSLATE_EXCEPTION(e_ptr, "calling API")
+    return nullptr;
+}
 
 } // namespace albc
 
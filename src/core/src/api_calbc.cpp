@@ -9,6 +9,7 @@
 #include "json/json.h"
 
 CALBC_HANDLE_IMPL(AlbcString, albc::String)
+CALBC_HANDLE_IMPL(AlbcAsyncJsonResult, albc::IAsyncJsonResult)
  
 CALBC_API void AlbcTest(const char *game_data_json, const char *player_data_json, const AlbcTestConfig *config, AlbcException**e_ptr)
 {
@@ -28,6 +29,18 @@ CALBC_API void AlbcFlushLog(AlbcException** e_ptr)
 }
 
  
+CALBC_API void AlbcSetTraceEnabled(bool enabled, AlbcException **e_ptr)
+{
+    albc::SetTraceEnabled(enabled, e_ptr);
+}
+
+ 
+CALBC_API void AlbcWriteTraceFile(const char *path, AlbcException **e_ptr)
+{
+    albc::WriteTraceFile(path, e_ptr);
+}
+
+ 
 CALBC_API enum AlbcLogLevel AlbcParseLogLevel(const char *level, enum AlbcLogLevel default_level, AlbcException **e_ptr)
 {
     return albc::ParseLogLevel(level, default_level, e_ptr);
@@ -106,7 +119,109 @@ CALBC_API void AlbcLoadGameDataFile(AlbcGameDataDbType type, const char *path, A
     albc::LoadGameDataFile(type, path, e_ptr);
 }
 
+CALBC_API void AlbcCompileGameDataSnapshot(const char *path, AlbcException **e_ptr)
+{
+    albc::CompileGameDataSnapshot(path, e_ptr);
+}
+
+CALBC_API void AlbcLoadGameDataSnapshot(const char *path, AlbcException **e_ptr)
+{
+    albc::LoadGameDataSnapshot(path, e_ptr);
+}
+
 CALBC_API AlbcString *AlbcRunWithJsonParams(const char *json, AlbcException **e_ptr)
 {
     return new AlbcString(new albc::String(albc::RunWithJsonParams(json, e_ptr)));
 }
+
+CALBC_API AlbcString *AlbcGenSyntheticInput(const char *config_json, AlbcSyntheticInputType type, AlbcException **e_ptr)
+{
+    return new AlbcString(new albc::String(albc::GenSyntheticInput(config_json, type, e_ptr)));
+}
+
+CALBC_API void AlbcSetCaptureDirectory(const char *dir, AlbcException **e_ptr)
+{
+    albc::SetCaptureDirectory(dir, e_ptr);
+}
+
+CALBC_API AlbcString *AlbcReplayCapture(const char *path, int iterations, AlbcException **e_ptr)
+{
+    return new AlbcString(new albc::String(albc::ReplayCapture(path, iterations, e_ptr)));
+}
+
+CALBC_API AlbcAsyncJsonResult *AlbcRunWithJsonParamsAsync(const char *json, AlbcAsyncCallback callback, void *user_data,
+                                                          AlbcException **e_ptr)
+{
+    auto *result = albc::RunWithJsonParamsAsync(json, callback, user_data, e_ptr);
+    return result ? new AlbcAsyncJsonResult(result) : nullptr;
+}
+
+CALBC_API void AlbcAsyncJsonResultDel(AlbcAsyncJsonResult *result)
+{
+    try
+    {
+        delete result;
+    }
+    ALBC_API_CATCH_AND_TRANSLATE_EXCEPTION(nullptr, "calling API")
+}
+
+CALBC_API AlbcAsyncStatus AlbcAsyncJsonResultPoll(AlbcAsyncJsonResult *result)
+{
+    return result->impl->Poll();
+}
+
+CALBC_API bool AlbcAsyncJsonResultWait(AlbcAsyncJsonResult *result, double timeout_sec)
+{
+    return result->impl->Wait(timeout_sec);
+}
+
+CALBC_API void AlbcAsyncJsonResultCancel(AlbcAsyncJsonResult *result)
+{
+    result->impl->Cancel();
+}
+
+CALBC_API AlbcString *AlbcAsyncJsonResultGetResult(AlbcAsyncJsonResult *result, AlbcException **e_ptr)
+{
+    return new AlbcString(new albc::String(result->impl->GetResult(e_ptr)));
+}
+
+CALBC_API AlbcFlatResult *AlbcRunWithJsonParamsFlat(const char *json, unsigned int flags, AlbcException **e_ptr)
+{
+    return albc::RunWithJsonParamsFlat(json, flags, e_ptr);
+}
+
+CALBC_API void AlbcFlatResultFree(AlbcFlatResult *result)
+{
+    albc::FreeFlatResult(result);
+}
+
+CALBC_API const AlbcFlatRoomRecord *AlbcFlatResultGetRooms(const AlbcFlatResult *result)
+{
+    return reinterpret_cast<const AlbcFlatRoomRecord *>(reinterpret_cast<const char *>(result) + result->room_offset);
+}
+
+CALBC_API const char *AlbcFlatResultGetString(const AlbcFlatResult *result, uint32_t offset)
+{
+    if (offset == ALBC_FLAT_NO_STRING || offset >= result->string_size)
+        return nullptr;
+
+    return reinterpret_cast<const char *>(result) + result->string_offset + offset;
+}
+
+CALBC_API const char *AlbcFlatResultGetCharIdentifier(const AlbcFlatResult *result, uint32_t index)
+{
+    if (index >= result->char_count)
+        return nullptr;
+
+    const auto *refs = reinterpret_cast<const uint32_t *>(reinterpret_cast<const char *>(result) + result->char_offset);
+    return AlbcFlatResultGetString(result, refs[index]);
+}
+
+CALBC_API const char *AlbcFlatResultGetError(const AlbcFlatResult *result, uint32_t index)
+{
+    if (index >= result->error_count)
+        return nullptr;
+
+    const auto *refs = reinterpret_cast<const uint32_t *>(reinterpret_cast<const char *>(result) + result->error_offset);
+    return AlbcFlatResultGetString(result, refs[index]);
+}
\ No newline at end of file
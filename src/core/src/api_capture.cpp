@@ -0,0 +1,410 @@
+#include "api_capture.h"
+#include "algorithm_iface_params.h"
+#include "algorithm_iface_runner.h"
+#include "api_di.h"
+#include "data_player.h"
+#include "util_json_stream.h"
+#include "util_time.h"
+
+#include <atomic>
+#include <cmath>
+#include <filesystem>
+#include <fstream>
+#include <mutex>
+
+namespace albc::api::capture
+{
+namespace
+{
+using algorithm::iface::CustomCharacterData;
+using algorithm::iface::CustomPackedInput;
+using algorithm::iface::CustomRoomData;
+
+ALBC_API_JSON_KEY(kCharacters, "characters");
+ALBC_API_JSON_KEY(kRooms, "rooms");
+ALBC_API_JSON_KEY(kGlobalAttributes, "global_attributes");
+ALBC_API_JSON_KEY(kIdentifier, "identifier");
+ALBC_API_JSON_KEY(kResolvedCharId, "resolved_char_id");
+ALBC_API_JSON_KEY(kSpCharGroup, "sp_char_group");
+ALBC_API_JSON_KEY(kIsRegular, "is_regular");
+ALBC_API_JSON_KEY(kMorale, "morale");
+ALBC_API_JSON_KEY(kPhase, "phase");
+ALBC_API_JSON_KEY(kLevel, "level");
+ALBC_API_JSON_KEY(kSkills, "skills");
+ALBC_API_JSON_KEY(kType, "type");
+ALBC_API_JSON_KEY(kSlots, "slots");
+ALBC_API_JSON_KEY(kProdType, "prod_type");
+ALBC_API_JSON_KEY(kOrderType, "order_type");
+ALBC_API_JSON_KEY(kProdCnt, "prod_cnt");
+ALBC_API_JSON_KEY(kBaseProdCap, "base_prod_cap");
+ALBC_API_JSON_KEY(kBaseCharCost, "base_char_cost");
+ALBC_API_JSON_KEY(kBaseProdEff, "base_prod_eff");
+
+ALBC_API_JSON_KEY(kIterations, "iterations");
+ALBC_API_JSON_KEY(kGameDataMatch, "game_data_match");
+ALBC_API_JSON_KEY(kResultMatch, "result_match");
+ALBC_API_JSON_KEY(kMismatches, "mismatches");
+ALBC_API_JSON_KEY(kCaptured, "captured");
+ALBC_API_JSON_KEY(kRuns, "runs");
+ALBC_API_JSON_KEY(kTimes, "times");
+ALBC_API_JSON_KEY(kMean, "mean");
+ALBC_API_JSON_KEY(kMin, "min");
+ALBC_API_JSON_KEY(kMax, "max");
+
+// 比较房间得分的相对容差，超出即视为结果不一致
+constexpr double kScoreTolerance = 1e-6;
+
+std::atomic_bool g_enabled{false};
+std::atomic<UInt64> g_sequence{0};
+std::mutex g_dir_mutex;
+std::string g_dir;
+
+std::string HashToString(UInt64 hash)
+{
+    char buf[17];
+    std::snprintf(buf, sizeof(buf), "%016llx", static_cast<unsigned long long>(hash));
+    return buf;
+}
+
+Json::Value GameDataToJson(const GameDataTables &game_data)
+{
+    Json::Value val;
+    val[kGeneration] = static_cast<Json::UInt64>(game_data.generation);
+    val[kBuildingDataHash] = HashToString(game_data.building_data_hash);
+    val[kCharacterTableHash] = HashToString(game_data.character_table_hash);
+    val[kCharMetaTableHash] = HashToString(game_data.char_meta_table_hash);
+    return val;
+}
+
+Json::Value SolverParamsToJson(const AlbcSolverParameters &params)
+{
+    Json::Value val;
+    val[JsonInParams::kModelTimeLimit] = params.model_time_limit;
+    val[JsonInParams::kSolveTimeLimit] = params.solve_time_limit;
+    val[JsonInParams::kGenSolDetails] = params.gen_all_solution_details;
+    val[JsonInParams::kGenLpFile] = params.gen_lp_file;
+    val[JsonInParams::kAltPlanCount] = params.alt_plan_count;
+    val[JsonInParams::kAltExclusionPlans] = params.alt_exclusion_plans;
+    val[JsonInParams::kShiftCount] = params.shift_count;
+    val[JsonInParams::kRestRecovery] = params.rest_recovery;
+    return val;
+}
+
+AlbcSolverParameters SolverParamsFromJson(const Json::Value &val)
+{
+    AlbcSolverParameters params{};
+    params.model_time_limit = val.get(JsonInParams::kModelTimeLimit, 0).asDouble();
+    params.solve_time_limit = val.get(JsonInParams::kSolveTimeLimit, 0).asDouble();
+    params.gen_all_solution_details = val.get(JsonInParams::kGenSolDetails, false).asBool();
+    params.gen_lp_file = val.get(JsonInParams::kGenLpFile, false).asBool();
+    params.alt_plan_count = val.get(JsonInParams::kAltPlanCount, 0).asInt();
+    params.alt_exclusion_plans = val.get(JsonInParams::kAltExclusionPlans, false).asBool();
+    params.shift_count = val.get(JsonInParams::kShiftCount, 1).asInt();
+    params.rest_recovery = val.get(JsonInParams::kRestRecovery, 0).asDouble();
+    return params;
+}
+
+// 结果中的房间按Id排列，与 RunWithJsonParams 的输出格式相同
+Json::Value ResultToJson(const algorithm::AlgorithmResult &result)
+{
+    Json::Value rooms(Json::objectValue);
+    for (const auto &room : result.rooms)
+    {
+        JsonOutRoomStruct out_room;
+        out_room.score = room.solution.productivity;
+        out_room.duration = room.solution.duration;
+        for (const auto *op : room.solution.operators)
+            if (op)
+                out_room.chars.emplace_back(op->identifier);
+
+        rooms[room.room->id] = static_cast<Json::Value>(out_room);
+    }
+    return rooms;
+}
+
+bool ScoreEquals(double a, double b)
+{
+    return std::abs(a - b) <= kScoreTolerance * std::max({1., std::abs(a), std::abs(b)});
+}
+
+void CompareResults(const Json::Value &expected, const Json::Value &actual, Json::Value &mismatches)
+{
+    for (const auto &id : expected.getMemberNames())
+    {
+        if (!actual.isMember(id))
+        {
+            mismatches.append("room " + id + ": missing in replay");
+            continue;
+        }
+
+        const auto &e = expected[id];
+        const auto &a = actual[id];
+        if (e[JsonOutRoomStruct::kChars] != a[JsonOutRoomStruct::kChars])
+            mismatches.append("room " + id + ": chars differ, captured " +
+                              e[JsonOutRoomStruct::kChars].toStyledString() + "replayed " +
+                              a[JsonOutRoomStruct::kChars].toStyledString());
+        else if (!ScoreEquals(e[JsonOutRoomStruct::kScore].asDouble(), a[JsonOutRoomStruct::kScore].asDouble()))
+            mismatches.append("room " + id + ": score differs, captured " +
+                              std::to_string(e[JsonOutRoomStruct::kScore].asDouble()) + ", replayed " +
+                              std::to_string(a[JsonOutRoomStruct::kScore].asDouble()));
+    }
+
+    for (const auto &id : actual.getMemberNames())
+        if (!expected.isMember(id))
+            mismatches.append("room " + id + ": not in capture");
+}
+
+// 只比较两边都有记录的哈希，捕获时未载入的数据不参与比较
+bool GameDataMatches(const Json::Value &captured, const GameDataTables &current)
+{
+    const auto matches = [&captured](const char *key, UInt64 hash) {
+        const auto captured_hash = captured.get(key, "").asString();
+        const auto zero = HashToString(0);
+        return captured_hash.empty() || captured_hash == zero || hash == 0 || captured_hash == HashToString(hash);
+    };
+
+    return matches(kBuildingDataHash, current.building_data_hash) &&
+           matches(kCharacterTableHash, current.character_table_hash) &&
+           matches(kCharMetaTableHash, current.char_meta_table_hash);
+}
+
+std::string NextCapturePath(const std::string &dir)
+{
+    const auto ms = std::chrono::duration_cast<std::chrono::milliseconds>(
+                        std::chrono::system_clock::now().time_since_epoch()).count();
+    return (std::filesystem::path(dir) /
+            ("capture_" + std::to_string(ms) + "_" + std::to_string(g_sequence.fetch_add(1)) + ".json"))
+        .string();
+}
+
+std::unique_ptr<data::player::PlayerDataModel> PlayerDataFromJson(const Json::Value &val)
+{
+    const auto text = di::Resolve<IJsonWriter>()->Write(val);
+    util::JsonStreamReader reader(text);
+    auto player_data = std::make_unique<data::player::PlayerDataModel>(reader);
+    reader.ExpectEnd();
+    return player_data;
+}
+} // namespace
+
+void SetDirectory(const std::string &dir)
+{
+    if (!dir.empty())
+        std::filesystem::create_directories(dir);
+
+    std::lock_guard lock(g_dir_mutex);
+    g_dir = dir;
+    g_enabled = !dir.empty();
+}
+
+bool IsEnabled()
+{
+    return g_enabled.load(std::memory_order_relaxed);
+}
+
+void CaptureSolve(CaptureKind kind, const Json::Value &input, const CustomPackedInput *resolved,
+                  const AlbcSolverParameters &solver_params, const GameDataTables &game_data,
+                  const algorithm::AlgorithmResult &result)
+{
+    std::string dir;
+    {
+        std::lock_guard lock(g_dir_mutex);
+        dir = g_dir;
+    }
+    if (dir.empty())
+        return;
+
+    std::string path;
+    try
+    {
+        Json::Value val;
+        val[kVersion] = kCaptureVersion;
+        val[kKind] = std::string(util::enum_to_string(kind));
+        val[kTimestamp] = static_cast<Json::Int64>(std::chrono::duration_cast<std::chrono::milliseconds>(
+                                                       std::chrono::system_clock::now().time_since_epoch())
+                                                       .count());
+        val[kGameData] = GameDataToJson(game_data);
+        val[kSolverParams] = SolverParamsToJson(solver_params);
+        val[kInput] = input;
+        val[kResolved] = resolved ? PackedInputToJson(*resolved) : Json::Value();
+        val[kResult] = ResultToJson(result);
+        val[kStats] = static_cast<Json::Value>(JsonOutStatsStruct(result.stats));
+
+        path = NextCapturePath(dir);
+        std::ofstream ofs(path, std::ios::trunc);
+        if (!(ofs << di::Resolve<IJsonWriter>()->Write(val)))
+            throw std::runtime_error("Unable to write file: " + path);
+
+        LOG_D("Captured solve request: ", path);
+    }
+    catch (const std::exception &e)
+    {
+        LOG_W("Failed to capture solve request ", path, ": ", e.what());
+    }
+}
+
+Json::Value PackedInputToJson(const CustomPackedInput &input)
+{
+    Json::Value chars(Json::arrayValue);
+    for (const auto &c : input.characters)
+    {
+        Json::Value val;
+        val[kIdentifier] = c.identifier;
+        val[kResolvedCharId] = c.resolved_char_id;
+        val[kSpCharGroup] = c.sp_char_group;
+        val[kIsRegular] = c.is_regular_character;
+        val[kMorale] = c.morale;
+        val[kPhase] = static_cast<int>(c.phase);
+        val[kLevel] = c.level;
+        val[kSkills] = util::json_val_from_vector<std::string>(c.resolved_skill_ids);
+        chars.append(std::move(val));
+    }
+
+    Json::Value rooms(Json::arrayValue);
+    for (const auto &r : input.rooms)
+    {
+        const auto &attr = r.room_attributes;
+        Json::Value val;
+        val[kIdentifier] = r.identifier;
+        val[kType] = std::string(util::enum_to_string(r.type));
+        val[kSlots] = r.max_slot_cnt;
+        val[kProdType] = std::string(util::enum_to_string(attr.prod_type));
+        val[kOrderType] = std::string(util::enum_to_string(attr.order_type));
+        val[kProdCnt] = attr.prod_cnt;
+        val[kBaseProdCap] = attr.base_prod_cap;
+        val[kBaseCharCost] = attr.base_char_cost;
+        val[kBaseProdEff] = attr.base_prod_eff;
+        rooms.append(std::move(val));
+    }
+
+    Json::Value global_attributes(Json::arrayValue);
+    for (const double v : input.global_data.global_attributes)
+        global_attributes.append(v);
+
+    Json::Value val;
+    val[kCharacters] = std::move(chars);
+    val[kRooms] = std::move(rooms);
+    val[kGlobalAttributes] = std::move(global_attributes);
+    return val;
+}
+
+CustomPackedInput PackedInputFromJson(const Json::Value &val)
+{
+    CustomPackedInput input;
+    for (const auto &c : val[kCharacters])
+    {
+        CustomCharacterData data;
+        data.identifier = c[kIdentifier].asString();
+        data.resolved_char_id = c[kResolvedCharId].asString();
+        data.sp_char_group = c[kSpCharGroup].asString();
+        data.is_regular_character = c[kIsRegular].asBool();
+        data.morale = c[kMorale].asDouble();
+        data.phase = static_cast<data::EvolvePhase>(c[kPhase].asInt());
+        data.level = c[kLevel].asInt();
+        data.resolved_skill_ids = util::json_val_as_vector<std::string>(c[kSkills], util::json_cast<std::string>);
+        input.characters.push_back(std::move(data));
+    }
+
+    for (const auto &r : val[kRooms])
+    {
+        CustomRoomData data;
+        data.identifier = r[kIdentifier].asString();
+        data.type = util::parse_enum_string(r[kType].asString(), data::building::RoomType::NONE);
+        data.max_slot_cnt = r[kSlots].asInt();
+
+        auto &attr = data.room_attributes;
+        attr.prod_type = util::parse_enum_string(r[kProdType].asString(), model::buff::ProdType::UNDEFINED);
+        attr.order_type = util::parse_enum_string(r[kOrderType].asString(), model::buff::OrderType::UNDEFINED);
+        attr.prod_cnt = r[kProdCnt].asInt();
+        attr.base_prod_cap = r[kBaseProdCap].asInt();
+        attr.base_char_cost = r[kBaseCharCost].asDouble();
+        attr.base_prod_eff = r[kBaseProdEff].asDouble();
+        input.rooms.push_back(std::move(data));
+    }
+
+    auto it = input.global_data.global_attributes.begin();
+    for (const auto &v : val[kGlobalAttributes])
+    {
+        if (it == input.global_data.global_attributes.end())
+            break;
+
+        *it++ = v.asDouble();
+    }
+
+    return input;
+}
+
+Json::Value ReplayCapture(const std::string &path, int iterations)
+{
+    const auto capture = util::read_json_from_file(path);
+    if (capture.get(kVersion, 0).asInt() != kCaptureVersion)
+        throw std::runtime_error("Unsupported capture version: " + path);
+
+    const auto kind = util::parse_enum_string(capture[kKind].asString(), CaptureKind::CUSTOM_MODEL);
+    const auto game_data = di::AcquireGameData();
+    const auto bd = game_data->Get<data::building::BuildingData>();
+    const auto solver_params = SolverParamsFromJson(capture[kSolverParams]);
+
+    // 输入在重放前一次性解析，计时只包含求解过程，与捕获时的统计口径一致
+    std::unique_ptr<data::player::PlayerDataModel> player_data;
+    std::optional<CustomPackedInput> packed_input;
+    if (kind == CaptureKind::PLAYER_DATA)
+        player_data = PlayerDataFromJson(capture[kInput]);
+    else
+        packed_input = PackedInputFromJson(capture[kResolved]);
+
+    Json::Value report;
+    report[kKind] = capture[kKind];
+    report[kIterations] = std::max(1, iterations);
+    report[kGameDataMatch] = GameDataMatches(capture[kGameData], *game_data);
+
+    Json::Value mismatches(Json::arrayValue);
+    Json::Value runs(Json::arrayValue);
+    const auto i_runner = di::Resolve<algorithm::iface::IRunner>();
+    for (int i = 0; i < std::max(1, iterations); ++i)
+    {
+        const auto params = player_data ? std::make_unique<algorithm::iface::AlgorithmParams>(*player_data, *bd)
+                                        : std::make_unique<algorithm::iface::AlgorithmParams>(*packed_input, *bd);
+        algorithm::AlgorithmResult result;
+        i_runner->Run(*params, solver_params, result, nullptr);
+
+        // 只报告第一次出现的不一致，多次重放的结果差异说明求解本身不确定
+        if (mismatches.empty())
+            CompareResults(capture[kResult], ResultToJson(result), mismatches);
+
+        runs.append(static_cast<Json::Value>(JsonOutStatsStruct(result.stats)));
+    }
+
+    const std::string time_keys[] = {JsonOutStatsStruct::kDataFeedTime, JsonOutStatsStruct::kFilterTime,
+                                     JsonOutStatsStruct::kEnumTime, JsonOutStatsStruct::kSolveTime,
+                                     JsonOutStatsStruct::kTotalTime};
+    Json::Value times;
+    for (const auto &key : time_keys)
+    {
+        double sum = 0;
+        double min = std::numeric_limits<double>::max();
+        double max = 0;
+        for (const auto &run : runs)
+        {
+            const double t = run[key].asDouble();
+            sum += t;
+            min = std::min(min, t);
+            max = std::max(max, t);
+        }
+
+        Json::Value time;
+        time[kCaptured] = capture[kStats][key];
+        time[kMean] = sum / runs.size();
+        time[kMin] = min;
+        time[kMax] = max;
+        times[key] = std::move(time);
+    }
+
+    report[kResultMatch] = mismatches.empty();
+    report[kMismatches] = std::move(mismatches);
+    report[kTimes] = std::move(times);
+    report[kCaptured] = capture[kStats];
+    report[kRuns] = std::move(runs);
+    return report;
+}
+} // namespace albc::api::capture
@@ -0,0 +1,50 @@
+#pragma once
+#include "algorithm_iface_custom.h"
+#include "algorithm_params.h"
+#include "api_json_params.h"
+#include "api_storage.h"
+
+namespace albc::api::capture
+{
+// 请求捕获：开启后每次求解将输入、解析后的参数、游戏数据版本、结果与耗时写入捕获目录下的一个文件，
+// 供离线重放与性能分析。捕获失败只记录警告，不影响求解本身。
+ALBC_API_JSON_KEY(kVersion, "version");
+ALBC_API_JSON_KEY(kKind, "kind");
+ALBC_API_JSON_KEY(kTimestamp, "timestamp");
+ALBC_API_JSON_KEY(kGameData, "game_data");
+ALBC_API_JSON_KEY(kGeneration, "generation");
+ALBC_API_JSON_KEY(kBuildingDataHash, "building_data");
+ALBC_API_JSON_KEY(kCharacterTableHash, "character_table");
+ALBC_API_JSON_KEY(kCharMetaTableHash, "char_meta_table");
+ALBC_API_JSON_KEY(kSolverParams, "solver_params");
+ALBC_API_JSON_KEY(kInput, "input");
+ALBC_API_JSON_KEY(kResolved, "resolved");
+ALBC_API_JSON_KEY(kResult, "result");
+ALBC_API_JSON_KEY(kStats, "stats");
+
+constexpr int kCaptureVersion = 1;
+
+enum class CaptureKind
+{
+    JSON_PARAMS,  // RunWithJsonParams 系列，input 为请求 JSON
+    PLAYER_DATA,  // 由玩家数据创建的 Model，input 为玩家数据
+    CUSTOM_MODEL, // 由 Character/Room 构建的 Model，input 为空
+};
+
+// 设置捕获目录（不存在时创建），空字符串关闭捕获
+void SetDirectory(const std::string &dir);
+
+[[nodiscard]] bool IsEnabled();
+
+// resolved 为空时表示输入没有对应的 CustomPackedInput（如玩家数据）
+void CaptureSolve(CaptureKind kind, const Json::Value &input, const algorithm::iface::CustomPackedInput *resolved,
+                  const AlbcSolverParameters &solver_params, const GameDataTables &game_data,
+                  const algorithm::AlgorithmResult &result);
+
+Json::Value PackedInputToJson(const algorithm::iface::CustomPackedInput &input);
+
+algorithm::iface::CustomPackedInput PackedInputFromJson(const Json::Value &val);
+
+// 以当前载入的游戏数据重新求解捕获文件 iterations 次，返回比较结果与耗时的报告
+Json::Value ReplayCapture(const std::string &path, int iterations);
+} // namespace albc::api::capture
@@ -1,12 +1,6 @@
 #pragma once
-#include "api_resource.h"
 #include "api_storage.h"
 #include "boost/di.hpp"
-#include "data_character_lookup_table.h"
-#include "data_character_meta_table.h"
-#include "data_character_resolver.h"
-#include "data_character_table.h"
-#include "data_skill_lookup_table.h"
 #include "algorithm_iface_runner.h"
 #include "api_json_io.h"
 
@@ -15,15 +9,10 @@ namespace albc::api::di
 {
 #pragma clang diagnostic push
 #pragma clang diagnostic ignored "-Wunneeded-internal-declaration"
+// 无状态的服务。游戏数据及其查询表由 GameDataRegistry 提供，不经过注入器。
 static const auto& GetInjector()
 {
     static auto injector = boost::di::make_injector(
-        boost::di::bind<data::building::BuildingData>().to([] { return GetGlobalGameDataStorage().Resolve<data::building::BuildingData>(ALBC_GAME_DATA_DB_BUILDING_DATA); }),
-        boost::di::bind<data::game::CharacterTable>().to([] { return GetGlobalGameDataStorage().Resolve<data::game::CharacterTable>(ALBC_GAME_DATA_DB_CHARACTER_TABLE); }),
-        boost::di::bind<data::game::CharacterMetaTable>().to([] { return GetGlobalGameDataStorage().Resolve<data::game::CharacterMetaTable>(ALBC_GAME_DATA_DB_CHAR_META_TABLE); }),
-        boost::di::bind<data::game::ICharacterLookupTable>().to<data::game::CharacterLookupTable>(),
-        boost::di::bind<data::game::ISkillLookupTable>().to<data::game::SkillLookupTable>(),
-        boost::di::bind<data::game::ICharacterResolver>().to<data::game::CharacterResolver>(),
         boost::di::bind<algorithm::iface::IRunner>().to<algorithm::iface::MultiRoomIntegerProgramRunner>().in(boost::di::singleton),
         boost::di::bind<api::IJsonWriter>().to<api::JsonWriter>().in(boost::di::singleton),
         boost::di::bind<api::IJsonReader>().to<api::JsonReader>().in(boost::di::singleton));
@@ -32,20 +21,26 @@ static const auto& GetInjector()
 }
 #pragma clang diagnostic pop
 
+// 获取当前游戏数据版本。同一次调用中需要多张表时应只获取一次，以保证各表来自同一版本。
+inline std::shared_ptr<const GameDataTables> AcquireGameData()
+{
+    return GetGlobalGameDataRegistry().Acquire();
+}
+
 template <typename TGet>
 inline std::shared_ptr<TGet> Resolve()
 {
-    static std::atomic<UInt32> resource_version{UINT32_MAX};
-    static std::shared_ptr<TGet> instance;
-
     try
     {
-        if (resource_version != GetGlobalGameDataStorage().GetVersion())
+        if constexpr (GameDataTables::kProvides<TGet>)
+        {
+            return AcquireGameData()->Get<TGet>();
+        }
+        else
         {
-            instance = GetInjector().template create<std::shared_ptr<TGet>>();
-            resource_version = GetGlobalGameDataStorage().GetVersion();
+            static const auto instance = GetInjector().template create<std::shared_ptr<TGet>>();
+            return instance;
         }
-        return instance;
     }
     catch (const std::exception& e)
     {
@@ -53,4 +48,4 @@ inline std::shared_ptr<TGet> Resolve()
         throw;
     }
 }
-} // namespace albc::api::di
\ No newline at end of file
+} // namespace albc::api::di
@@ -0,0 +1,151 @@
+#include "api_flat_result.h"
+#include "albc/albc.h"
+
+#include <cstring>
+#include <stdexcept>
+
+namespace albc::api
+{
+namespace
+{
+constexpr size_t AlignUp(size_t n, size_t align)
+{
+    return (n + align - 1) / align * align;
+}
+
+// 两遍构造：第一遍只计算长度，第二遍写入
+class FlatStringTable
+{
+    char *base_ = nullptr;
+    size_t size_ = 0;
+
+  public:
+    void Bind(char *base)
+    {
+        base_ = base;
+        size_ = 0;
+    }
+
+    UInt32 Add(const char *str, size_t len)
+    {
+        const auto offset = static_cast<UInt32>(size_);
+        if (base_)
+        {
+            std::memcpy(base_ + size_, str, len);
+            base_[size_ + len] = '\0';
+        }
+        size_ += len + 1;
+        return offset;
+    }
+
+    UInt32 Add(const std::string &str)
+    {
+        return Add(str.c_str(), str.size());
+    }
+
+    [[nodiscard]] size_t Size() const
+    {
+        return size_;
+    }
+};
+} // namespace
+
+AlbcFlatResult *MakeFlatResult(int status, const algorithm::AlgorithmResult &result, const Vector<std::string> &errors,
+                               UInt32 flags)
+{
+    const bool with_readable_info = flags & ALBC_FLAT_RESULT_READABLE_INFO;
+
+    Vector<std::string> readable_infos;
+    if (with_readable_info)
+    {
+        readable_infos.reserve(result.rooms.size());
+        for (const auto &room_result : result.rooms)
+        {
+            readable_infos.emplace_back(
+                room_result.room->to_string().append("\n").append(room_result.solution.ToString()));
+        }
+    }
+
+    const auto write_strings = [&](FlatStringTable &strings, AlbcFlatRoomRecord *rooms, UInt32 *chars,
+                                   UInt32 *error_refs) -> UInt32 {
+        UInt32 char_idx = 0;
+        for (size_t i = 0; i < result.rooms.size(); ++i)
+        {
+            const auto &room_result = result.rooms[i];
+            const UInt32 id_ref = strings.Add(room_result.room->id);
+            const UInt32 info_ref = with_readable_info ? strings.Add(readable_infos[i]) : ALBC_FLAT_NO_STRING;
+            const UInt32 char_begin = char_idx;
+            for (const auto *op : room_result.solution.operators)
+            {
+                if (!op)
+                    continue;
+
+                const UInt32 op_ref = strings.Add(op->identifier);
+                if (chars)
+                    chars[char_idx] = op_ref;
+                ++char_idx;
+            }
+
+            if (rooms)
+            {
+                auto &record = rooms[i];
+                record.score = room_result.solution.productivity;
+                record.duration = room_result.solution.duration;
+                record.identifier = id_ref;
+                record.readable_info = info_ref;
+                record.char_begin = char_begin;
+                record.char_count = char_idx - char_begin;
+            }
+        }
+
+        for (size_t i = 0; i < errors.size(); ++i)
+        {
+            const UInt32 err_ref = strings.Add(errors[i]);
+            if (error_refs)
+                error_refs[i] = err_ref;
+        }
+        return char_idx;
+    };
+
+    // 第一遍：计算各段长度
+    FlatStringTable strings;
+    const UInt32 char_count = write_strings(strings, nullptr, nullptr, nullptr);
+    const auto room_count = static_cast<UInt32>(result.rooms.size());
+    const auto error_count = static_cast<UInt32>(errors.size());
+
+    const size_t room_offset = AlignUp(sizeof(AlbcFlatResult), alignof(AlbcFlatRoomRecord));
+    const size_t char_offset = room_offset + room_count * sizeof(AlbcFlatRoomRecord);
+    const size_t error_offset = char_offset + char_count * sizeof(UInt32);
+    const size_t string_offset = error_offset + error_count * sizeof(UInt32);
+    const size_t total_size = string_offset + strings.Size();
+
+    if (total_size > UINT32_MAX)
+        throw std::length_error("flat result is too large");
+
+    auto *buffer = static_cast<char *>(albc::malloc(total_size));
+    if (!buffer)
+        throw std::bad_alloc();
+
+    // 第二遍：写入
+    auto *header = reinterpret_cast<AlbcFlatResult *>(buffer);
+    header->version = ALBC_FLAT_RESULT_VERSION;
+    header->total_size = static_cast<UInt32>(total_size);
+    header->status = status;
+    header->flags = flags;
+    header->room_count = room_count;
+    header->room_offset = static_cast<UInt32>(room_offset);
+    header->char_count = char_count;
+    header->char_offset = static_cast<UInt32>(char_offset);
+    header->error_count = error_count;
+    header->error_offset = static_cast<UInt32>(error_offset);
+    header->string_offset = static_cast<UInt32>(string_offset);
+    header->string_size = static_cast<UInt32>(strings.Size());
+
+    strings.Bind(buffer + string_offset);
+    write_strings(strings,
+                  reinterpret_cast<AlbcFlatRoomRecord *>(buffer + room_offset),
+                  reinterpret_cast<UInt32 *>(buffer + char_offset),
+                  reinterpret_cast<UInt32 *>(buffer + error_offset));
+    return header;
+}
+} // namespace albc::api
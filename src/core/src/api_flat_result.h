@@ -0,0 +1,13 @@
+#pragma once
+#include "albc/albc_common.h"
+#include "albc_types.h"
+#include "algorithm_params.h"
+
+namespace albc::api
+{
+// 将算法结果打包为一块连续的缓冲区（见 AlbcFlatResult 的布局说明）。
+// 缓冲区由 albc::malloc 分配，需由 albc::free 释放。
+// flags 为 AlbcFlatResultFlags 的组合，仅在指定 ALBC_FLAT_RESULT_READABLE_INFO 时生成方案信息。
+AlbcFlatResult *MakeFlatResult(int status, const algorithm::AlgorithmResult &result, const Vector<std::string> &errors,
+                               UInt32 flags);
+} // namespace albc::api
@@ -4,6 +4,9 @@
 #include "api_impl.h"
 #include "albc/albc_common.h"
 #include "util_time.h"
+#include "api_capture.h"
+#include "api_flat_result.h"
+#include "util_mmap.h"
 
 namespace albc
 {
@@ -44,6 +47,10 @@ ICollection<IRoomResult *> *ResultImpl::GetRoomDetails() const noexcept
 {
     return rooms;
 }
+AlbcSolveStats ResultImpl::GetStats() const noexcept
+{
+    return stats;
+}
 ResultImpl::~ResultImpl()
 {
     mem::free_ptr_vector(*rooms);
@@ -222,18 +229,35 @@ void Room::Impl::EnsurePrepared() const
     if (!room_data_.has_value())
         throw std::runtime_error("Room not prepared: " + cached_identifier_);
 }
-Model::Impl::Impl(const Json::Value &player_data_json)
-    : player_data_(mem::make_unique_nothrow<data::player::PlayerDataModel>(player_data_json))
+Model::Impl::Impl(std::unique_ptr<data::player::PlayerDataModel> player_data)
+    : player_data_(std::move(player_data))
 {
     create_type_ = ModelCreateType::FROM_JSON;
 }
+static std::unique_ptr<data::player::PlayerDataModel> ParsePlayerData(std::string_view player_data_json)
+{
+    util::JsonStreamReader reader(player_data_json);
+    auto player_data = std::make_unique<data::player::PlayerDataModel>(reader);
+    reader.ExpectEnd();
+    return player_data;
+}
+Model::Impl *Model::Impl::CreateFromText(std::string_view player_data_json)
+{
+    auto impl = new Impl(ParsePlayerData(player_data_json));
+    if (api::capture::IsEnabled())
+        impl->player_data_source_ = util::read_json_from_char_array(player_data_json);
+
+    return impl;
+}
 Model::Impl *Model::Impl::CreateFromFile(const char *player_data_path)
 {
-    return new Impl(util::read_json_from_file(player_data_path));
+    // 直接在映射的页面上解析，模型只保留解析结果，返回前解除映射
+    const util::MappedFile file(player_data_path);
+    return CreateFromText(file.View());
 }
 Model::Impl *Model::Impl::CreateFromJson(const char *player_data_json)
 {
-    return new Impl(util::read_json_from_char_array(player_data_json));
+    return CreateFromText(player_data_json);
 }
 Model::Impl::Impl()
 {
@@ -275,12 +299,8 @@ void Model::Impl::EnsurePrepared() const
         character->impl()->EnsurePrepared();
     }
 }
-algorithm::iface::AlgorithmParams Model::Impl::CreateAlgParams() const
+algorithm::iface::CustomPackedInput Model::Impl::CreatePackedInput() const
 {
-    if (create_type_ == ModelCreateType::FROM_JSON)
-    {
-        return {*player_data_, *building_data_};
-    }
     EnsurePrepared();
     algorithm::iface::CustomPackedInput input;
     for (const auto& room : rooms_)
@@ -293,20 +313,28 @@ algorithm::iface::AlgorithmParams Model::Impl::CreateAlgParams() const
         input.characters.push_back(character->impl()->GetCharacterData().value());
     }
 
-    return { input, *building_data_ };
+    return input;
 }
-IResult *Model::Impl::GetResult() const
+algorithm::iface::AlgorithmParams Model::Impl::CreateAlgParams() const
+{
+    if (create_type_ == ModelCreateType::FROM_JSON)
+    {
+        return {*player_data_, *building_data_};
+    }
+
+    return { CreatePackedInput(), *building_data_ };
+}
+AlbcSolverParameters Model::Impl::CreateSolverParams() const
 {
-    using namespace algorithm::iface;
     using namespace algorithm;
 
-    AlgorithmParams params = CreateAlgParams();
-    LOG_D("Creating algorithm params: ", params.GetOperators().size(), " operators, ");
-    const auto sc = SCOPE_TIMER_WITH_TRACE("Solving");
-    const auto i_runner = api::di::Resolve<algorithm::iface::IRunner>();
     AlbcSolverParameters sp;
     sp.gen_lp_file = false;
     sp.gen_all_solution_details = false;
+    sp.alt_plan_count = 0;
+    sp.alt_exclusion_plans = false;
+    sp.shift_count = 1;
+    sp.rest_recovery = 0;
     sp.solve_time_limit = model_parameters[ALBC_MODEL_PARAM_SOLVE_TIME_LIMIT];
     sp.model_time_limit = model_parameters[ALBC_MODEL_PARAM_DURATION];
 
@@ -316,10 +344,21 @@ IResult *Model::Impl::GetResult() const
     if (sp.solve_time_limit <= 0)
         sp.solve_time_limit = kDefaultSolveTimeLimit;
 
-    AlgorithmResult alg_result;
-    i_runner->Run(params, sp, alg_result);
-
+    return sp;
+}
+void Model::Impl::RunAlgorithm(const algorithm::iface::AlgorithmParams &params,
+                               const AlbcSolverParameters &solver_params, const util::CancelToken *cancel_token,
+                               algorithm::AlgorithmResult &out_result)
+{
+    LOG_D("Creating algorithm params: ", params.GetOperators().size(), " operators, ");
+    const auto sc = SCOPE_TIMER_WITH_TRACE("Solving");
+    const auto i_runner = api::di::Resolve<algorithm::iface::IRunner>();
+    i_runner->Run(params, solver_params, out_result, cancel_token);
+}
+IResult *Model::Impl::MakeResult(const algorithm::AlgorithmResult &alg_result)
+{
     auto result = new ResultImpl(0, new ICollectionVectorImpl<IRoomResult *>());
+    result->stats = alg_result.stats.totals;
     for (const auto &alg_room_result : alg_result.rooms)
     {
         auto ops = new ICollectionVectorImpl<String>();
@@ -343,4 +382,86 @@ IResult *Model::Impl::GetResult() const
     }
     return result;
 }
+void Model::Impl::CaptureResult(const AlbcSolverParameters &solver_params,
+                                const algorithm::AlgorithmResult &alg_result) const
+{
+    if (!api::capture::IsEnabled())
+        return;
+
+    const auto game_data = api::di::AcquireGameData();
+    if (create_type_ == ModelCreateType::FROM_JSON)
+    {
+        api::capture::CaptureSolve(api::capture::CaptureKind::PLAYER_DATA, player_data_source_, nullptr,
+                                   solver_params, *game_data, alg_result);
+        return;
+    }
+
+    const auto input = CreatePackedInput();
+    api::capture::CaptureSolve(api::capture::CaptureKind::CUSTOM_MODEL, Json::Value(), &input, solver_params,
+                               *game_data, alg_result);
+}
+IResult *Model::Impl::Solve(const algorithm::iface::AlgorithmParams &params, const AlbcSolverParameters &solver_params,
+                            const util::CancelToken *cancel_token)
+{
+    algorithm::AlgorithmResult alg_result;
+    RunAlgorithm(params, solver_params, cancel_token, alg_result);
+    return MakeResult(alg_result);
+}
+IResult *Model::Impl::GetResult() const
+{
+    const util::CancelToken token(model_parameters[ALBC_MODEL_PARAM_DEADLINE]);
+    const algorithm::iface::AlgorithmParams params = CreateAlgParams();
+    const auto solver_params = CreateSolverParams();
+    algorithm::AlgorithmResult alg_result;
+    RunAlgorithm(params, solver_params, &token, alg_result);
+    CaptureResult(solver_params, alg_result);
+    return MakeResult(alg_result);
+}
+AlbcFlatResult *Model::Impl::GetFlatResult(UInt32 flags) const
+{
+    const util::CancelToken token(model_parameters[ALBC_MODEL_PARAM_DEADLINE]);
+    const algorithm::iface::AlgorithmParams params = CreateAlgParams();
+    const auto solver_params = CreateSolverParams();
+    algorithm::AlgorithmResult alg_result;
+    RunAlgorithm(params, solver_params, &token, alg_result);
+    CaptureResult(solver_params, alg_result);
+    return api::MakeFlatResult(0, alg_result, {}, flags);
+}
+IAsyncResult *Model::Impl::GetResultAsync(AlbcAsyncCallback callback, void *user_data) const
+{
+    auto task = std::make_unique<AsyncResultImpl>(callback, user_data, model_parameters[ALBC_MODEL_PARAM_DEADLINE]);
+
+    // 在调用线程中复制模型数据，工作线程不再访问模型本身
+    auto params = std::make_shared<algorithm::iface::AlgorithmParams>(CreateAlgParams());
+    auto solver_params = CreateSolverParams();
+    task->Start([params, solver_params](const util::CancelToken &token) {
+        return std::unique_ptr<IResult>(Solve(*params, solver_params, &token));
+    });
+    return task.release();
+}
+IResult *AsyncResultImpl::GetResult(AlbcException **e_ptr) noexcept
+{
+    try
+    {
+        std::unique_lock lock(state_->mutex);
+        EnsureSucceeded(lock);
+        if (!state_->value)
+            throw std::logic_error("result has already been taken");
+
+        return state_->value.release();
+    }
+    ALBC_API_CATCH_AND_TRANSLATE_EXCEPTION(e_ptr, "getting async result")
+    return nullptr;
+}
+String AsyncJsonResultImpl::GetResult(AlbcException **e_ptr) const noexcept
+{
+    try
+    {
+        std::unique_lock lock(state_->mutex);
+        EnsureSucceeded(lock);
+        return String{state_->value.c_str()};
+    }
+    ALBC_API_CATCH_AND_TRANSLATE_EXCEPTION(e_ptr, "getting async result")
+    return String("{}");
+}
 }
\ No newline at end of file
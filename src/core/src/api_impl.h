@@ -5,13 +5,18 @@
 #include "albc_types.h"
 #include "albc/albc.h"
 #include "util_locale.h"
+#include "util_cancel.h"
+#include "util_executor.h"
 
 #include "algorithm_iface.h"
 #include "algorithm_iface_params.h"
 #include "algorithm.h"
 #include "algorithm_consts.h"
 
+#include <condition_variable>
+#include <mutex>
 #include <numeric>
+#include <thread>
 
 namespace albc
 {
@@ -81,11 +86,13 @@ class ResultImpl: public IResult
   public:
     int status;
     ICollectionVectorImpl<IRoomResult*>*rooms;
+    AlbcSolveStats stats{};
 
     ResultImpl(int status_val, ICollectionVectorImpl<IRoomResult*>* rooms_val);
 
     [[nodiscard]] int GetStatus() const noexcept override;
     [[nodiscard]] ICollection<IRoomResult *>* GetRoomDetails() const noexcept override;
+    [[nodiscard]] AlbcSolveStats GetStats() const noexcept override;
     ~ResultImpl() override;
 };
 
@@ -113,10 +120,199 @@ class RoomResultImpl: public IRoomResult
     ~RoomResultImpl() noexcept override;
 };
 
+// 异步任务的共享状态，由句柄与工作线程共同持有，句柄先于任务释放时不会悬空
+template <typename TValue>
+struct AsyncTaskState
+{
+    util::CancelToken token;
+    std::mutex mutex;
+    std::condition_variable cv;
+    AlbcAsyncStatus status = ALBC_ASYNC_STATUS_PENDING;
+    TValue value{};
+    std::string error;
+    AlbcAsyncCallback callback = nullptr;
+    void *user_data = nullptr;
+    bool callback_done = false;
+    std::thread::id finish_thread; // 调用完成回调的线程
+
+    [[nodiscard]] static bool IsFinished(AlbcAsyncStatus status_val)
+    {
+        return status_val >= ALBC_ASYNC_STATUS_SUCCEEDED;
+    }
+
+    void Finish(AlbcAsyncStatus final_status)
+    {
+        {
+            std::lock_guard lock(mutex);
+            status = final_status;
+            finish_thread = std::this_thread::get_id();
+        }
+        cv.notify_all();
+
+        if (callback)
+            callback(final_status, user_data);
+
+        {
+            std::lock_guard lock(mutex);
+            callback_done = true;
+        }
+        cv.notify_all();
+    }
+};
+
+template <typename TBase, typename TValue>
+class AsyncTaskImpl : public TBase
+{
+  protected:
+    std::shared_ptr<AsyncTaskState<TValue>> state_ = std::make_shared<AsyncTaskState<TValue>>();
+
+  public:
+    AsyncTaskImpl(AlbcAsyncCallback callback, void *user_data, double deadline_sec)
+    {
+        state_->callback = callback;
+        state_->user_data = user_data;
+        state_->token.SetDeadline(deadline_sec);
+    }
+
+    // func: TValue(const util::CancelToken &)，在共享线程池（util::TaskExecutor）上执行，线程全忙时排队
+    template <typename TFunc>
+    void Start(TFunc &&func)
+    {
+        util::TaskExecutor::Shared().Submit([state = state_, func = std::forward<TFunc>(func)]() mutable {
+            {
+                std::lock_guard lock(state->mutex);
+                if (AsyncTaskState<TValue>::IsFinished(state->status))
+                    return; // 排队期间句柄已释放
+
+                state->status = ALBC_ASYNC_STATUS_RUNNING;
+            }
+
+            AlbcAsyncStatus final_status = ALBC_ASYNC_STATUS_SUCCEEDED;
+            try
+            {
+                state->token.ThrowIfStopped();
+                TValue value = func(state->token);
+                std::lock_guard lock(state->mutex);
+                state->value = std::move(value);
+            }
+            catch (const util::OperationCancelledException &e)
+            {
+                LOG_W("Async task stopped: ", e.what());
+                final_status = e.GetReason() == util::CancelReason::DEADLINE_EXCEEDED
+                                   ? ALBC_ASYNC_STATUS_DEADLINE_EXCEEDED
+                                   : ALBC_ASYNC_STATUS_CANCELLED;
+                std::lock_guard lock(state->mutex);
+                state->error = e.what();
+            }
+            catch (const std::exception &e)
+            {
+                LOG_E("Async task failed: ", e.what());
+                final_status = ALBC_ASYNC_STATUS_FAILED;
+                std::lock_guard lock(state->mutex);
+                state->error = e.what();
+            }
+            catch (...)
+            {
+                LOG_E("Async task failed: unknown exception");
+                final_status = ALBC_ASYNC_STATUS_FAILED;
+                std::lock_guard lock(state->mutex);
+                state->error = "Unknown exception";
+            }
+
+            state->Finish(final_status);
+        });
+    }
+
+    [[nodiscard]] AlbcAsyncStatus Poll() const noexcept override
+    {
+        std::lock_guard lock(state_->mutex);
+        return state_->status;
+    }
+
+    bool Wait(double timeout_sec) const noexcept override
+    {
+        std::unique_lock lock(state_->mutex);
+        const auto pred = [this] { return AsyncTaskState<TValue>::IsFinished(state_->status); };
+        if (timeout_sec < 0)
+        {
+            state_->cv.wait(lock, pred);
+            return true;
+        }
+
+        return state_->cv.wait_for(lock, util::FloatingSeconds(timeout_sec), pred);
+    }
+
+    void Cancel() noexcept override
+    {
+        state_->token.Cancel();
+    }
+
+    // 等待任务结束且完成回调返回；仍在排队的任务直接以 CANCELLED 结束，不等待排在前面的任务
+    ~AsyncTaskImpl() noexcept override
+    {
+        Cancel();
+        std::unique_lock lock(state_->mutex);
+        if (state_->status == ALBC_ASYNC_STATUS_PENDING)
+        {
+            state_->status = ALBC_ASYNC_STATUS_CANCELLED; // 工作线程取到任务时不再执行
+            state_->error = "Async task cancelled before it started";
+            lock.unlock();
+            state_->Finish(ALBC_ASYNC_STATUS_CANCELLED);
+            return;
+        }
+
+        // 在完成回调中释放句柄时不能等待自身
+        if (AsyncTaskState<TValue>::IsFinished(state_->status) &&
+            state_->finish_thread == std::this_thread::get_id())
+            return;
+
+        state_->cv.wait(lock, [this] { return state_->callback_done; });
+    }
+
+  protected:
+    // 获取结果前检查状态，未成功结束则抛出对应的异常
+    void EnsureSucceeded(std::unique_lock<std::mutex> &lock) const
+    {
+        (void)lock;
+        switch (state_->status)
+        {
+        case ALBC_ASYNC_STATUS_SUCCEEDED:
+            return;
+        case ALBC_ASYNC_STATUS_CANCELLED:
+            throw util::OperationCancelledException(util::CancelReason::CANCELLED);
+        case ALBC_ASYNC_STATUS_DEADLINE_EXCEEDED:
+            throw util::OperationCancelledException(util::CancelReason::DEADLINE_EXCEEDED);
+        case ALBC_ASYNC_STATUS_FAILED:
+            throw std::runtime_error(state_->error);
+        default:
+            throw std::logic_error("async task has not finished yet");
+        }
+    }
+};
+
+class AsyncResultImpl : public AsyncTaskImpl<IAsyncResult, std::unique_ptr<IResult>>
+{
+  public:
+    using AsyncTaskImpl::AsyncTaskImpl;
+
+    [[nodiscard]] IResult *GetResult(AlbcException **e_ptr) noexcept override;
+};
+
+class AsyncJsonResultImpl : public AsyncTaskImpl<IAsyncJsonResult, std::string>
+{
+  public:
+    using AsyncTaskImpl::AsyncTaskImpl;
+
+    [[nodiscard]] String GetResult(AlbcException **e_ptr) const noexcept override;
+};
+
 class Character::Impl
 {
-    algorithm::iface::CustomCharacter character_ {api::di::Resolve<data::game::ICharacterResolver>(),
-                                       api::di::Resolve<data::game::CharacterMetaTable>()};
+    algorithm::iface::CustomCharacter character_ = [] {
+        const auto game_data = api::di::AcquireGameData();
+        return algorithm::iface::CustomCharacter(game_data->Get<data::game::ICharacterResolver>(),
+                                                 game_data->Get<data::game::CharacterMetaTable>());
+    }();
 
     std::optional<algorithm::iface::CustomCharacterData> character_data_;
     std::string cached_identifier_;
@@ -180,6 +376,7 @@ class Model::Impl
 
     std::shared_ptr<data::building::BuildingData> building_data_ = api::di::Resolve<data::building::BuildingData>();
     std::unique_ptr<data::player::PlayerDataModel> player_data_;
+    Json::Value player_data_source_; // 原始玩家数据，仅在创建时已开启请求捕获时保留
     Vector<Character*> characters_;
     Vector<Room*> rooms_;
     ModelCreateType create_type_;
@@ -187,7 +384,9 @@ class Model::Impl
   public:
     Array<double, util::enum_size<AlbcModelParamType>::value> model_parameters{};
 
-    explicit Impl(const Json::Value &player_data_json);
+    explicit Impl(std::unique_ptr<data::player::PlayerDataModel> player_data);
+
+    static Impl* CreateFromText(std::string_view player_data_json);
 
     static Impl* CreateFromFile(const char *player_data_path);
 
@@ -207,9 +406,30 @@ class Model::Impl
 
     void EnsurePrepared() const;
 
+    [[nodiscard]] algorithm::iface::CustomPackedInput CreatePackedInput() const;
+
     [[nodiscard]] algorithm::iface::AlgorithmParams CreateAlgParams() const;
 
+    [[nodiscard]] AlbcSolverParameters CreateSolverParams() const;
+
+    static void RunAlgorithm(const algorithm::iface::AlgorithmParams &params,
+                             const AlbcSolverParameters &solver_params,
+                             const util::CancelToken *cancel_token,
+                             algorithm::AlgorithmResult &out_result);
+
+    [[nodiscard]] static IResult *MakeResult(const algorithm::AlgorithmResult &alg_result);
+
+    void CaptureResult(const AlbcSolverParameters &solver_params, const algorithm::AlgorithmResult &alg_result) const;
+
+    [[nodiscard]] static IResult *Solve(const algorithm::iface::AlgorithmParams &params,
+                                        const AlbcSolverParameters &solver_params,
+                                        const util::CancelToken *cancel_token);
+
     [[nodiscard]] IResult *GetResult() const;
+
+    [[nodiscard]] AlbcFlatResult *GetFlatResult(UInt32 flags) const;
+
+    [[nodiscard]] IAsyncResult *GetResultAsync(AlbcAsyncCallback callback, void *user_data) const;
 };
 
 }
\ No newline at end of file
@@ -2,6 +2,7 @@
 // Created by Nonary on 2022/4/24.
 //
 #include "api_json_params.h"
+#include "albc/albc_common.h"
 #include "data_building.h"
 #include "model_buff_primitives.h"
 
@@ -56,13 +57,24 @@ JsonInRoomStruct::JsonInRoomStruct(const Json::Value &val)
 JsonInParams::JsonInParams(const Json::Value &val)
     : model_time_limit(val.get(kModelTimeLimit, 3600 * 16).asInt()),
       solve_time_limit(val.get(kSolveTimeLimit, 60).asInt()),
+      deadline(val.get(kDeadline, 0).asDouble()),
       gen_sol_details(val.get(kGenSolDetails, false).asBool()),
       gen_lp_file(val.get(kGenLpFile, false).asBool()),
-      chars(util::json_val_as_dictionary<JsonInCharStruct>(
+      alt_plan_count(val.get(kAltPlanCount, 0).asInt()),
+      alt_exclusion_plans(val.get(kAltExclusionPlans, false).asBool()),
+      shift_count(val.get(kShiftCount, 1).asInt()),
+      rest_recovery(val.get(kRestRecovery, 0).asDouble()),
+      chars(util::json_val_as_map<decltype(chars)>(
           val.get(kChars, Json::Value(Json::objectValue)))),
-      rooms(util::json_val_as_dictionary<JsonInRoomStruct>(
+      rooms(util::json_val_as_map<decltype(rooms)>(
           val.get(kRooms, Json::Value(Json::objectValue))))
 {
+    if (alt_plan_count < 0 || alt_plan_count > ALBC_MAX_ALT_PLAN_COUNT)
+        throw std::invalid_argument("invalid argument: " + std::string(kAltPlanCount) + " must be between 0 and " +
+                                    std::to_string(ALBC_MAX_ALT_PLAN_COUNT) + ", got " + std::to_string(alt_plan_count));
+    if (shift_count < 1 || shift_count > ALBC_MAX_SHIFT_COUNT)
+        throw std::invalid_argument("invalid argument: " + std::string(kShiftCount) + " must be between 1 and " +
+                                    std::to_string(ALBC_MAX_SHIFT_COUNT) + ", got " + std::to_string(shift_count));
 }
 JsonOutRoomStruct::operator Json::Value() const
 {
@@ -72,11 +84,79 @@ JsonOutRoomStruct::operator Json::Value() const
     val[kChars] = util::json_val_from_vector<std::string>(chars);
     return val;
 }
+JsonOutPlanStruct::operator Json::Value() const
+{
+    Json::Value val;
+    val[kObjective] = objective;
+    val[kSolveTime] = solve_time;
+    val[kOptimal] = optimal;
+    if (!excluded.empty())
+        val[kExcluded] = excluded;
+    val[kRooms] = util::json_val_from_dictionary<JsonOutRoomStruct>(rooms, util::to_json_cast<JsonOutRoomStruct>);
+    return val;
+}
 JsonOutParams::operator Json::Value() const
 {
     Json::Value val;
     val[kRooms] = util::json_val_from_dictionary<JsonOutRoomStruct>(rooms, util::to_json_cast<JsonOutRoomStruct>);
     val[kErrors] = static_cast<Json::Value>(errors);
+    val[kStats] = static_cast<Json::Value>(stats);
+    if (!alternatives.empty())
+        val[kAlternatives] = util::json_val_from_vector<JsonOutPlanStruct>(alternatives, util::to_json_cast<JsonOutPlanStruct>);
+    if (!shifts.empty())
+    {
+        Json::Value shifts_val(Json::arrayValue);
+        for (const auto &shift_rooms : shifts)
+            shifts_val.append(util::json_val_from_dictionary<JsonOutRoomStruct>(shift_rooms, util::to_json_cast<JsonOutRoomStruct>));
+        val[kShifts] = shifts_val;
+    }
+    return val;
+}
+JsonOutStatsStruct::operator Json::Value() const
+{
+    const auto &t = totals;
+    Json::Value val;
+    val[kDataFeedTime] = t.data_feed_time;
+    val[kFilterTime] = t.filter_time;
+    val[kEnumTime] = t.enum_time;
+    val[kSolveTime] = t.solve_time;
+    val[kTotalTime] = t.total_time;
+    val[kGap] = t.gap;
+    val[kCalcCnt] = static_cast<Json::UInt64>(t.calc_cnt);
+    val[kMatrixNnz] = static_cast<Json::UInt64>(t.matrix_nnz);
+    val[kPeakMemory] = static_cast<Json::UInt64>(t.peak_memory);
+    val[kColCnt] = t.col_cnt;
+    val[kRowCnt] = t.row_cnt;
+    val[kNodeCnt] = t.node_cnt;
+    val[kLpIterations] = t.lp_iterations;
+
+    Json::Value rooms_val(Json::arrayValue);
+    for (const auto &room : rooms)
+    {
+        Json::Value room_val;
+        room_val[kRoomId] = room.room_id;
+        room_val[kFilterTime] = room.filter_time;
+        room_val[kEnumTime] = room.enum_time;
+        room_val[kInboundOps] = room.inbound_ops;
+        room_val[kCalcCnt] = static_cast<Json::UInt64>(room.calc_cnt);
+        room_val[kColCnt] = room.col_cnt;
+        rooms_val.append(std::move(room_val));
+    }
+    val[kRooms] = std::move(rooms_val);
+
+    Json::Value memory_val;
+    memory_val[kHeapAccounting] = mem::IsHeapAccountingEnabled();
+    for (size_t i = 0; i < mem::kMemPhaseCount; ++i)
+    {
+        const auto &counters = memory[i];
+        Json::Value phase_val;
+        phase_val[kAllocCnt] = static_cast<Json::UInt64>(counters.alloc_cnt);
+        phase_val[kAllocBytes] = static_cast<Json::UInt64>(counters.alloc_bytes);
+        phase_val[kPeakBytes] = static_cast<Json::UInt64>(counters.peak_bytes);
+        phase_val[kNetBytes] = static_cast<Json::Int64>(counters.net_bytes);
+        memory_val[mem::GetMemPhaseName(static_cast<mem::MemPhase>(i))] = std::move(phase_val);
+    }
+    val[kMemory] = std::move(memory_val);
     return val;
 }
 JsonOutErrorStruct::operator Json::Value() const
@@ -1,5 +1,6 @@
 #pragma once
 #include "util_json.h"
+#include "algorithm_stats.h"
 #include "data_building.h"
 #include "model_buff_primitives.h"
 #define ALBC_API_JSON_KEY(name, key) constexpr static const char* name = key
@@ -82,10 +83,16 @@ struct JsonInParams
 {
     int model_time_limit;                                 ALBC_API_JSON_KEY(kModelTimeLimit, "modelTimeLimit");
     int solve_time_limit;                                 ALBC_API_JSON_KEY(kSolveTimeLimit, "solveTimeLimit");
+    double deadline;                                      ALBC_API_JSON_KEY(kDeadline, "deadline"); // 整体截止时间（秒），<=0为不限
     bool gen_sol_details;                                 ALBC_API_JSON_KEY(kGenSolDetails, "genSolDetails");
     bool gen_lp_file;                                     ALBC_API_JSON_KEY(kGenLpFile, "genLpFile");
-    Dictionary<std::string, JsonInCharStruct> chars;      ALBC_API_JSON_KEY(kChars, "chars");
-    Dictionary<std::string, JsonInRoomStruct> rooms;      ALBC_API_JSON_KEY(kRooms, "rooms");
+    int alt_plan_count;                                   ALBC_API_JSON_KEY(kAltPlanCount, "altPlans"); // 次优方案数，取 0 到 ALBC_MAX_ALT_PLAN_COUNT
+    bool alt_exclusion_plans;                             ALBC_API_JSON_KEY(kAltExclusionPlans, "altExclusionPlans");
+    int shift_count;                                      ALBC_API_JSON_KEY(kShiftCount, "shifts"); // 班次数，每班长 modelTimeLimit，取 1 到 ALBC_MAX_SHIFT_COUNT
+    double rest_recovery;                                 ALBC_API_JSON_KEY(kRestRecovery, "restRecovery"); // 每休息一班恢复的可工作时间（秒）
+    SmallDictionary<std::string, JsonInCharStruct> chars; ALBC_API_JSON_KEY(kChars, "chars");
+    SmallDictionary<std::string, JsonInRoomStruct> rooms; ALBC_API_JSON_KEY(kRooms, "rooms");
+    Json::Value source;                                   // 原始请求，仅在开启请求捕获时保留
 
     explicit JsonInParams(const Json::Value& val);
 };
@@ -100,20 +107,72 @@ struct JsonOutRoomStruct
     explicit operator Json::Value() const;
 };
 
+struct JsonOutPlanStruct
+{
+    double objective = 0;                                  ALBC_API_JSON_KEY(kObjective, "objective");
+    double solve_time = 0;                                 ALBC_API_JSON_KEY(kSolveTime, "solve_time");
+    bool optimal = false;                                  ALBC_API_JSON_KEY(kOptimal, "optimal"); // 为 false 时是超时求解给出的可行解
+    std::string excluded;                                  ALBC_API_JSON_KEY(kExcluded, "excluded"); // 为空时不输出
+    SmallDictionary<std::string, JsonOutRoomStruct> rooms; ALBC_API_JSON_KEY(kRooms, "rooms");
+
+    JsonOutPlanStruct() = default;
+    explicit operator Json::Value() const;
+};
+
 struct JsonOutErrorStruct
 {
-    Dictionary<std::string, std::string> chars;          ALBC_API_JSON_KEY(kChars, "chars");
-    Dictionary<std::string, std::string> rooms;          ALBC_API_JSON_KEY(kRooms, "rooms");
+    SmallDictionary<std::string, std::string> chars;      ALBC_API_JSON_KEY(kChars, "chars");
+    SmallDictionary<std::string, std::string> rooms;      ALBC_API_JSON_KEY(kRooms, "rooms");
     Vector<std::string> errors;                          ALBC_API_JSON_KEY(kError, "errors");
 
     JsonOutErrorStruct() = default;
     explicit operator Json::Value() const;
 };
 
+struct JsonOutStatsStruct
+{
+    AlbcSolveStats totals{};
+    Vector<algorithm::RoomSolveStats> rooms;
+
+    ALBC_API_JSON_KEY(kDataFeedTime, "data_feed_time");
+    ALBC_API_JSON_KEY(kFilterTime, "filter_time");
+    ALBC_API_JSON_KEY(kEnumTime, "enum_time");
+    ALBC_API_JSON_KEY(kSolveTime, "solve_time");
+    ALBC_API_JSON_KEY(kTotalTime, "total_time");
+    ALBC_API_JSON_KEY(kGap, "gap");
+    ALBC_API_JSON_KEY(kCalcCnt, "calc_cnt");
+    ALBC_API_JSON_KEY(kMatrixNnz, "matrix_nnz");
+    ALBC_API_JSON_KEY(kPeakMemory, "peak_memory");
+    ALBC_API_JSON_KEY(kColCnt, "col_cnt");
+    ALBC_API_JSON_KEY(kRowCnt, "row_cnt");
+    ALBC_API_JSON_KEY(kNodeCnt, "node_cnt");
+    ALBC_API_JSON_KEY(kLpIterations, "lp_iterations");
+    ALBC_API_JSON_KEY(kRooms, "rooms");
+    ALBC_API_JSON_KEY(kRoomId, "id");
+    ALBC_API_JSON_KEY(kInboundOps, "inbound_ops");
+    mem::MemPhaseStats memory{};
+    ALBC_API_JSON_KEY(kMemory, "memory");
+    ALBC_API_JSON_KEY(kHeapAccounting, "heap_accounting"); // 为 false 时只统计了 Arena 的内存块
+    ALBC_API_JSON_KEY(kAllocCnt, "alloc_cnt");
+    ALBC_API_JSON_KEY(kAllocBytes, "alloc_bytes");
+    ALBC_API_JSON_KEY(kPeakBytes, "peak_bytes");
+    ALBC_API_JSON_KEY(kNetBytes, "net_bytes");
+
+    JsonOutStatsStruct() = default;
+    explicit JsonOutStatsStruct(const algorithm::SolveStats &stats)
+        : totals(stats.totals), rooms(stats.rooms), memory(stats.memory)
+    {
+    }
+    explicit operator Json::Value() const;
+};
+
 struct JsonOutParams
 {
-    Dictionary<std::string, JsonOutRoomStruct> rooms;    ALBC_API_JSON_KEY(kRooms, "rooms");
+    SmallDictionary<std::string, JsonOutRoomStruct> rooms; ALBC_API_JSON_KEY(kRooms, "rooms");
     JsonOutErrorStruct errors;                           ALBC_API_JSON_KEY(kErrors, "errors");
+    JsonOutStatsStruct stats;                            ALBC_API_JSON_KEY(kStats, "stats");
+    Vector<JsonOutPlanStruct> alternatives;              ALBC_API_JSON_KEY(kAlternatives, "alternatives"); // 为空时不输出
+    Vector<SmallDictionary<std::string, JsonOutRoomStruct>> shifts; ALBC_API_JSON_KEY(kShifts, "shifts"); // 多班次时各班次的房间，为空时不输出
 
     JsonOutParams() = default;
     explicit operator Json::Value() const;
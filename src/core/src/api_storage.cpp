@@ -0,0 +1,147 @@
+#include "api_storage.h"
+#include "data_snapshot.h"
+#include "util_json_stream.h"
+#include "util_time.h"
+
+namespace albc::api
+{
+GameDataRegistry::GameDataRegistry() : current_(std::make_shared<const GameDataTables>())
+{
+}
+void GameDataRegistry::Publish(GameDataUpdate update)
+{
+    std::lock_guard lock(writer_mutex_);
+    auto next = std::make_shared<GameDataTables>(*Acquire());
+    ++next->generation;
+
+    const bool building_changed = update.building_data != nullptr;
+    const bool character_changed = update.character_table != nullptr;
+    if (building_changed)
+    {
+        next->building_data = std::move(update.building_data);
+        next->building_data_hash = update.building_data_hash;
+    }
+    if (character_changed)
+    {
+        next->character_table = std::move(update.character_table);
+        next->character_table_hash = update.character_table_hash;
+    }
+    if (update.char_meta_table)
+    {
+        next->char_meta_table = std::move(update.char_meta_table); // 没有派生表依赖它
+        next->char_meta_table_hash = update.char_meta_table_hash;
+    }
+
+    if (character_changed)
+    {
+        const auto sc = SCOPE_TIMER_WITH_TRACE("Building character lookup table");
+        next->character_lookup_table = std::make_shared<data::game::CharacterLookupTable>(next->character_table);
+    }
+
+    const bool skill_changed = building_changed || character_changed || update.prebuilt_skill_lookup_table;
+    if (update.prebuilt_skill_lookup_table)
+    {
+        next->skill_lookup_table = std::move(update.prebuilt_skill_lookup_table);
+    }
+    else if (skill_changed)
+    {
+        next->skill_lookup_table = nullptr;
+        if (next->building_data && next->character_lookup_table)
+        {
+            const auto sc = SCOPE_TIMER_WITH_TRACE("Building skill lookup table");
+            next->skill_lookup_table = std::make_shared<data::game::SkillLookupTable>(
+                next->building_data, next->character_lookup_table);
+        }
+    }
+
+    if (skill_changed || character_changed)
+    {
+        next->character_resolver = nullptr;
+        if (next->skill_lookup_table && next->character_lookup_table)
+            next->character_resolver = std::make_shared<data::game::CharacterResolver>(
+                next->skill_lookup_table, next->character_lookup_table);
+    }
+
+    std::atomic_store_explicit(&current_, std::shared_ptr<const GameDataTables>(std::move(next)),
+                               std::memory_order_release);
+}
+void GameDataRegistry::Clear()
+{
+    std::lock_guard lock(writer_mutex_);
+    auto next = std::make_shared<GameDataTables>();
+    next->generation = Acquire()->generation + 1;
+    std::atomic_store_explicit(&current_, std::shared_ptr<const GameDataTables>(std::move(next)),
+                               std::memory_order_release);
+}
+
+template <typename T> static std::shared_ptr<T> ParseGameData(std::string_view text)
+{
+    util::JsonStreamReader reader(text);
+    auto value = std::make_shared<T>(reader);
+    reader.ExpectEnd();
+    return value;
+}
+
+void LoadGameData(GameDataRegistry &registry, AlbcGameDataDbType data_type, std::string_view text)
+{
+    const auto sc = SCOPE_TIMER_WITH_TRACE("Loading game data");
+
+    // 解析在写者锁之外进行，只有派生表的重建与发布是串行的
+    GameDataUpdate update;
+    switch (data_type)
+    {
+    case ALBC_GAME_DATA_DB_BUILDING_DATA:
+        update.building_data = ParseGameData<data::building::BuildingData>(text);
+        update.building_data_hash = util::Fnv1a64(text);
+        break;
+
+    case ALBC_GAME_DATA_DB_CHARACTER_TABLE:
+        update.character_table = ParseGameData<data::game::CharacterTable>(text);
+        update.character_table_hash = util::Fnv1a64(text);
+        break;
+
+    case ALBC_GAME_DATA_DB_CHAR_META_TABLE:
+        update.char_meta_table = ParseGameData<data::game::CharacterMetaTable>(text);
+        update.char_meta_table_hash = util::Fnv1a64(text);
+        break;
+
+    default:
+        throw std::invalid_argument("Unknown game data type: " + std::to_string(static_cast<int>(data_type)));
+    }
+
+    registry.Publish(std::move(update));
+}
+std::string CompileGameDataSnapshot(const GameDataTables &tables)
+{
+    const auto sc = SCOPE_TIMER_WITH_TRACE("Compiling game data snapshot");
+    data::GameDataSnapshot snapshot;
+    snapshot.building_data = tables.building_data;
+    snapshot.character_table = tables.character_table;
+    snapshot.char_meta_table = tables.char_meta_table;
+    snapshot.skill_lookup_table = tables.skill_lookup_table;
+    snapshot.building_data_hash = tables.building_data_hash;
+    snapshot.character_table_hash = tables.character_table_hash;
+    snapshot.char_meta_table_hash = tables.char_meta_table_hash;
+
+    if (!snapshot.skill_lookup_table)
+        LOG_W("Character table or building data not loaded, skill lookup table will not be included in the snapshot.");
+
+    return data::SerializeGameDataSnapshot(snapshot);
+}
+void LoadGameDataSnapshot(GameDataRegistry &registry, std::string_view image)
+{
+    const auto sc = SCOPE_TIMER_WITH_TRACE("Loading game data snapshot");
+    auto snapshot = data::DeserializeGameDataSnapshot(image);
+
+    // 镜像已完整校验并解码后才发布
+    GameDataUpdate update;
+    update.building_data = std::move(snapshot.building_data);
+    update.character_table = std::move(snapshot.character_table);
+    update.char_meta_table = std::move(snapshot.char_meta_table);
+    update.prebuilt_skill_lookup_table = std::move(snapshot.skill_lookup_table);
+    update.building_data_hash = snapshot.building_data_hash;
+    update.character_table_hash = snapshot.character_table_hash;
+    update.char_meta_table_hash = snapshot.char_meta_table_hash;
+    registry.Publish(std::move(update));
+}
+} // namespace albc::api
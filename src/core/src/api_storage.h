@@ -1,11 +1,144 @@
 #pragma once
-#include "api_resource.h"
+#include "albc/albc_common.h"
+#include "albc_types.h"
+#include "data_building.h"
+#include "data_character_lookup_table.h"
+#include "data_character_meta_table.h"
+#include "data_character_resolver.h"
+#include "data_character_table.h"
+#include "data_skill_lookup_table.h"
+#include "util.h"
+
+#include <atomic>
+#include <mutex>
 
 namespace albc::api
 {
-inline GameDataJsonStorage& GetGlobalGameDataStorage()
+// 游戏数据的一个不可变版本：源数据及由其构建的查询表。
+// 发布后不再修改，读者持有 shared_ptr 即可在整个调用期间看到一致的数据，不受并发重新载入影响。
+struct GameDataTables
+{
+    UInt64 generation = 0;
+
+    // 源数据
+    std::shared_ptr<data::building::BuildingData> building_data;
+    std::shared_ptr<data::game::CharacterTable> character_table;
+    std::shared_ptr<data::game::CharacterMetaTable> char_meta_table;
+
+    // 源 JSON 的 FNV-1a 哈希，标识各部分数据的版本，未载入时为0
+    UInt64 building_data_hash = 0;
+    UInt64 character_table_hash = 0;
+    UInt64 char_meta_table_hash = 0;
+
+    // 派生表，仅在其依赖的源数据都已载入时构建：
+    // character_lookup_table <- character_table
+    // skill_lookup_table     <- building_data, character_lookup_table
+    // character_resolver     <- skill_lookup_table, character_lookup_table
+    std::shared_ptr<data::game::CharacterLookupTable> character_lookup_table;
+    std::shared_ptr<data::game::SkillLookupTable> skill_lookup_table;
+    std::shared_ptr<data::game::CharacterResolver> character_resolver;
+
+    template <typename T>
+    static constexpr bool kProvides =
+        std::is_same_v<T, data::building::BuildingData> || std::is_same_v<T, data::game::CharacterTable> ||
+        std::is_same_v<T, data::game::CharacterMetaTable> || std::is_same_v<T, data::game::ICharacterLookupTable> ||
+        std::is_same_v<T, data::game::ISkillLookupTable> || std::is_same_v<T, data::game::ICharacterResolver>;
+
+    // 获取指定类型的表，未载入时抛出异常
+    template <typename T, ALBC_REQUIRES(kProvides<T>)> std::shared_ptr<T> Get() const
+    {
+        std::shared_ptr<T> result;
+        const char *requires_data;
+        if constexpr (std::is_same_v<T, data::building::BuildingData>)
+        {
+            result = building_data;
+            requires_data = "building data";
+        }
+        else if constexpr (std::is_same_v<T, data::game::CharacterTable>)
+        {
+            result = character_table;
+            requires_data = "character table";
+        }
+        else if constexpr (std::is_same_v<T, data::game::CharacterMetaTable>)
+        {
+            result = char_meta_table;
+            requires_data = "char meta table";
+        }
+        else if constexpr (std::is_same_v<T, data::game::ICharacterLookupTable>)
+        {
+            result = character_lookup_table;
+            requires_data = "character table";
+        }
+        else if constexpr (std::is_same_v<T, data::game::ISkillLookupTable>)
+        {
+            result = skill_lookup_table;
+            requires_data = "building data and character table";
+        }
+        else
+        {
+            result = character_resolver;
+            requires_data = "building data and character table";
+        }
+
+        if (!result)
+        {
+            throw std::runtime_error(std::string("Resource of type: ")
+                                         .append(util::TypeName<T>())
+                                         .append(" not resolvable: requires ")
+                                         .append(requires_data)
+                                         .append(" to be loaded"));
+        }
+        return result;
+    }
+};
+
+// 一次发布中要替换的源数据，为空的成员保持不变
+struct GameDataUpdate
+{
+    std::shared_ptr<data::building::BuildingData> building_data;
+    std::shared_ptr<data::game::CharacterTable> character_table;
+    std::shared_ptr<data::game::CharacterMetaTable> char_meta_table;
+    UInt64 building_data_hash = 0;
+    UInt64 character_table_hash = 0;
+    UInt64 char_meta_table_hash = 0;
+
+    // 随源数据一同载入的预构建技能查询表（来自快照），提供时不再重新构建
+    std::shared_ptr<data::game::SkillLookupTable> prebuilt_skill_lookup_table;
+};
+
+// RCU 式的游戏数据注册表：读者原子地取得当前版本，不等待写者；
+// 写者复制当前版本，替换变动的源数据，只重建依赖它的派生表，再原子地发布新版本。写者之间串行。
+class GameDataRegistry
+{
+  public:
+    GameDataRegistry();
+
+    [[nodiscard]] std::shared_ptr<const GameDataTables> Acquire() const noexcept
+    {
+        return std::atomic_load_explicit(&current_, std::memory_order_acquire);
+    }
+
+    void Publish(GameDataUpdate update);
+
+    void Clear();
+
+  private:
+    std::shared_ptr<const GameDataTables> current_;
+    std::mutex writer_mutex_;
+};
+
+inline GameDataRegistry& GetGlobalGameDataRegistry()
 {
-    static GameDataJsonStorage api_global_gamedata_storage;
-    return api_global_gamedata_storage;
+    static GameDataRegistry api_global_gamedata_registry;
+    return api_global_gamedata_registry;
+}
+
+// 流式解析 json 文本并发布到 registry，text 只需在调用期间有效
+void LoadGameData(GameDataRegistry &registry, AlbcGameDataDbType data_type, std::string_view text);
+
+// 将当前已载入的游戏数据连同技能查询表序列化为快照镜像
+std::string CompileGameDataSnapshot(const GameDataTables &tables);
+
+// 从快照镜像载入游戏数据，镜像中包含的部分覆盖已载入的对应数据
+void LoadGameDataSnapshot(GameDataRegistry &registry, std::string_view image);
 }
-}
\ No newline at end of file
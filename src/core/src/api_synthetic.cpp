@@ -0,0 +1,450 @@
+#include "api_synthetic.h"
+#include "model_buff_map.h"
+#include "util_flag.h"
+
+#include <algorithm>
+#include <random>
+
+namespace albc::api
+{
+namespace
+{
+using data::building::RoomType;
+using model::buff::OrderType;
+using model::buff::ProdType;
+
+enum SyntheticCharCategory
+{
+    MANUFACTURE_CHAR,
+    TRADING_CHAR,
+    OTHER_CHAR,
+    CHAR_CATEGORY_COUNT
+};
+
+struct SyntheticChar
+{
+    std::string identifier;
+    std::string char_id;
+    int phase = 2;
+    int level = 90;
+    double morale = 24;
+};
+
+struct SyntheticRoom
+{
+    std::string id;
+    RoomType type = RoomType::NONE;
+    int level = 3;
+    ProdType prod_type = ProdType::UNDEFINED;
+    OrderType order_type = OrderType::UNDEFINED;
+};
+
+struct SyntheticBase
+{
+    Vector<SyntheticChar> chars;
+    Vector<SyntheticRoom> rooms;
+};
+
+// 不使用标准库的分布：其实现因平台而异，同一种子需要在各平台上生成相同的输入
+class SyntheticRandom
+{
+  public:
+    explicit SyntheticRandom(UInt32 seed) : rng_(seed)
+    {
+    }
+
+    // [0, 1)
+    double NextReal()
+    {
+        return static_cast<double>(rng_()) / 4294967296.;
+    }
+
+    // [lo, hi]
+    int NextInt(int lo, int hi)
+    {
+        return hi <= lo ? lo : lo + static_cast<int>(rng_() % static_cast<UInt32>(hi - lo + 1));
+    }
+
+  private:
+    std::mt19937 rng_;
+};
+
+// 按已实现Buff作用的设施对干员分类，取第一个已实现的Buff
+SyntheticCharCategory ClassifyChar(const data::building::BuildingCharacter &building_char,
+                                   const data::building::BuildingData &building_data)
+{
+    for (const auto &slot : building_char.buff_char)
+    {
+        for (const auto &item : slot->buff_data)
+        {
+            const auto *buff = building_data.FindBuff(item.buff_atom);
+            if (!buff || !model::buff::BuffMap::Contains(item.buff_id))
+                continue;
+
+            if (util::check_flag(buff->room_type, RoomType::MANUFACTURE))
+                return MANUFACTURE_CHAR;
+            if (util::check_flag(buff->room_type, RoomType::TRADING))
+                return TRADING_CHAR;
+        }
+    }
+    return OTHER_CHAR;
+}
+
+int GenSlotCount(const SyntheticConfig &config, SyntheticRandom &random)
+{
+    const int min_slot_cnt = std::max(1, config.min_slot_count);
+    return random.NextInt(min_slot_cnt, std::max(min_slot_cnt, config.max_slot_count));
+}
+
+Vector<SyntheticRoom> GenRooms(const SyntheticConfig &config, SyntheticRandom &random)
+{
+    if (config.manufacture_room_count > 0 && config.prod_types.empty())
+        throw std::invalid_argument("synthetic config: prodTypes must not be empty");
+    if (config.trading_room_count > 0 && config.order_types.empty())
+        throw std::invalid_argument("synthetic config: orderTypes must not be empty");
+
+    Vector<SyntheticRoom> rooms;
+    int slot_id = 0;
+    for (int i = 0; i < config.manufacture_room_count; ++i)
+    {
+        auto &room = rooms.emplace_back();
+        room.id = "slot_" + std::to_string(++slot_id);
+        room.type = RoomType::MANUFACTURE;
+        room.level = GenSlotCount(config, random);
+        room.prod_type = config.prod_types[i % config.prod_types.size()];
+    }
+    for (int i = 0; i < config.trading_room_count; ++i)
+    {
+        auto &room = rooms.emplace_back();
+        room.id = "slot_" + std::to_string(++slot_id);
+        room.type = RoomType::TRADING;
+        room.level = GenSlotCount(config, random);
+        room.order_type = config.order_types[i % config.order_types.size()];
+    }
+    for (int i = 0; i < config.power_room_count; ++i)
+    {
+        auto &room = rooms.emplace_back();
+        room.id = "slot_" + std::to_string(++slot_id);
+        room.type = RoomType::POWER;
+        room.level = GenSlotCount(config, random);
+    }
+    return rooms;
+}
+
+SyntheticBase GenSyntheticBase(const SyntheticConfig &config, const data::building::BuildingData &building_data,
+                               const data::game::CharacterMetaTable *char_meta_table)
+{
+    SyntheticRandom random(config.seed);
+    SyntheticBase base;
+    base.rooms = GenRooms(config, random);
+
+    // 遍历顺序与容器实现无关
+    Array<Vector<std::string>, CHAR_CATEGORY_COUNT> pools;
+    for (const auto &[char_id, building_char] : building_data.chars)
+        pools[ClassifyChar(*building_char, building_data)].push_back(char_id);
+    for (auto &pool : pools)
+        std::sort(pool.begin(), pool.end());
+
+    const Array<double, CHAR_CATEGORY_COUNT> weights{std::max(0., config.manufacture_weight),
+                                                     std::max(0., config.trading_weight),
+                                                     std::max(0., config.other_weight)};
+    double weight_sum = 0;
+    for (int c = 0; c < CHAR_CATEGORY_COUNT; ++c)
+        weight_sum += pools[c].empty() ? 0 : weights[c];
+
+    const auto op_cnt = static_cast<size_t>(std::max(0, config.operator_count));
+    if (op_cnt > 0 && weight_sum <= 0)
+        throw std::invalid_argument("synthetic config: no character matches the given buff mix weights");
+
+    // 异格组：角色Id -> 同组的所有角色
+    Dictionary<std::string, const Vector<std::string> *> sp_groups;
+    if (char_meta_table && config.alternate_density > 0)
+    {
+        for (const auto &[group_id, members] : char_meta_table->sp_char_groups)
+        {
+            if (members.size() <= 1)
+                continue;
+            for (const auto &member : members)
+                sp_groups[member] = &members;
+        }
+    }
+
+    Array<Vector<std::string>, CHAR_CATEGORY_COUNT> remaining;
+    Dictionary<std::string, int> instance_cnt;
+    const auto add_char = [&](const std::string &char_id) {
+        auto &ch = base.chars.emplace_back();
+        const int instance = ++instance_cnt[char_id];
+        ch.identifier = instance == 1 ? char_id : char_id + "#" + std::to_string(instance);
+        ch.char_id = char_id;
+        if (random.NextReal() >= config.max_level_ratio)
+        {
+            static constexpr int kMaxLevels[] = {50, 80, 90};
+            ch.phase = random.NextInt(0, 2);
+            ch.level = random.NextInt(1, kMaxLevels[ch.phase]);
+        }
+        const double min_morale = std::clamp(config.min_morale, 0., 24.);
+        const double max_morale = std::clamp(config.max_morale, min_morale, 24.);
+        ch.morale = min_morale + (max_morale - min_morale) * random.NextReal();
+    };
+
+    while (base.chars.size() < op_cnt)
+    {
+        double pick = random.NextReal() * weight_sum;
+        int category = 0;
+        for (; category < CHAR_CATEGORY_COUNT - 1; ++category)
+        {
+            const double weight = pools[category].empty() ? 0 : weights[category];
+            if (pick < weight)
+                break;
+            pick -= weight;
+        }
+
+        auto &candidates = remaining[category];
+        if (candidates.empty())
+            candidates = pools[category];
+
+        const auto index = static_cast<size_t>(random.NextInt(0, static_cast<int>(candidates.size()) - 1));
+        std::swap(candidates[index], candidates.back());
+        const auto char_id = std::move(candidates.back());
+        candidates.pop_back();
+        add_char(char_id);
+
+        const auto it = sp_groups.find(char_id);
+        if (it == sp_groups.end() || random.NextReal() >= config.alternate_density)
+            continue;
+
+        for (const auto &member : *it->second)
+        {
+            // 同组成员已有同样多的实例时不再重复加入
+            if (member == char_id || base.chars.size() >= op_cnt || instance_cnt[member] >= instance_cnt[char_id])
+                continue;
+
+            const auto building_char = building_data.chars.find(member);
+            if (building_char == building_data.chars.end())
+                continue;
+
+            auto &member_candidates = remaining[ClassifyChar(*building_char->second, building_data)];
+            const auto member_it = std::find(member_candidates.begin(), member_candidates.end(), member);
+            if (member_it != member_candidates.end())
+                member_candidates.erase(member_it);
+            add_char(member);
+        }
+    }
+
+    return base;
+}
+
+int ManufactureCapacity(int level)
+{
+    static constexpr int kCapacities[] = {24, 36, 54};
+    return level <= 3 ? kCapacities[level - 1] : kCapacities[2] + 18 * (level - 3);
+}
+
+int TradingStockLimit(int level)
+{
+    return 4 + 2 * level;
+}
+
+const char *ManufactureFormulaId(ProdType prod_type)
+{
+    switch (prod_type)
+    {
+    case ProdType::GOLD:
+        return "4";
+    case ProdType::RECORD:
+        return "3";
+    case ProdType::ORIGINIUM_SHARD:
+        return "13";
+    default:
+        return "5";
+    }
+}
+} // namespace
+
+SyntheticConfig::SyntheticConfig(const Json::Value &val)
+{
+    const SyntheticConfig defaults;
+    seed = val.get(kSeed, defaults.seed).asUInt();
+    operator_count = val.get(kOperatorCount, defaults.operator_count).asInt();
+    manufacture_weight = val.get(kManufactureWeight, defaults.manufacture_weight).asDouble();
+    trading_weight = val.get(kTradingWeight, defaults.trading_weight).asDouble();
+    other_weight = val.get(kOtherWeight, defaults.other_weight).asDouble();
+    alternate_density = val.get(kAlternateDensity, defaults.alternate_density).asDouble();
+    max_level_ratio = val.get(kMaxLevelRatio, defaults.max_level_ratio).asDouble();
+    min_morale = val.get(kMinMorale, defaults.min_morale).asDouble();
+    max_morale = val.get(kMaxMorale, defaults.max_morale).asDouble();
+    manufacture_room_count = val.get(kManufactureRoomCount, defaults.manufacture_room_count).asInt();
+    trading_room_count = val.get(kTradingRoomCount, defaults.trading_room_count).asInt();
+    power_room_count = val.get(kPowerRoomCount, defaults.power_room_count).asInt();
+    min_slot_count = val.get(kMinSlotCount, defaults.min_slot_count).asInt();
+    max_slot_count = val.get(kMaxSlotCount, defaults.max_slot_count).asInt();
+
+    if (val.isMember(kProdTypes))
+    {
+        prod_types.clear();
+        for (const auto &item : val[kProdTypes])
+        {
+            const auto prod_type = util::parse_enum_string(item.asString(), JsonManufactureProdType::NONE);
+            if (prod_type == JsonManufactureProdType::NONE)
+                throw std::invalid_argument("synthetic config: unknown prodType: " + item.asString());
+            prod_types.push_back(static_cast<ProdType>(prod_type));
+        }
+    }
+
+    if (val.isMember(kOrderTypes))
+    {
+        order_types.clear();
+        for (const auto &item : val[kOrderTypes])
+        {
+            const auto order_type = util::parse_enum_string(item.asString(), JsonTradingOrderType::NONE);
+            if (order_type == JsonTradingOrderType::NONE)
+                throw std::invalid_argument("synthetic config: unknown orderType: " + item.asString());
+            order_types.push_back(static_cast<OrderType>(order_type));
+        }
+    }
+}
+
+Json::Value GenSyntheticPlayerData(const SyntheticConfig &config, const data::building::BuildingData &building_data,
+                                   const data::game::CharacterMetaTable *char_meta_table)
+{
+    const auto base = GenSyntheticBase(config, building_data, char_meta_table);
+
+    Json::Value troop_chars(Json::objectValue);
+    Json::Value building_chars(Json::objectValue);
+    int inst_id = 0;
+    for (const auto &ch : base.chars)
+    {
+        const auto key = std::to_string(++inst_id);
+
+        Json::Value troop_char;
+        troop_char["instId"] = inst_id;
+        troop_char["charId"] = ch.char_id;
+        troop_char["level"] = ch.level;
+        troop_char["exp"] = 0;
+        troop_char["evolvePhase"] = ch.phase;
+        troop_chars[key] = std::move(troop_char);
+
+        Json::Value building_char;
+        building_char["charId"] = ch.char_id;
+        building_char["roomSlotId"] = "";
+        building_char["ap"] = static_cast<int>(3600. * ch.morale);
+        building_char["index"] = 0;
+        building_char["changeScale"] = 0;
+        building_char["workTime"] = 0;
+        building_chars[key] = std::move(building_char);
+    }
+
+    Json::Value room_slots(Json::objectValue);
+    Json::Value rooms(Json::objectValue);
+    for (const auto &room : base.rooms)
+    {
+        const std::string room_type(util::enum_to_string(room.type));
+
+        Json::Value slot;
+        slot["level"] = room.level;
+        slot["state"] = static_cast<int>(data::player::PlayerRoomSlotState::BUILD);
+        slot["roomId"] = room_type;
+        slot["charInstIds"] = Json::arrayValue;
+        room_slots[room.id] = std::move(slot);
+
+        Json::Value player_room;
+        switch (room.type) // NOLINT(clang-diagnostic-switch-enum)
+        {
+        case RoomType::MANUFACTURE:
+            player_room["state"] = static_cast<int>(data::player::PlayerRoomState::RUN);
+            player_room["formulaId"] = ManufactureFormulaId(room.prod_type);
+            player_room["remainSolutionCnt"] = 0;
+            player_room["outputSolutionCnt"] = 0;
+            player_room["capacity"] = ManufactureCapacity(room.level);
+            player_room["apCost"] = 0;
+            player_room["processPoint"] = 0;
+            break;
+
+        case RoomType::TRADING:
+            player_room["buff"]["speed"] = 0;
+            player_room["buff"]["limit"] = 0;
+            player_room["state"] = static_cast<int>(data::player::PlayerRoomState::RUN);
+            player_room["stockLimit"] = TradingStockLimit(room.level);
+            player_room["stock"] = Json::arrayValue;
+            player_room["display"]["base"] = 0;
+            player_room["display"]["buff"] = 0;
+            player_room["strategy"] = room.order_type == OrderType::ORUNDUM ? "O_DIAMOND" : "O_GOLD";
+            break;
+
+        default:
+            break;
+        }
+        rooms[room_type][room.id] = std::move(player_room);
+    }
+
+    Json::Value labor;
+    labor["buffSpeed"] = 0;
+    labor["value"] = 0;
+    labor["maxValue"] = 0;
+    labor["ProcessPoint"] = 0;
+
+    Json::Value root;
+    root["troop"]["chars"] = std::move(troop_chars);
+    root["building"]["status"]["labor"] = std::move(labor);
+    root["building"]["chars"] = std::move(building_chars);
+    root["building"]["roomSlots"] = std::move(room_slots);
+    root["building"]["rooms"] = std::move(rooms);
+    return root;
+}
+
+Json::Value GenSyntheticJsonParams(const SyntheticConfig &config, const data::building::BuildingData &building_data,
+                                   const data::game::CharacterMetaTable *char_meta_table)
+{
+    const auto base = GenSyntheticBase(config, building_data, char_meta_table);
+
+    Json::Value chars(Json::objectValue);
+    for (const auto &ch : base.chars)
+    {
+        Json::Value val;
+        val[JsonInCharStruct::kCharId] = ch.char_id;
+        val[JsonInCharStruct::kPhase] = ch.phase;
+        val[JsonInCharStruct::kLevel] = ch.level;
+        val[JsonInCharStruct::kMorale] = ch.morale;
+        chars[ch.identifier] = std::move(val);
+    }
+
+    // 自定义输入只支持制造站与贸易站，发电站只在玩家数据中体现为全局属性
+    Json::Value rooms(Json::objectValue);
+    for (const auto &room : base.rooms)
+    {
+        Json::Value val;
+        Json::Value attributes;
+        attributes[JsonInRoomAttributeFields::kBaseCharCost] = 1;
+        attributes[JsonInRoomAttributeFields::kBaseProdEff] = 1 + 0.01 * room.level;
+        attributes[JsonInRoomAttributeFields::kProdCnt] = 0;
+
+        switch (room.type) // NOLINT(clang-diagnostic-switch-enum)
+        {
+        case RoomType::MANUFACTURE:
+            val[JsonInRoomStruct::kSharedProdType] =
+                std::string(util::enum_to_string(static_cast<JsonManufactureProdType>(room.prod_type)));
+            attributes[JsonInRoomAttributeFields::kBaseProdCap] = ManufactureCapacity(room.level);
+            break;
+
+        case RoomType::TRADING:
+            val[JsonInRoomStruct::kSharedProdType] =
+                std::string(util::enum_to_string(static_cast<JsonTradingOrderType>(room.order_type)));
+            attributes[JsonInRoomAttributeFields::kBaseProdCap] = TradingStockLimit(room.level);
+            break;
+
+        default:
+            continue;
+        }
+
+        val[JsonInRoomStruct::kType] = std::string(util::enum_to_string(room.type));
+        val[JsonInRoomStruct::kSlotCount] = room.level;
+        val[JsonInRoomStruct::kAttributes] = std::move(attributes);
+        rooms[room.id] = std::move(val);
+    }
+
+    Json::Value root;
+    root[JsonInParams::kChars] = std::move(chars);
+    root[JsonInParams::kRooms] = std::move(rooms);
+    return root;
+}
+} // namespace albc::api
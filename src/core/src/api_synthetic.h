@@ -0,0 +1,44 @@
+#pragma once
+#include "api_json_params.h"
+#include "data_building.h"
+#include "data_character_meta_table.h"
+#include "model_buff_primitives.h"
+
+namespace albc::api
+{
+// 合成输入的生成参数。相同的参数与游戏数据总是生成相同的输入，用于测量枚举规模、矩阵规模与求解耗时随输入规模的变化。
+// 干员从 building_data 中按其已实现Buff作用的设施分为制造站、贸易站与其他三类，按权重抽取；
+// 抽完所有角色后重复抽取（作为不同的实例）。
+struct SyntheticConfig
+{
+    UInt32 seed = 20220424;         ALBC_API_JSON_KEY(kSeed, "seed");
+    int operator_count = 100;       ALBC_API_JSON_KEY(kOperatorCount, "operators");
+    double manufacture_weight = 1;  ALBC_API_JSON_KEY(kManufactureWeight, "manufactureWeight");
+    double trading_weight = 1;      ALBC_API_JSON_KEY(kTradingWeight, "tradingWeight");
+    double other_weight = 1;        ALBC_API_JSON_KEY(kOtherWeight, "otherWeight");
+    double alternate_density = 0;   ALBC_API_JSON_KEY(kAlternateDensity, "alternateDensity"); // 抽到异格组成员时一并加入同组其他成员的概率，需载入 char_meta_table
+    double max_level_ratio = .5;    ALBC_API_JSON_KEY(kMaxLevelRatio, "maxLevelRatio");       // 精二90级的干员比例，其余随机等级
+    double min_morale = 24;         ALBC_API_JSON_KEY(kMinMorale, "minMorale");
+    double max_morale = 24;         ALBC_API_JSON_KEY(kMaxMorale, "maxMorale");
+    int manufacture_room_count = 4; ALBC_API_JSON_KEY(kManufactureRoomCount, "manufactureRooms");
+    int trading_room_count = 2;     ALBC_API_JSON_KEY(kTradingRoomCount, "tradingRooms");
+    int power_room_count = 3;       ALBC_API_JSON_KEY(kPowerRoomCount, "powerRooms"); // 只影响全局属性（发电站数量）
+    int min_slot_count = 3;         ALBC_API_JSON_KEY(kMinSlotCount, "minSlots");     // 房间槽位数（即房间等级）在此范围内随机
+    int max_slot_count = 3;         ALBC_API_JSON_KEY(kMaxSlotCount, "maxSlots");
+    Vector<model::buff::ProdType> prod_types {model::buff::ProdType::GOLD, model::buff::ProdType::RECORD};
+                                    ALBC_API_JSON_KEY(kProdTypes, "prodTypes");  // 制造站产物，依次轮流分配
+    Vector<model::buff::OrderType> order_types {model::buff::OrderType::GOLD};
+                                    ALBC_API_JSON_KEY(kOrderTypes, "orderTypes"); // 贸易站订单，依次轮流分配
+
+    SyntheticConfig() = default;
+    explicit SyntheticConfig(const Json::Value &val);
+};
+
+// 生成玩家数据，格式与 player_data.json 中被解析的部分一致
+Json::Value GenSyntheticPlayerData(const SyntheticConfig &config, const data::building::BuildingData &building_data,
+                                   const data::game::CharacterMetaTable *char_meta_table = nullptr);
+
+// 生成 RunWithJsonParams 的输入，与同一参数生成的玩家数据描述相同的干员与房间
+Json::Value GenSyntheticJsonParams(const SyntheticConfig &config, const data::building::BuildingData &building_data,
+                                   const data::game::CharacterMetaTable *char_meta_table = nullptr);
+} // namespace albc::api
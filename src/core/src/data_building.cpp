@@ -8,6 +8,7 @@ namespace albc::data::building
 
 SlotItem::SlotItem(const Json::Value &json)
     : buff_id(json["buffId"].asString()),
+      buff_atom(util::Atom::Intern(buff_id)),
       cond(UnlockCondition(json["cond"]))
 {}
 BuildingBuffCharSlot::BuildingBuffCharSlot(const Json::Value &json)
@@ -27,7 +28,87 @@ BuildingBuff::BuildingBuff(const Json::Value &json)
       description(json["description"].asString())
 {}
 BuildingData::BuildingData(const Json::Value &json)
-    : chars(util::json_val_as_ptr_dictionary<BuildingCharacter>(json["chars"])),
-      buffs(util::json_val_as_ptr_dictionary<BuildingBuff>(json["buffs"]))
-{}
+    : chars(util::json_val_as_map<decltype(chars)>(json["chars"])),
+      buffs(util::json_val_as_map<decltype(buffs)>(json["buffs"]))
+{
+    BuildAtomIndex();
+}
+SlotItem::SlotItem(util::JsonStreamReader &reader)
+{
+    reader.ReadObject([&](std::string_view key) {
+        if (key == "buffId")
+            buff_id = reader.ReadString();
+        else if (key == "cond")
+            cond = UnlockCondition(reader);
+        else
+            reader.Skip();
+    });
+    buff_atom = util::Atom::Intern(buff_id);
+}
+BuildingBuffCharSlot::BuildingBuffCharSlot(util::JsonStreamReader &reader)
+{
+    reader.ReadObject([&](std::string_view key) {
+        if (key == "buffData")
+            buff_data = util::json_stream_as_vector<SlotItem>(reader);
+        else
+            reader.Skip();
+    });
+}
+BuildingCharacter::BuildingCharacter(util::JsonStreamReader &reader)
+    : max_man_power(0)
+{
+    reader.ReadObject([&](std::string_view key) {
+        if (key == "charId")
+            char_id = reader.ReadString();
+        else if (key == "maxManpower")
+            max_man_power = reader.ReadInt64();
+        else if (key == "buffChar")
+            buff_char = util::json_stream_as_ptr_vector<BuildingBuffCharSlot>(reader);
+        else
+            reader.Skip();
+    });
+}
+BuildingBuff::BuildingBuff(util::JsonStreamReader &reader)
+    : sort_id(0),
+      room_type(RoomType::NONE)
+{
+    reader.ReadObject([&](std::string_view key) {
+        if (key == "buffId")
+            buff_id = reader.ReadString();
+        else if (key == "buffName")
+            buff_name = reader.ReadString();
+        else if (key == "skillIcon")
+            skill_icon = reader.ReadString();
+        else if (key == "sortId")
+            sort_id = reader.ReadInt();
+        else if (key == "roomType")
+            room_type = util::parse_enum_string(reader.ReadString(), RoomType::NONE);
+        else if (key == "description")
+            description = reader.ReadString();
+        else
+            reader.Skip();
+    });
+}
+BuildingData::BuildingData(util::JsonStreamReader &reader)
+{
+    reader.ReadObject([&](std::string_view key) {
+        if (key == "chars")
+            chars = util::json_stream_as_map<decltype(chars)>(reader);
+        else if (key == "buffs")
+            buffs = util::json_stream_as_map<decltype(buffs)>(reader);
+        else
+            reader.Skip();
+    });
+    BuildAtomIndex();
+}
+void BuildingData::BuildAtomIndex()
+{
+    buff_index_.clear();
+    for (const auto &[id, buff] : buffs)
+        buff_index_.emplace(util::Atom::Intern(id), buff.get());
+
+    // 干员Id只在此处驻留，求解输入中的Id经 Atom::Find 查找
+    for (const auto &[id, chr] : chars)
+        util::Atom::Intern(id);
+}
 }
\ No newline at end of file
@@ -1,5 +1,6 @@
 #pragma once
 #include "data_game.h"
+#include "util_atom.h"
 #include "util_json.h"
 #include "albc_types.h"
 #include "util.h"
@@ -46,9 +47,11 @@ enum class RoomType
 struct SlotItem
 {
     std::string buff_id;
+    util::Atom buff_atom; // buff_id 的驻留编号
     UnlockCondition cond;
 
     explicit SlotItem(const Json::Value &json);
+    explicit SlotItem(util::JsonStreamReader &reader);
     SlotItem() = default;
 };
 
@@ -57,17 +60,21 @@ class BuildingBuffCharSlot
   public:
     Vector<SlotItem> buff_data;
 
+    BuildingBuffCharSlot() = default;
     explicit BuildingBuffCharSlot(const Json::Value &json);
+    explicit BuildingBuffCharSlot(util::JsonStreamReader &reader);
 };
 
 class BuildingCharacter
 {
   public:
     std::string char_id;
-    Int64 max_man_power;
+    Int64 max_man_power = 0;
     mem::PtrVector<BuildingBuffCharSlot> buff_char;
 
+    BuildingCharacter() = default;
     explicit BuildingCharacter(const Json::Value &json);
+    explicit BuildingCharacter(util::JsonStreamReader &reader);
 };
 
 class BuildingBuff
@@ -76,21 +83,39 @@ class BuildingBuff
     std::string buff_id;
     std::string buff_name;
     std::string skill_icon;
-    int sort_id;
-    RoomType room_type;
+    int sort_id = 0;
+    RoomType room_type = RoomType::NONE;
     std::string description;
 
+    BuildingBuff() = default;
     explicit BuildingBuff(const Json::Value &json);
+    explicit BuildingBuff(util::JsonStreamReader &reader);
 };
 
 class BuildingData
 {
   public:
-    mem::PtrDictionary<std::string, BuildingCharacter> chars;
-    mem::PtrDictionary<std::string, BuildingBuff> buffs;
+    mem::PtrHashDictionary<std::string, BuildingCharacter> chars;
+    mem::PtrHashDictionary<std::string, BuildingBuff> buffs;
 
     BuildingData() = default;
     explicit BuildingData(const Json::Value &json);
+
+    // 流式解析 building_data.json，只保留 chars 与 buffs，其余成员直接跳过
+    explicit BuildingData(util::JsonStreamReader &reader);
+
+    // 按驻留编号查找 buff，未找到时返回 nullptr
+    [[nodiscard]] const BuildingBuff *FindBuff(util::Atom buff_id) const
+    {
+        const auto it = buff_index_.find(buff_id);
+        return it != buff_index_.end() ? it->second : nullptr;
+    }
+
+    // 驻留 buffs 与 chars 的键并建立Buff编号索引，直接填充 buffs 或 chars 后需调用
+    void BuildAtomIndex();
+
+  private:
+    HashDictionary<util::Atom, const BuildingBuff *> buff_index_;
 };
 } // namespace albc::data::building
 
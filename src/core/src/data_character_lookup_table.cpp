@@ -9,8 +9,10 @@ namespace albc::data::game
 CharacterLookupTable::CharacterLookupTable(std::shared_ptr<CharacterTable> character_table)
     : character_table_(std::move(character_table))
 {
-    for (auto &[char_id, character] : *character_table_)
+    // 重名时后者覆盖前者，按Id顺序遍历以保证结果确定
+    for (const auto *entry : util::sorted_entries(*character_table_))
     {
+        const auto &[char_id, character] = *entry;
         name_to_id_[character->name] = char_id;
         if (!character->appellation.empty())
             appellation_to_id_[character->appellation] = char_id;
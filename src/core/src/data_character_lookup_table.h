@@ -43,7 +43,7 @@ class CharacterLookupTable: public ICharacterLookupTable
 
   private:
     std::shared_ptr<CharacterTable> character_table_;
-    Dictionary<std::string, std::string> name_to_id_;
-    Dictionary<std::string, std::string> appellation_to_id_;
+    HashDictionary<std::string, std::string> name_to_id_;
+    HashDictionary<std::string, std::string> appellation_to_id_;
 };
 } // namespace albc::data::game
\ No newline at end of file
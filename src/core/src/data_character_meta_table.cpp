@@ -2,6 +2,7 @@
 // Created by Nonary on 2022/4/24.
 //
 #include "data_character_meta_table.h"
+#include "util_atom.h"
 
 namespace albc::data::game
 {
@@ -11,6 +12,29 @@ CharacterMetaTable::CharacterMetaTable(const Json::Value &json)
     json["spCharGroups"],
     [](const Json::Value& val) { return util::json_val_as_vector<std::string>(val, util::json_cast<std::string>); }))
 {
+    InternGroups();
+}
+CharacterMetaTable::CharacterMetaTable(util::JsonStreamReader &reader)
+{
+    reader.ReadObject([&](std::string_view key) {
+        if (key != "spCharGroups")
+        {
+            reader.Skip();
+            return;
+        }
+
+        sp_char_groups = util::json_stream_as_dictionary<Vector<std::string>>(reader, [](util::JsonStreamReader &r) {
+            Vector<std::string> group;
+            r.ReadArray([&] { group.emplace_back(r.ReadString()); });
+            return group;
+        });
+    });
+    InternGroups();
+}
+void CharacterMetaTable::InternGroups() const
+{
+    for (const auto &[group_id, members] : sp_char_groups)
+        util::Atom::Intern(group_id);
 }
 bool CharacterMetaTable::IsSpCharacter(const std::string &char_id) const
 {
@@ -1,5 +1,6 @@
 #pragma once
 #include "util_json.h"
+#include "util_json_stream.h"
 #include "albc_types.h"
 
 namespace albc::data::game
@@ -9,10 +10,15 @@ class CharacterMetaTable
   public:
     Dictionary<std::string, Vector<std::string>> sp_char_groups; // json: spCharGroups
 
+    CharacterMetaTable() = default;
     explicit CharacterMetaTable(const Json::Value &json);
+    explicit CharacterMetaTable(util::JsonStreamReader &reader);
 
     [[nodiscard]] bool IsSpCharacter(const std::string &char_id) const;
 
     [[nodiscard]] std::string TryGetSpGroup(const std::string &char_id) const;
+
+    // 驻留异格组名，直接填充 sp_char_groups 后需调用
+    void InternGroups() const;
 };
 } // namespace albc::data::game
@@ -11,7 +11,24 @@ CharacterData::CharacterData(const Json::Value &json)
 {
 }
 CharacterTable::CharacterTable(const Json::Value &json)
-    : mem::PtrDictionary<std::string, CharacterData>(util::json_val_as_ptr_dictionary<CharacterData>(json))
+    : mem::PtrHashDictionary<std::string, CharacterData>(
+          util::json_val_as_map<mem::PtrHashDictionary<std::string, CharacterData>>(json))
+{
+}
+CharacterData::CharacterData(util::JsonStreamReader &reader)
+{
+    reader.ReadObject([&](std::string_view key) {
+        if (key == "name")
+            name = reader.ReadString();
+        else if (key == "appellation")
+            appellation = reader.ReadString();
+        else
+            reader.Skip();
+    });
+}
+CharacterTable::CharacterTable(util::JsonStreamReader &reader)
+    : mem::PtrHashDictionary<std::string, CharacterData>(
+          util::json_stream_as_map<mem::PtrHashDictionary<std::string, CharacterData>>(reader))
 {
 }
 }
\ No newline at end of file
@@ -15,12 +15,16 @@ class CharacterData
     std::string name;
     std::string appellation;
 
+    CharacterData() = default;
     explicit CharacterData(const Json::Value &json);
+    explicit CharacterData(util::JsonStreamReader &reader);
 };
 
-class CharacterTable : public mem::PtrDictionary<std::string, CharacterData>
+class CharacterTable : public mem::PtrHashDictionary<std::string, CharacterData>
 {
   public:
+    CharacterTable() = default;
     explicit CharacterTable(const Json::Value &json);
+    explicit CharacterTable(util::JsonStreamReader &reader);
 };
 }
@@ -12,3 +12,15 @@ albc::data::UnlockCondition::UnlockCondition(const Json::Value &json)
     phase(util::json_val_as_enum<EvolvePhase>(json["phase"])),
     level(json["level"].asInt())
 { }
+albc::data::UnlockCondition::UnlockCondition(util::JsonStreamReader &reader)
+    : phase(EvolvePhase::PHASE_0), level(0)
+{
+    reader.ReadObject([&](std::string_view key) {
+        if (key == "phase")
+            phase = static_cast<EvolvePhase>(reader.ReadInt());
+        else if (key == "level")
+            level = reader.ReadInt();
+        else
+            reader.Skip();
+    });
+}
@@ -1,5 +1,6 @@
 #pragma once
 #include "util_json.h"
+#include "util_json_stream.h"
 
 namespace albc::data
 {
@@ -19,6 +20,7 @@ namespace albc::data
 		int level = 0;
 
 		explicit UnlockCondition(const Json::Value& json);
+		explicit UnlockCondition(util::JsonStreamReader& reader);
 
         UnlockCondition() = default;
 
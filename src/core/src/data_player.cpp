@@ -10,28 +10,75 @@ PlayerCharacter::PlayerCharacter(const Json::Value &json)
       exp(json["exp"].asInt()), evolve_phase(util::json_val_as_enum<EvolvePhase>(json["evolvePhase"]))
 {}
 PlayerTroop::PlayerTroop(const Json::Value &json)
-    : chars(util::json_val_as_ptr_dictionary<PlayerCharacter>(json["chars"]))
+    : chars(util::json_val_as_map<decltype(chars)>(json["chars"]))
 {}
 PlayerDataModel::PlayerDataModel(const Json::Value &json) : troop(json["troop"]),
                                                             building(json["building"])
 {}
+PlayerCharacter::PlayerCharacter(util::JsonStreamReader &reader)
+    : inst_id(0) // 与 DOM 路径一致：缺省时为 0
+{
+    reader.ReadObject([&](std::string_view key) {
+        if (key == "instId")
+            inst_id = reader.ReadInt();
+        else if (key == "charId")
+            char_id = reader.ReadString();
+        else if (key == "level")
+            level = reader.ReadInt();
+        else if (key == "exp")
+            exp = reader.ReadInt();
+        else if (key == "evolvePhase")
+            evolve_phase = static_cast<EvolvePhase>(reader.ReadInt());
+        else
+            reader.Skip();
+    });
+}
+PlayerTroop::PlayerTroop(util::JsonStreamReader &reader)
+{
+    reader.ReadObject([&](std::string_view key) {
+        if (key == "chars")
+            chars = util::json_stream_as_map<decltype(chars)>(reader);
+        else
+            reader.Skip();
+    });
+}
+PlayerDataModel::PlayerDataModel(util::JsonStreamReader &reader)
+{
+    reader.ReadObject([&](std::string_view key) {
+        if (key == "troop")
+            troop = PlayerTroop(reader);
+        else if (key == "building")
+            building = PlayerBuilding(reader);
+        else
+            reader.Skip();
+    });
+}
 PlayerTroopLookup::PlayerTroopLookup(const PlayerTroop &troop)
 {
     for (const auto &[id, char_data] : troop.chars)
     {
-        inst_id_to_char_id.insert({char_data->inst_id, char_data->char_id});
-        char_id_to_inst_id.insert({char_data->char_id, char_data->inst_id});
+        // 游戏数据中没有的Id不会被任何Buff引用，无需加入
+        const auto char_id = util::Atom::Find(char_data->char_id);
+        if (char_id.empty())
+            continue;
+
+        inst_id_to_char_id.insert({char_data->inst_id, char_id});
+        char_id_to_inst_id.insert({char_id, char_data->inst_id});
     }
 }
 PlayerTroopLookup::PlayerTroopLookup(const Vector<std::pair<int, std::string>> &troop_lookup)
 {
-    for (const auto &[inst_id, char_id] : troop_lookup)
+    for (const auto &[inst_id, char_id_str] : troop_lookup)
     {
+        const auto char_id = util::Atom::Find(char_id_str);
+        if (char_id.empty())
+            continue;
+
         inst_id_to_char_id.insert({inst_id, char_id});
         char_id_to_inst_id.insert({char_id, inst_id});
     }
 }
-int PlayerTroopLookup::GetInstId(const std::string &char_id) const
+int PlayerTroopLookup::GetInstId(util::Atom char_id) const
 {
     auto it = char_id_to_inst_id.find(char_id);
     if (it == char_id_to_inst_id.end())
@@ -40,12 +87,12 @@ int PlayerTroopLookup::GetInstId(const std::string &char_id) const
     }
     return it->second;
 }
-std::string PlayerTroopLookup::GetCharId(int inst_id) const
+util::Atom PlayerTroopLookup::GetCharId(int inst_id) const
 {
     auto it = inst_id_to_char_id.find(inst_id);
     if (it == inst_id_to_char_id.end())
     {
-        return "";
+        return {};
     }
     return it->second;
 }
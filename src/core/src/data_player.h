@@ -18,15 +18,17 @@ class PlayerCharacter
 
     PlayerCharacter() = default;
     explicit PlayerCharacter(const Json::Value &json);
+    explicit PlayerCharacter(util::JsonStreamReader &reader);
 };
 
 class PlayerTroop
 {
   public:
-    mem::PtrDictionary<std::string, PlayerCharacter> chars;
+    mem::PtrSmallDictionary<std::string, PlayerCharacter> chars;
 
     PlayerTroop() = default;
     explicit PlayerTroop(const Json::Value &json);
+    explicit PlayerTroop(util::JsonStreamReader &reader);
 };
 
 class PlayerDataModel
@@ -37,6 +39,9 @@ class PlayerDataModel
 
     PlayerDataModel() = default;
     explicit PlayerDataModel(const Json::Value &json);
+
+    // 流式解析玩家数据，只保留 troop 与 building，其余成员直接跳过
+    explicit PlayerDataModel(util::JsonStreamReader &reader);
 };
 
 class PlayerTroopLookup
@@ -45,12 +50,12 @@ class PlayerTroopLookup
     explicit PlayerTroopLookup(const PlayerTroop &troop);
     explicit PlayerTroopLookup(const Vector<std::pair<int, std::string>> &troop_lookup);
 
-    [[nodiscard]] int GetInstId(const std::string &char_id) const;
+    [[nodiscard]] int GetInstId(util::Atom char_id) const;
 
-    [[nodiscard]] std::string GetCharId(int inst_id) const;
+    [[nodiscard]] util::Atom GetCharId(int inst_id) const;
 
   private:
-    Dictionary<std::string, int> char_id_to_inst_id;
-    Dictionary<int, std::string> inst_id_to_char_id;
+    HashDictionary<util::Atom, int> char_id_to_inst_id;
+    HashDictionary<int, util::Atom> inst_id_to_char_id;
 };
 } // namespace albc::data::player
@@ -73,14 +73,200 @@ PlayerBuildingLabor::PlayerBuildingLabor(const Json::Value &json)
 {
 }
 PlayerBuildingRoom::PlayerBuildingRoom(const Json::Value &json)
-    : manufacture(util::json_val_as_dictionary<PlayerBuildingManufacture>(json["MANUFACTURE"])),
-      trading(util::json_val_as_dictionary<PlayerBuildingTrading>(json["TRADING"]))
+    : manufacture(util::json_val_as_map<decltype(manufacture)>(json["MANUFACTURE"])),
+      trading(util::json_val_as_map<decltype(trading)>(json["TRADING"]))
 {
 }
 PlayerBuilding::PlayerBuilding(const Json::Value &json)
     : status_labor(json["status"]["labor"]),
-      room_slots(util::json_val_as_dictionary<PlayerBuildingRoomSlot>(json["roomSlots"])),
-      player_building_room(json["rooms"]), chars(util::json_val_as_ptr_dictionary<PlayerBuildingChar>(json["chars"]))
+      room_slots(util::json_val_as_map<decltype(room_slots)>(json["roomSlots"])),
+      player_building_room(json["rooms"]), chars(util::json_val_as_map<decltype(chars)>(json["chars"]))
 {
 }
+PlayerBuildingRoomSlot::PlayerBuildingRoomSlot(util::JsonStreamReader &reader)
+    : level(0),
+      state(PlayerRoomSlotState::EMPTY),
+      room_id(building::RoomType::NONE)
+{
+    reader.ReadObject([&](std::string_view key) {
+        if (key == "level")
+            level = reader.ReadInt();
+        else if (key == "state")
+            state = static_cast<PlayerRoomSlotState>(reader.ReadInt());
+        else if (key == "roomId")
+            room_id = util::parse_enum_string(reader.ReadString(), building::RoomType::NONE);
+        else if (key == "charInstIds")
+            reader.ReadArray([&] { char_inst_ids.push_back(reader.ReadInt()); });
+        else
+            reader.Skip();
+    });
+}
+BuildingBuffDisplay::BuildingBuffDisplay(util::JsonStreamReader &reader)
+    : base_buff(0),
+      buff(0)
+{
+    reader.ReadObject([&](std::string_view key) {
+        if (key == "base")
+            base_buff = reader.ReadInt();
+        else if (key == "buff")
+            buff = reader.ReadInt();
+        else
+            reader.Skip();
+    });
+}
+PlayerBuildingChar::PlayerBuildingChar(util::JsonStreamReader &reader)
+    : change_scale(0) // 与 DOM 路径一致：缺省时为 0
+{
+    reader.ReadObject([&](std::string_view key) {
+        if (key == "charId")
+            char_id = reader.ReadString();
+        else if (key == "roomSlotId")
+            room_slot_id = reader.ReadString();
+        else if (key == "ap")
+            ap = reader.ReadInt();
+        else if (key == "index")
+            index = reader.ReadInt();
+        else if (key == "changeScale")
+            change_scale = reader.ReadInt();
+        else if (key == "workTime")
+            work_time = reader.ReadInt();
+        else
+            reader.Skip();
+    });
+}
+PlayerBuildingManufacture::PlayerBuildingManufacture(util::JsonStreamReader &reader)
+    : state(PlayerRoomState::STOP),
+      formula_id(),
+      remain_sln_cnt(0),
+      output_sln_cnt(0),
+      capacity(0),
+      ap_cost(0),
+      process_point(0.)
+{
+    reader.ReadObject([&](std::string_view key) {
+        if (key == "state")
+            state = static_cast<PlayerRoomState>(reader.ReadInt());
+        else if (key == "formulaId")
+            formula_id = static_cast<ManufactureFormulaId>(strtol(reader.ReadString().c_str(), nullptr, 0));
+        else if (key == "remainSolutionCnt")
+            remain_sln_cnt = reader.ReadInt();
+        else if (key == "outputSolutionCnt")
+            output_sln_cnt = reader.ReadInt();
+        else if (key == "capacity")
+            capacity = reader.ReadInt();
+        else if (key == "apCost")
+            ap_cost = reader.ReadInt();
+        else if (key == "processPoint")
+            process_point = reader.ReadDouble();
+        else
+            reader.Skip();
+    });
+
+    if (!magic_enum::enum_contains<ManufactureFormulaId>(formula_id))
+    {
+        LOG_E("Invalid formula id: ", static_cast<int>(formula_id));
+    }
+}
+TradingBuff::TradingBuff(util::JsonStreamReader &reader)
+    : speed(0.),
+      limit(0)
+{
+    reader.ReadObject([&](std::string_view key) {
+        if (key == "speed")
+            speed = reader.ReadDouble();
+        else if (key == "limit")
+            limit = reader.ReadInt();
+        else
+            reader.Skip();
+    });
+}
+PlayerBuildingTrading::PlayerBuildingTrading(util::JsonStreamReader &reader)
+    : buff(),
+      state(PlayerRoomState::STOP),
+      stock_limit(0),
+      display()
+{
+    std::string o_type;
+    reader.ReadObject([&](std::string_view key) {
+        if (key == "buff")
+            buff = TradingBuff(reader);
+        else if (key == "state")
+            state = static_cast<PlayerRoomState>(reader.ReadInt());
+        else if (key == "stockLimit")
+            stock_limit = reader.ReadInt();
+        else if (key == "stock")
+            stock = util::json_stream_as_vector<PlayerBuildingTradingOrder>(reader);
+        else if (key == "display")
+            display = BuildingBuffDisplay(reader);
+        else if (key == "strategy")
+            o_type = reader.ReadString();
+        else
+            reader.Skip();
+    });
+
+    if (o_type == "O_GOLD")
+    {
+        order_type = model::buff::OrderType::GOLD;
+    }
+    else if (o_type == "O_DIAMOND")
+    {
+        order_type = model::buff::OrderType::ORUNDUM;
+    }
+    else
+    {
+        assert(false);
+    }
+}
+PlayerBuildingLabor::PlayerBuildingLabor(util::JsonStreamReader &reader)
+    : buff_speed(0.),
+      value(0),
+      max_value(0),
+      process_point(0.)
+{
+    reader.ReadObject([&](std::string_view key) {
+        if (key == "buffSpeed")
+            buff_speed = reader.ReadDouble();
+        else if (key == "value")
+            value = reader.ReadInt();
+        else if (key == "maxValue")
+            max_value = reader.ReadInt();
+        else if (key == "ProcessPoint")
+            process_point = reader.ReadDouble();
+        else
+            reader.Skip();
+    });
+}
+PlayerBuildingRoom::PlayerBuildingRoom(util::JsonStreamReader &reader)
+{
+    reader.ReadObject([&](std::string_view key) {
+        if (key == "MANUFACTURE")
+            manufacture = util::json_stream_as_map<decltype(manufacture)>(reader);
+        else if (key == "TRADING")
+            trading = util::json_stream_as_map<decltype(trading)>(reader);
+        else
+            reader.Skip();
+    });
+}
+PlayerBuilding::PlayerBuilding(util::JsonStreamReader &reader)
+{
+    reader.ReadObject([&](std::string_view key) {
+        if (key == "status")
+        {
+            reader.ReadObject([&](std::string_view status_key) {
+                if (status_key == "labor")
+                    status_labor = PlayerBuildingLabor(reader);
+                else
+                    reader.Skip();
+            });
+        }
+        else if (key == "roomSlots")
+            room_slots = util::json_stream_as_map<decltype(room_slots)>(reader);
+        else if (key == "rooms")
+            player_building_room = PlayerBuildingRoom(reader);
+        else if (key == "chars")
+            chars = util::json_stream_as_map<decltype(chars)>(reader);
+        else
+            reader.Skip();
+    });
+}
 }
\ No newline at end of file
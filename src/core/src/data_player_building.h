@@ -3,6 +3,7 @@
 
 #include "model_buff_primitives.h"
 #include "util_json.h"
+#include "util_json_stream.h"
 #include "util_mem.h"
 #include "albc_types.h"
 #include "json/json.h"
@@ -25,6 +26,7 @@ enum class PlayerRoomSlotState
 struct PlayerBuildingRoomSlot
 {
     explicit PlayerBuildingRoomSlot(const Json::Value &json);
+    explicit PlayerBuildingRoomSlot(util::JsonStreamReader &reader);
 
     int level;
     PlayerRoomSlotState state;
@@ -34,7 +36,9 @@ struct PlayerBuildingRoomSlot
 
 struct BuildingBuffDisplay
 {
+    BuildingBuffDisplay() = default;
     explicit BuildingBuffDisplay(const Json::Value &json);
+    explicit BuildingBuffDisplay(util::JsonStreamReader &reader);
 
     int base_buff;
     int buff;
@@ -44,6 +48,7 @@ struct PlayerBuildingChar
 {
     PlayerBuildingChar() = default;
     explicit PlayerBuildingChar(const Json::Value &json);
+    explicit PlayerBuildingChar(util::JsonStreamReader &reader);
 
     std::string char_id;
     std::string room_slot_id;
@@ -74,6 +79,7 @@ enum class ManufactureFormulaId
 struct PlayerBuildingManufacture
 {
     explicit PlayerBuildingManufacture(const Json::Value &json);
+    explicit PlayerBuildingManufacture(util::JsonStreamReader &reader);
 
     PlayerRoomState state;
     ManufactureFormulaId formula_id;
@@ -94,7 +100,9 @@ struct TradingOrderBuff
 
 struct TradingBuff
 {
+    TradingBuff() = default;
     explicit TradingBuff(const Json::Value &json);
+    explicit TradingBuff(util::JsonStreamReader &reader);
 
     double speed;
     int limit;
@@ -105,11 +113,17 @@ struct PlayerBuildingTradingOrder
     explicit PlayerBuildingTradingOrder(const Json::Value &)
     {
     }
+
+    explicit PlayerBuildingTradingOrder(util::JsonStreamReader &reader)
+    {
+        reader.Skip();
+    }
 };
 
 struct PlayerBuildingTrading
 {
     explicit PlayerBuildingTrading(const Json::Value &json);
+    explicit PlayerBuildingTrading(util::JsonStreamReader &reader);
 
     TradingBuff buff;
     PlayerRoomState state;
@@ -123,6 +137,7 @@ struct PlayerBuildingLabor
 {
     PlayerBuildingLabor() = default;
     explicit PlayerBuildingLabor(const Json::Value &json);
+    explicit PlayerBuildingLabor(util::JsonStreamReader &reader);
 
     double buff_speed;
     int value;
@@ -133,11 +148,12 @@ struct PlayerBuildingLabor
 class PlayerBuildingRoom
 {
   public:
-    Dictionary<std::string, PlayerBuildingManufacture> manufacture;
-    Dictionary<std::string, PlayerBuildingTrading> trading;
+    SmallDictionary<std::string, PlayerBuildingManufacture> manufacture;
+    SmallDictionary<std::string, PlayerBuildingTrading> trading;
 
     PlayerBuildingRoom() = default;
     explicit PlayerBuildingRoom(const Json::Value &json);
+    explicit PlayerBuildingRoom(util::JsonStreamReader &reader);
 };
 
 class PlayerBuilding
@@ -145,11 +161,12 @@ class PlayerBuilding
   public:
     PlayerBuilding() = default;
     explicit PlayerBuilding(const Json::Value &json);
+    explicit PlayerBuilding(util::JsonStreamReader &reader);
 
     PlayerBuildingLabor status_labor{};
-    Dictionary<std::string, PlayerBuildingRoomSlot> room_slots;
+    SmallDictionary<std::string, PlayerBuildingRoomSlot> room_slots;
     PlayerBuildingRoom player_building_room;
-    mem::PtrDictionary<std::string, PlayerBuildingChar> chars;
+    mem::PtrSmallDictionary<std::string, PlayerBuildingChar> chars;
     List<int> assist;
 };
 } // namespace albc::data::player
\ No newline at end of file
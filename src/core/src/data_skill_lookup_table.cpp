@@ -102,8 +102,10 @@ SkillLookupTable::SkillLookupTable(std::shared_ptr<building::BuildingData> build
         exist_icons_.insert(buff->skill_icon);
     }
 
-    for (const auto &[char_id, character] : building_data->chars)
+    // 多名干员对应同一查询键时结果与插入先后有关，按Id顺序遍历以保证结果确定
+    for (const auto *entry : util::sorted_entries(building_data->chars))
     {
+        const auto &[char_id, character] = *entry;
         // 用于生成该干员在所有可能的等级条件下的技能组合
         auto cur_phase = EvolvePhase::PHASE_0;
         int cur_level = 1;
@@ -209,6 +211,74 @@ SkillLookupTable::SkillLookupTable(std::shared_ptr<building::BuildingData> build
         }
     }
 }
+SkillLookupTable::SkillLookupTable(util::BinaryReader &reader)
+{
+    // 查询表的键来自 std::hash，不同标准库实现间不通用
+    if (reader.Read<UInt64>() != HashString(kSingleBuffHashKey))
+        throw std::runtime_error("Skill lookup table snapshot was built with an incompatible hash function");
+
+    const auto read_string_map = [&reader](std::unordered_map<std::string, std::string> &map) {
+        const auto count = reader.ReadCount(8);
+        map.reserve(count);
+        for (UInt32 i = 0; i < count; ++i)
+        {
+            auto key = reader.ReadString();
+            map.emplace(std::move(key), reader.ReadString());
+        }
+    };
+
+    read_string_map(name_to_id_);
+    read_string_map(id_to_name_);
+    read_string_map(id_to_icon_);
+
+    const auto icon_count = reader.ReadCount(4);
+    exist_icons_.reserve(icon_count);
+    for (UInt32 i = 0; i < icon_count; ++i)
+        exist_icons_.emplace(reader.ReadString());
+
+    const auto entry_count = reader.ReadCount(sizeof(UInt64) + 12);
+    query_map_.reserve(entry_count);
+    for (UInt32 i = 0; i < entry_count; ++i)
+    {
+        const auto key = static_cast<CompositeHashKey>(reader.Read<UInt64>());
+        auto &entry = query_map_[key];
+        entry.has_content = true;
+        entry.char_query.id = reader.ReadString();
+        entry.char_query.phase = static_cast<EvolvePhase>(reader.Read<Int32>());
+        entry.char_query.level = reader.Read<Int32>();
+    }
+}
+void SkillLookupTable::WriteSnapshot(util::BinaryWriter &writer) const
+{
+    writer.Write(static_cast<UInt64>(HashString(kSingleBuffHashKey)));
+
+    const auto write_string_map = [&writer](const std::unordered_map<std::string, std::string> &map) {
+        writer.WriteCount(map.size());
+        for (const auto &[key, value] : map)
+        {
+            writer.WriteString(key);
+            writer.WriteString(value);
+        }
+    };
+
+    write_string_map(name_to_id_);
+    write_string_map(id_to_name_);
+    write_string_map(id_to_icon_);
+
+    writer.WriteCount(exist_icons_.size());
+    for (const auto &icon : exist_icons_)
+        writer.WriteString(icon);
+
+    // 构造完成后无效条目已被清理，只需保存查询结果
+    writer.WriteCount(query_map_.size());
+    for (const auto &[key, entry] : query_map_)
+    {
+        writer.Write(static_cast<UInt64>(key));
+        writer.WriteString(entry.char_query.id);
+        writer.Write(static_cast<Int32>(entry.char_query.phase));
+        writer.Write(static_cast<Int32>(entry.char_query.level));
+    }
+}
 void SkillLookupTable::InsertQueryItem(
     std::unordered_map<CompositeHashKey, MapEntry> &target,
     MapEntries &entries, const CharQueryEntry &query, const Vector<std::string> &buff_keys, const std::string &char_key)
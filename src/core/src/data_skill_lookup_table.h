@@ -4,6 +4,7 @@
 #pragma once
 #include "data_character_lookup_table.h"
 #include "data_game.h"
+#include "util_binary.h"
 #include "util_log.h"
 #include "albc_types.h"
 
@@ -76,6 +77,11 @@ class SkillLookupTable : public ISkillLookupTable
     explicit SkillLookupTable(std::shared_ptr<building::BuildingData> building_data,
                               std::shared_ptr<ICharacterLookupTable> char_lookup_table);
 
+    // 从游戏数据快照中恢复已构建好的查询表，跳过技能组合的枚举
+    explicit SkillLookupTable(util::BinaryReader &reader);
+
+    void WriteSnapshot(util::BinaryWriter &writer) const;
+
   private:
     std::unordered_map<std::string, std::string> name_to_id_;
     std::unordered_map<std::string, std::string> id_to_name_;
@@ -0,0 +1,239 @@
+#include "data_snapshot.h"
+
+namespace albc::data
+{
+namespace
+{
+constexpr char kSnapshotMagic[8] = {'A', 'L', 'B', 'C', 'S', 'N', 'A', 'P'};
+constexpr UInt32 kByteOrderMark = 0x01020304;
+
+constexpr bool HasSection(UInt32 mask, GameDataSnapshotSection section)
+{
+    return (mask & static_cast<UInt32>(section)) != 0;
+}
+
+void WriteBuildingData(util::BinaryWriter &writer, const building::BuildingData &building_data)
+{
+    writer.WriteCount(building_data.buffs.size());
+    for (const auto &[key, buff] : building_data.buffs)
+    {
+        writer.WriteString(key);
+        writer.WriteString(buff->buff_id);
+        writer.WriteString(buff->buff_name);
+        writer.WriteString(buff->skill_icon);
+        writer.Write(static_cast<Int32>(buff->sort_id));
+        writer.Write(static_cast<Int32>(buff->room_type));
+        writer.WriteString(buff->description);
+    }
+
+    writer.WriteCount(building_data.chars.size());
+    for (const auto &[key, character] : building_data.chars)
+    {
+        writer.WriteString(key);
+        writer.WriteString(character->char_id);
+        writer.Write(character->max_man_power);
+        writer.WriteCount(character->buff_char.size());
+        for (const auto &slot : character->buff_char)
+        {
+            writer.WriteCount(slot->buff_data.size());
+            for (const auto &item : slot->buff_data)
+            {
+                writer.WriteString(item.buff_id);
+                writer.Write(static_cast<Int32>(item.cond.phase));
+                writer.Write(static_cast<Int32>(item.cond.level));
+            }
+        }
+    }
+}
+
+std::shared_ptr<building::BuildingData> ReadBuildingData(util::BinaryReader &reader)
+{
+    auto building_data = std::make_shared<building::BuildingData>();
+
+    // 按写入顺序逐个追加，载入后遍历顺序与写入时一致
+    const auto buff_count = reader.ReadCount(4);
+    for (UInt32 i = 0; i < buff_count; ++i)
+    {
+        auto key = reader.ReadString();
+        auto buff = std::make_unique<building::BuildingBuff>();
+        buff->buff_id = reader.ReadString();
+        buff->buff_name = reader.ReadString();
+        buff->skill_icon = reader.ReadString();
+        buff->sort_id = reader.Read<Int32>();
+        buff->room_type = static_cast<building::RoomType>(reader.Read<Int32>());
+        buff->description = reader.ReadString();
+        building_data->buffs.emplace_hint(building_data->buffs.end(), std::move(key), std::move(buff));
+    }
+
+    const auto char_count = reader.ReadCount(4);
+    for (UInt32 i = 0; i < char_count; ++i)
+    {
+        auto key = reader.ReadString();
+        auto character = std::make_unique<building::BuildingCharacter>();
+        character->char_id = reader.ReadString();
+        character->max_man_power = reader.Read<Int64>();
+
+        const auto slot_count = reader.ReadCount(4);
+        character->buff_char.reserve(slot_count);
+        for (UInt32 j = 0; j < slot_count; ++j)
+        {
+            auto &slot = character->buff_char.emplace_back(std::make_unique<building::BuildingBuffCharSlot>());
+            const auto item_count = reader.ReadCount(4);
+            slot->buff_data.reserve(item_count);
+            for (UInt32 k = 0; k < item_count; ++k)
+            {
+                auto &item = slot->buff_data.emplace_back();
+                item.buff_id = reader.ReadString();
+                item.buff_atom = util::Atom::Intern(item.buff_id);
+                item.cond.phase = static_cast<EvolvePhase>(reader.Read<Int32>());
+                item.cond.level = reader.Read<Int32>();
+            }
+        }
+        building_data->chars.emplace_hint(building_data->chars.end(), std::move(key), std::move(character));
+    }
+
+    building_data->BuildAtomIndex();
+    return building_data;
+}
+
+void WriteCharacterTable(util::BinaryWriter &writer, const game::CharacterTable &character_table)
+{
+    writer.WriteCount(character_table.size());
+    for (const auto &[key, character] : character_table)
+    {
+        writer.WriteString(key);
+        writer.WriteString(character->name);
+        writer.WriteString(character->appellation);
+    }
+}
+
+std::shared_ptr<game::CharacterTable> ReadCharacterTable(util::BinaryReader &reader)
+{
+    auto character_table = std::make_shared<game::CharacterTable>();
+    const auto count = reader.ReadCount(4);
+    for (UInt32 i = 0; i < count; ++i)
+    {
+        auto key = reader.ReadString();
+        auto character = std::make_unique<game::CharacterData>();
+        character->name = reader.ReadString();
+        character->appellation = reader.ReadString();
+        character_table->emplace_hint(character_table->end(), std::move(key), std::move(character));
+    }
+    return character_table;
+}
+
+void WriteCharMetaTable(util::BinaryWriter &writer, const game::CharacterMetaTable &char_meta_table)
+{
+    writer.WriteCount(char_meta_table.sp_char_groups.size());
+    for (const auto &[key, group] : char_meta_table.sp_char_groups)
+    {
+        writer.WriteString(key);
+        writer.WriteCount(group.size());
+        for (const auto &char_id : group)
+            writer.WriteString(char_id);
+    }
+}
+
+std::shared_ptr<game::CharacterMetaTable> ReadCharMetaTable(util::BinaryReader &reader)
+{
+    auto char_meta_table = std::make_shared<game::CharacterMetaTable>();
+    auto &groups = char_meta_table->sp_char_groups;
+    const auto count = reader.ReadCount(4);
+    for (UInt32 i = 0; i < count; ++i)
+    {
+        auto key = reader.ReadString();
+        Vector<std::string> group(reader.ReadCount(4));
+        for (auto &char_id : group)
+            char_id = reader.ReadString();
+        groups.emplace_hint(groups.end(), std::move(key), std::move(group));
+    }
+    char_meta_table->InternGroups();
+    return char_meta_table;
+}
+} // namespace
+
+std::string SerializeGameDataSnapshot(const GameDataSnapshot &snapshot)
+{
+    UInt32 mask = 0;
+    util::BinaryWriter payload;
+    payload.Write(snapshot.building_data ? snapshot.building_data_hash : 0);
+    payload.Write(snapshot.character_table ? snapshot.character_table_hash : 0);
+    payload.Write(snapshot.char_meta_table ? snapshot.char_meta_table_hash : 0);
+    if (snapshot.building_data)
+    {
+        mask |= static_cast<UInt32>(GameDataSnapshotSection::BUILDING_DATA);
+        WriteBuildingData(payload, *snapshot.building_data);
+    }
+    if (snapshot.character_table)
+    {
+        mask |= static_cast<UInt32>(GameDataSnapshotSection::CHARACTER_TABLE);
+        WriteCharacterTable(payload, *snapshot.character_table);
+    }
+    if (snapshot.char_meta_table)
+    {
+        mask |= static_cast<UInt32>(GameDataSnapshotSection::CHAR_META_TABLE);
+        WriteCharMetaTable(payload, *snapshot.char_meta_table);
+    }
+    if (snapshot.skill_lookup_table)
+    {
+        mask |= static_cast<UInt32>(GameDataSnapshotSection::SKILL_LOOKUP_TABLE);
+        snapshot.skill_lookup_table->WriteSnapshot(payload);
+    }
+
+    util::BinaryWriter image;
+    image.WriteBytes(kSnapshotMagic, sizeof(kSnapshotMagic));
+    image.Write(kGameDataSnapshotVersion);
+    image.Write(kByteOrderMark);
+    image.Write(mask);
+    image.Write(static_cast<UInt32>(0)); // reserved
+    image.Write(static_cast<UInt64>(payload.Buffer().size()));
+    image.Write(util::Fnv1a64(payload.Buffer()));
+    image.Buffer().append(payload.Buffer());
+    return std::move(image.Buffer());
+}
+
+GameDataSnapshot DeserializeGameDataSnapshot(std::string_view image)
+{
+    util::BinaryReader reader(image);
+    if (reader.Remaining() < sizeof(kSnapshotMagic) ||
+        reader.ReadBytes(sizeof(kSnapshotMagic)) != std::string_view(kSnapshotMagic, sizeof(kSnapshotMagic)))
+        throw std::runtime_error("Not a game data snapshot");
+
+    if (const auto version = reader.Read<UInt32>(); version != kGameDataSnapshotVersion)
+        throw std::runtime_error("Unsupported game data snapshot version: " + std::to_string(version) +
+                                 ", expected: " + std::to_string(kGameDataSnapshotVersion));
+
+    if (reader.Read<UInt32>() != kByteOrderMark)
+        throw std::runtime_error("Game data snapshot byte order mismatch");
+
+    const auto mask = reader.Read<UInt32>();
+    reader.Read<UInt32>(); // reserved
+    const auto payload_size = reader.Read<UInt64>();
+    const auto checksum = reader.Read<UInt64>();
+    if (payload_size != reader.Remaining())
+        throw std::runtime_error("Game data snapshot is truncated");
+
+    const auto payload = reader.ReadBytes(static_cast<size_t>(payload_size));
+    if (util::Fnv1a64(payload) != checksum)
+        throw std::runtime_error("Game data snapshot checksum mismatch");
+
+    util::BinaryReader payload_reader(payload);
+    GameDataSnapshot snapshot;
+    snapshot.building_data_hash = payload_reader.Read<UInt64>();
+    snapshot.character_table_hash = payload_reader.Read<UInt64>();
+    snapshot.char_meta_table_hash = payload_reader.Read<UInt64>();
+    if (HasSection(mask, GameDataSnapshotSection::BUILDING_DATA))
+        snapshot.building_data = ReadBuildingData(payload_reader);
+    if (HasSection(mask, GameDataSnapshotSection::CHARACTER_TABLE))
+        snapshot.character_table = ReadCharacterTable(payload_reader);
+    if (HasSection(mask, GameDataSnapshotSection::CHAR_META_TABLE))
+        snapshot.char_meta_table = ReadCharMetaTable(payload_reader);
+    if (HasSection(mask, GameDataSnapshotSection::SKILL_LOOKUP_TABLE))
+        snapshot.skill_lookup_table = std::make_shared<game::SkillLookupTable>(payload_reader);
+
+    if (payload_reader.Remaining() != 0)
+        throw std::runtime_error("Game data snapshot has trailing data");
+
+    return snapshot;
+}
+} // namespace albc::data
@@ -0,0 +1,39 @@
+#pragma once
+#include "data_building.h"
+#include "data_character_meta_table.h"
+#include "data_character_table.h"
+#include "data_skill_lookup_table.h"
+
+namespace albc::data
+{
+// 游戏数据快照：将已解析的游戏数据及预构建的查询表序列化为带版本号的二进制镜像，
+// 载入时按顺序读取定长字段，不需要 JSON 解析，也不需要重新枚举技能组合。
+// 镜像与生成它的构建绑定（字节序、std::hash 实现），不兼容时载入会报错，需重新生成。
+static constexpr UInt32 kGameDataSnapshotVersion = 2;
+
+enum class GameDataSnapshotSection : UInt32
+{
+    BUILDING_DATA = 1 << 0,
+    CHARACTER_TABLE = 1 << 1,
+    CHAR_META_TABLE = 1 << 2,
+    SKILL_LOOKUP_TABLE = 1 << 3,
+};
+
+// 各成员可为空，为空的部分不写入镜像
+struct GameDataSnapshot
+{
+    std::shared_ptr<building::BuildingData> building_data;
+    std::shared_ptr<game::CharacterTable> character_table;
+    std::shared_ptr<game::CharacterMetaTable> char_meta_table;
+    std::shared_ptr<game::SkillLookupTable> skill_lookup_table;
+
+    // 各部分源 JSON 的哈希（见 GameDataTables），随镜像保存，使快照载入的数据与 JSON 载入的数据有相同的版本标识
+    UInt64 building_data_hash = 0;
+    UInt64 character_table_hash = 0;
+    UInt64 char_meta_table_hash = 0;
+};
+
+std::string SerializeGameDataSnapshot(const GameDataSnapshot &snapshot);
+
+GameDataSnapshot DeserializeGameDataSnapshot(std::string_view image);
+} // namespace albc::data
@@ -19,35 +19,29 @@ void ModifierApplier::MarkInvalid()
 }
 RoomBuff::RoomBuff()
     : owner_inst_id(0),
-    sort_id(0),
     duration(86400),
     prototype(static_cast<RoomBuff *>(this)),
-    is_mutex(false)
+    meta(std::make_shared<const RoomBuffMeta>())
 {
 }
 RoomBuff::RoomBuff(data::building::RoomType room_type, RoomBuffType inner_type)
     : owner_inst_id(0),
-      inner_type(inner_type),
-      room_type(room_type),
-      sort_id(0),
       duration(86400),
-      prototype(static_cast<RoomBuff *>(this)),
-      is_mutex(false)
+      prototype(static_cast<RoomBuff *>(this))
 {
+    auto init_meta = std::make_shared<RoomBuffMeta>();
+    init_meta->room_type = room_type;
+    init_meta->inner_type = inner_type;
+    meta = std::move(init_meta);
 }
 bool RoomBuff::ValidateTarget(const RoomModel *room)
 {
-    return std::all_of(validators.begin(), validators.end(),
+    return std::all_of(meta->validators.begin(), meta->validators.end(),
                        [room](const std::shared_ptr<RoomBuffTargetValidator>& validator) -> bool { return validator->validate(room); });
 }
-RoomBuff *RoomBuff::AddValidator(RoomBuffTargetValidator *validator)
-{
-    validators.emplace_back(validator);
-    return this;
-}
 void RoomBuff::UpdateScopeOnNeed(const ModifierScopeData &data)
 {
-    assert(this->inner_type != RoomBuffType::UNDEFINED && "RoomBuffType is undefined");
+    assert(this->meta->inner_type != RoomBuffType::UNDEFINED && "RoomBuffType is undefined");
     assert(this != prototype && "prototype should not be updated!");
     if (NeedUpdateScope(data))
     {
@@ -112,7 +106,7 @@ void IncEffByPowerPlantCnt::UpdateScope(const ModifierScopeData &data)
     const int power_plant_count = data.room->global_attributes.GetInt(GlobalAttributeType::POWER_PLANT_CNT);
 
     RoomFinalAttributeModifier::init(applier.final_mod, this,
-                                     inner_type,
+                                     meta->inner_type,
                                      power_plant_count * addition_per_power_plant_,
                                      0, // cap
                                      0,  // eff_delta_inc_hour
@@ -139,7 +133,6 @@ IncEffByOtherCapInc::IncEffByOtherCapInc(const int threshold, const double below
     : CloneableRoomBuff(data::building::RoomType::MANUFACTURE, RoomBuffType::FACTORY_INC_EFF_BY_CAP_ADDITION),
       threshold_(threshold), below_addition_(below_addition_per_limit), above_addition_(above_addition_per_limit)
 {
-    this->is_mutex = true;
     applier.scope.type = ModifierScopeType::DEPEND_ON_OTHER_CHAR;
 }
 void IncEffByOtherCapInc::UpdateScope(const ModifierScopeData &data)
@@ -157,7 +150,7 @@ void IncEffByOtherCapInc::UpdateScope(const ModifierScopeData &data)
         eff_delta += cap_delta >= threshold_ ? cap_delta * above_addition_ : cap_delta * below_addition_;
     }
     RoomAttributeModifier::init(applier.room_mod, this,
-                                inner_type,
+                                meta->inner_type,
                                 eff_delta); // eff
 }
 IncEffByGlobalAttribute::IncEffByGlobalAttribute(const double unit, const double addition_per_unit,
@@ -181,7 +174,7 @@ IncEffByGlobalAttribute::IncEffByGlobalAttribute(const double base_delta, const
 void IncEffByGlobalAttribute::UpdateScope(const ModifierScopeData &data)
 {
     RoomAttributeModifier::init(applier.room_mod, this,
-                                inner_type,
+                                meta->inner_type,
                                 base_delta_ + addition_per_unit_ * data.room->global_attributes[global_attribute_type_] / unit_);
     // eff
 }
@@ -203,14 +196,14 @@ void IncEffByStandardizationCnt::UpdateScope(const ModifierScopeData &data)
         if (buff->owner_inst_id == this->owner_inst_id)
             continue;
 
-        if (buff->inner_type == RoomBuffType::FACTORY_STANDARDIZATION)
+        if (buff->meta->inner_type == RoomBuffType::FACTORY_STANDARDIZATION)
         {
             addition += addition_per_unit_;
         }
     }
 
     RoomAttributeModifier::init(applier.room_mod, this,
-                                inner_type,
+                                meta->inner_type,
                                 addition); // eff
 }
 VodfoxTradeBuff::VodfoxTradeBuff()
@@ -221,7 +214,7 @@ VodfoxTradeBuff::VodfoxTradeBuff()
 void VodfoxTradeBuff::UpdateScope(const ModifierScopeData &data)
 {
     RoomFinalAttributeModifier::init(applier.final_mod, this,
-                                     inner_type,
+                                     meta->inner_type,
                                      (data.room->max_slot_count - 1) * 0.45, // eff
                                      0,  // cap
                                      0., // eff_inc_hour
@@ -237,9 +230,6 @@ JayeTradeBuff::JayeTradeBuff(bool is_above_elite_one)
       is_above_elite_one_(is_above_elite_one)
 {
     applier.scope.type = ModifierScopeType::DEPEND_ON_OTHER_CHAR;
-
-    if (is_above_elite_one)
-        this->patch_targets.push_back("trade_ord_limit_diff[000]"); // 干掉孑哥的满血buff
 }
 void JayeTradeBuff::UpdateScope(const ModifierScopeData &data)
 {
@@ -267,7 +257,7 @@ void JayeTradeBuff::UpdateScope(const ModifierScopeData &data)
     }
 
     RoomAttributeModifier::init(applier.room_mod, this,
-                                inner_type,
+                                meta->inner_type,
                                 0.04 * std::max(total_cap - data.room->room_attributes.prod_cnt, 0), // eff
                                 total_cap - data.room->room_attributes.base_prod_cap); // cap
 }
@@ -280,7 +270,8 @@ LapplandTradeBuff::LapplandTradeBuff(double cost_delta, int cap_delta)
 }
 void LapplandTradeBuff::UpdateLookup(const data::player::PlayerTroopLookup &lookup)
 {
-    texas_char_inst_id_ = lookup.GetInstId("char_102_texas");
+    static const auto texas = util::Atom::Intern("char_102_texas");
+    texas_char_inst_id_ = lookup.GetInstId(texas);
     enabled_ = texas_char_inst_id_ >= 0;
 }
 void LapplandTradeBuff::UpdateScope(const ModifierScopeData &data)
@@ -298,7 +289,7 @@ void LapplandTradeBuff::UpdateScope(const ModifierScopeData &data)
     if (texas != end)
     {
         RoomAttributeModifier::init(this->applier.room_mod, this,
-                                    inner_type,
+                                    meta->inner_type,
                                     0., // eff_delta
                                     cap_delta_); // cap_delta
 
@@ -316,17 +307,14 @@ TexasTradeBuff::TexasTradeBuff(bool affected_by_angel)
     : CloneableRoomBuff<TexasTradeBuff>(data::building::RoomType::TRADING, RoomBuffType::TRADING_FEUD),
       affected_by_angel_(affected_by_angel)
 {
-    if (affected_by_angel)
-    {
-        this->patch_targets = {"trade_ord_spd&cost_P[000]"};
-    }
-
     applier.scope.type = ModifierScopeType::DEPEND_ON_OTHER_CHAR;
 }
 void TexasTradeBuff::UpdateLookup(const data::player::PlayerTroopLookup &lookup)
 {
-    angel_char_inst_id_ = lookup.GetInstId("char_103_angel");
-    lappland_char_inst_id_ = lookup.GetInstId("char_140_whitew");
+    static const auto angel = util::Atom::Intern("char_103_angel");
+    static const auto lappland = util::Atom::Intern("char_140_whitew");
+    angel_char_inst_id_ = lookup.GetInstId(angel);
+    lappland_char_inst_id_ = lookup.GetInstId(lappland);
 
     enabled_ = angel_char_inst_id_ >= 0 || lappland_char_inst_id_ >= 0;
 }
@@ -367,7 +355,7 @@ void TexasTradeBuff::UpdateScope(const ModifierScopeData &data)
     }
 
     RoomAttributeModifier::init(this->applier.room_mod, this,
-                                inner_type,
+                                meta->inner_type,
                                 eff_delta, // eff_delta
                                 0); // cap_delta
 
@@ -1,4 +1,5 @@
 ﻿#pragma once
+#include "util_atom.h"
 #include "util_attributes.h"
 #include "model_buff_primitives.h"
 #include "data_building.h"
@@ -57,25 +58,33 @@ class ModifierApplier
 };
 
 /**
- * @brief 房间buff
+ * @brief 房间buff的不可变元数据, 同一次建模中同一Buff的所有实例共享一份
+ */
+struct RoomBuffMeta
+{
+    util::Atom buff_id{}; // Buff的Id
+    std::string name;
+    std::string description; //已去除xml标签
+    RoomBuffType inner_type{RoomBuffType::UNDEFINED}; //内部类型
+    data::building::RoomType room_type{data::building::RoomType::NONE}; //作用房间类型
+    int sort_id = 0; //排序id
+    mem::PtrVector<RoomBuffTargetValidator, std::shared_ptr> validators; //作用范围验证器
+    Vector<util::Atom> patch_targets; //指定该buff将会替代掉哪些buff的效果
+    bool is_mutex = false; //是否会与同类Buff互斥
+};
+
+/**
+ * @brief 房间buff, 只保存每个实例各自的可变状态, 其余数据见 meta
  */
 class RoomBuff
 {
   public:
     int owner_inst_id;  //拥有该Buff的干员的实例Id
-    std::string owner_char_id{}; //拥有该Buff的角色Id
-    std::string buff_id{};       // Buff的Id
-    std::string name;
-    std::string description;
-    RoomBuffType inner_type{RoomBuffType::UNDEFINED}; //内部类型
-    mem::PtrVector<RoomBuffTargetValidator, std::shared_ptr> validators;     //作用范围验证器
-    data::building::RoomType room_type{data::building::RoomType::NONE};       //作用房间类型
-    int sort_id;                                  //排序id
+    util::Atom owner_char_id{}; //拥有该Buff的角色Id
     double duration;                          //持续时间，由干员的心情决定
     ModifierApplier applier{};
     RoomBuff *const prototype;
-    Vector<std::string> patch_targets; //指定该buff将会替代掉哪些buff的效果
-    bool is_mutex;        //是否会与同类Buff互斥
+    std::shared_ptr<const RoomBuffMeta> meta; //共享的元数据
 
     RoomBuff();
 
@@ -88,7 +97,8 @@ class RoomBuff
     RoomBuff(RoomBuff &&src) noexcept = default;
     RoomBuff &operator=(RoomBuff &&src) noexcept = delete;
 
-    virtual RoomBuff *Clone() = 0;
+    // 在 arena 中复制一个实例，实例随 arena 一并销毁
+    virtual RoomBuff *Clone(mem::Arena &arena) = 0;
 
     virtual bool ValidateTarget(const RoomModel *room);
 
@@ -100,8 +110,6 @@ class RoomBuff
     {
     }
 
-    virtual RoomBuff *AddValidator(RoomBuffTargetValidator *validator);
-
     void UpdateScopeOnNeed(const ModifierScopeData &data);
 
   private:
@@ -117,10 +125,10 @@ template <typename TDerived> class CloneableRoomBuff : public RoomBuff
     // inherit constructor
     using RoomBuff::RoomBuff;
 
-    RoomBuff *Clone() final
+    RoomBuff *Clone(mem::Arena &arena) final
     {
-        return prototype == this ? new TDerived(static_cast<const TDerived &>(*this))
-                                 : prototype->Clone();
+        return prototype == this ? arena.New<TDerived>(static_cast<const TDerived &>(*this))
+                                 : prototype->Clone(arena);
     }
 };
 
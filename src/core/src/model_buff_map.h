@@ -1,21 +1,62 @@
 #pragma once
 
 #include "model_buff.h"
+#include "model_buff_table.h"
 #include "albc_types.h"
-#include "util_time.h"
+
+#include <atomic>
 
 namespace albc::model::buff
 {
-void init_buffs(Dictionary<std::string, RoomBuff *> &buffs);
+// 由描述符构造Buff原型
+RoomBuff *make_buff(const BuffDescriptor &descriptor);
+
+// Buff原型表：描述符在编译期确定（见 model_buff_table.h），原型在首次被查找时才构造
+class BuffMap
+{
+  public:
+    static const BuffMap &instance();
+
+    ~BuffMap();
+
+    BuffMap(const BuffMap &) = delete;
+    BuffMap &operator=(const BuffMap &) = delete;
+
+    [[nodiscard]] static bool Contains(std::string_view buff_id)
+    {
+        return FindBuffDescriptorIndex(buff_id) >= 0;
+    }
 
-class BuffMap : public Dictionary<std::string, RoomBuff *>
+    [[nodiscard]] static bool Contains(util::Atom buff_id)
+    {
+        return Contains(buff_id.str());
+    }
+
+    // 取得Buff原型，未实现的Buff返回 nullptr。线程安全
+    [[nodiscard]] RoomBuff *GetPrototype(util::Atom buff_id) const;
+
+  private:
+    mutable Array<std::atomic<RoomBuff *>, kBuffDescriptorCount> prototypes_{};
+
+    BuffMap() = default;
+};
+
+// 一次建模内的Buff元数据缓存：名称、描述等取自 building_data，同一Buff的所有实例共享一份
+class RoomBuffMetaCache
 {
   public:
-    static std::shared_ptr<const Dictionary<std::string, RoomBuff *>> instance();
+    explicit RoomBuffMetaCache(const data::building::BuildingData &building_data);
+
+    [[nodiscard]] const data::building::BuildingData &GetBuildingData() const
+    {
+        return building_data_;
+    }
 
-    virtual ~BuffMap();
+    // 取得原型对应的元数据，building_data 中没有该Buff时返回 nullptr
+    std::shared_ptr<const RoomBuffMeta> Get(const RoomBuff &prototype);
 
   private:
-    BuffMap();
+    const data::building::BuildingData &building_data_;
+    HashDictionary<util::Atom, std::shared_ptr<const RoomBuffMeta>> metas_;
 };
-} // namespace albc::buff_map
\ No newline at end of file
+} // namespace albc::model::buff
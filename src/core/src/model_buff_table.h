@@ -0,0 +1,527 @@
+#pragma once
+#include "model_buff_primitives.h"
+#include "albc_types.h"
+
+#include <algorithm>
+#include <iterator>
+#include <stdexcept>
+#include <string_view>
+
+namespace albc::model::buff
+{
+/**
+ * @brief Buff的实现类型, 决定原型由哪个RoomBuff子类构造, 以及BuffDescriptor中数值参数的含义
+ */
+enum class BuffKind
+{
+    BASIC_INC,                      // args: eff_delta, -, cost_delta; int_arg: cap_delta
+    INC_EFF_OVER_TIME,              // args: base_eff_delta, eff_inc_per_hour, max_extra_eff_inc
+    INC_EFF_BY_POWER_PLANT_CNT,     // args: addition_per_power_plant
+    INC_EFF_BY_OTHER_EFF_INC,       // args: unit_addition, unit_factor, max_extra_addition
+    INC_EFF_BY_OTHER_CAP_INC,       // args: below_addition, above_addition; int_arg: threshold
+    INC_EFF_BY_GLOBAL_ATTRIBUTE,    // args: base_delta, unit, addition_per_unit
+    INC_EFF_BY_STANDARDIZATION_CNT, // args: addition_per_unit
+    VODFOX_TRADE,                   //
+    JAYE_TRADE,                     // int_arg: is_above_elite_one
+    LAPPLAND_TRADE,                 // args: cost_delta; int_arg: cap_delta
+    TEXAS_TRADE,                    // int_arg: affected_by_angel
+};
+
+constexpr UInt32 ProdTypeMask(ProdType prod_type)
+{
+    return 1U << static_cast<int>(prod_type);
+}
+
+/**
+ * @brief Buff描述符: 构造一个Buff原型所需的全部数据, 可在编译期求值
+ */
+struct BuffDescriptor
+{
+    std::string_view buff_id;
+    BuffKind kind;
+    data::building::RoomType room_type;
+    RoomBuffType inner_type;
+    Array<double, 3> args;
+    int int_arg;
+    CharCostModifierType cost_mod_type;
+    GlobalAttributeType global_attribute_type;
+    UInt32 validator_mask; // 由 ProdTypeMask 组成, 每一位对应一个 ProdTypeSelector, 0 表示不限
+    bool is_mutex;                  // 是否会与同类Buff互斥
+    std::string_view patch_target;  // 该Buff将会替代掉的Buff, 空表示无
+};
+
+namespace desc
+{
+using data::building::RoomType;
+
+constexpr BuffDescriptor BasicInc(std::string_view id, double eff_delta, int cap_delta, RoomType room_type,
+                                  RoomBuffType inner_type, UInt32 validator_mask = 0)
+{
+    return {id, BuffKind::BASIC_INC, room_type, inner_type, {eff_delta, 0., 0.}, cap_delta,
+            CharCostModifierType::NONE, GlobalAttributeType::CHAIN_OF_THOUGHT, validator_mask, false, {}};
+}
+
+constexpr BuffDescriptor BasicInc(std::string_view id, double eff_delta, int cap_delta, double cost_delta,
+                                  CharCostModifierType cost_mod_type, RoomType room_type, RoomBuffType inner_type,
+                                  UInt32 validator_mask = 0)
+{
+    return {id, BuffKind::BASIC_INC, room_type, inner_type, {eff_delta, 0., cost_delta}, cap_delta,
+            cost_mod_type, GlobalAttributeType::CHAIN_OF_THOUGHT, validator_mask, false, {}};
+}
+
+constexpr BuffDescriptor IncEffOverTime(std::string_view id, double base_eff_delta, double eff_inc_per_hour,
+                                        double max_extra_eff_inc, RoomType room_type, RoomBuffType inner_type)
+{
+    return {id, BuffKind::INC_EFF_OVER_TIME, room_type, inner_type,
+            {base_eff_delta, eff_inc_per_hour, max_extra_eff_inc},
+            0, CharCostModifierType::NONE, GlobalAttributeType::CHAIN_OF_THOUGHT, 0, false, {}};
+}
+
+constexpr BuffDescriptor IncEffByPowerPlantCnt(std::string_view id, double addition_per_power_plant)
+{
+    return {id, BuffKind::INC_EFF_BY_POWER_PLANT_CNT, RoomType::MANUFACTURE,
+            RoomBuffType::FACTORY_INC_EFF_BY_POWER_PLANT, {addition_per_power_plant, 0., 0.},
+            0, CharCostModifierType::NONE, GlobalAttributeType::CHAIN_OF_THOUGHT, 0, false, {}};
+}
+
+constexpr BuffDescriptor IncEffByOtherEffInc(std::string_view id, double unit_addition, double unit_factor,
+                                             double max_extra_addition, RoomType room_type, RoomBuffType inner_type)
+{
+    return {id, BuffKind::INC_EFF_BY_OTHER_EFF_INC, room_type, inner_type,
+            {unit_addition, unit_factor, max_extra_addition},
+            0, CharCostModifierType::NONE, GlobalAttributeType::CHAIN_OF_THOUGHT, 0, false, {}};
+}
+
+constexpr BuffDescriptor IncEffByOtherCapInc(std::string_view id, int threshold, double below_addition_per_limit,
+                                             double above_addition_per_limit)
+{
+    return {id, BuffKind::INC_EFF_BY_OTHER_CAP_INC, RoomType::MANUFACTURE,
+            RoomBuffType::FACTORY_INC_EFF_BY_CAP_ADDITION, {below_addition_per_limit, above_addition_per_limit, 0.},
+            threshold, CharCostModifierType::NONE, GlobalAttributeType::CHAIN_OF_THOUGHT, 0, true, {}};
+}
+
+constexpr BuffDescriptor IncEffByGlobalAttribute(std::string_view id, double base_delta, double unit,
+                                                 double addition_per_unit, GlobalAttributeType global_attribute_type,
+                                                 RoomType room_type, RoomBuffType inner_type, UInt32 validator_mask = 0)
+{
+    return {id, BuffKind::INC_EFF_BY_GLOBAL_ATTRIBUTE, room_type, inner_type, {base_delta, unit, addition_per_unit},
+            0, CharCostModifierType::NONE, global_attribute_type, validator_mask, false, {}};
+}
+
+constexpr BuffDescriptor IncEffByStandardizationCnt(std::string_view id, double addition_per_unit, RoomType room_type,
+                                                    RoomBuffType inner_type)
+{
+    return {id, BuffKind::INC_EFF_BY_STANDARDIZATION_CNT, room_type, inner_type, {addition_per_unit, 0., 0.},
+            0, CharCostModifierType::NONE, GlobalAttributeType::CHAIN_OF_THOUGHT, 0, false, {}};
+}
+
+constexpr BuffDescriptor VodfoxTradeBuff(std::string_view id)
+{
+    return {id, BuffKind::VODFOX_TRADE, RoomType::TRADING, RoomBuffType::TRADING_WHISPERS, {0., 0., 0.},
+            0, CharCostModifierType::ROOM_ALL, GlobalAttributeType::CHAIN_OF_THOUGHT, 0, false, {}};
+}
+
+constexpr BuffDescriptor JayeTradeBuff(std::string_view id, bool is_above_elite_one)
+{
+    return {id, BuffKind::JAYE_TRADE, RoomType::TRADING, RoomBuffType::TRADING_BASIC_NEEDS, {0., 0., 0.},
+            is_above_elite_one, CharCostModifierType::NONE, GlobalAttributeType::CHAIN_OF_THOUGHT, 0, false,
+            is_above_elite_one ? "trade_ord_limit_diff[000]" : ""}; // 干掉孑哥的满血buff
+}
+
+constexpr BuffDescriptor LapplandTradeBuff(std::string_view id, double cost_delta, int cap_delta)
+{
+    return {id, BuffKind::LAPPLAND_TRADE, RoomType::TRADING, RoomBuffType::TRADING_HIDDEN_PURPOSE, {cost_delta, 0., 0.},
+            cap_delta, CharCostModifierType::SELF, GlobalAttributeType::CHAIN_OF_THOUGHT, 0, false, {}};
+}
+
+constexpr BuffDescriptor TexasTradeBuff(std::string_view id, bool affected_by_angel)
+{
+    return {id, BuffKind::TEXAS_TRADE, RoomType::TRADING, RoomBuffType::TRADING_FEUD, {0., 0., 0.},
+            affected_by_angel, CharCostModifierType::SELF, GlobalAttributeType::CHAIN_OF_THOUGHT, 0, false,
+            affected_by_angel ? "trade_ord_spd&cost_P[000]" : ""};
+}
+} // namespace desc
+
+// 所有已实现的Buff, 按 buff_id 排序
+inline constexpr BuffDescriptor kBuffDescriptors[] = {
+    // 团队精神: 进驻制造站时，消除当前制造站内所有干员自身心情消耗的影响
+    desc::BasicInc("manu_cost_all[000]",
+        0, 0, 0, CharCostModifierType::ROOM_CLEAR_ALL,
+        data::building::RoomType::MANUFACTURE, RoomBuffType::FACTORY_TRAM_SPIRIT),
+    desc::BasicInc("manu_formula_cost[000]",
+        0, 0, -0.25, CharCostModifierType::SELF,
+        data::building::RoomType::MANUFACTURE, RoomBuffType::FACTORY_VLOG, ProdTypeMask(ProdType::RECORD)),
+    desc::BasicInc("manu_formula_limit[0000]",
+        0, 12, data::building::RoomType::MANUFACTURE, RoomBuffType::FACTORY_VLOG, ProdTypeMask(ProdType::RECORD)),
+    desc::BasicInc("manu_formula_limit[010]",
+        0, 15, data::building::RoomType::MANUFACTURE, RoomBuffType::FACTORY_VLOG, ProdTypeMask(ProdType::RECORD)),
+    desc::BasicInc("manu_formula_spd[000]",
+        0.3, 0,
+        data::building::RoomType::MANUFACTURE, RoomBuffType::FACTORY_INC_EFF_RECORD, ProdTypeMask(ProdType::RECORD)),
+    desc::BasicInc("manu_formula_spd[010]",
+        0.3, 0,
+        data::building::RoomType::MANUFACTURE, RoomBuffType::FACTORY_INC_EFF_RECORD, ProdTypeMask(ProdType::RECORD)),
+    desc::BasicInc("manu_formula_spd[020]",
+        0.35, 0,
+        data::building::RoomType::MANUFACTURE, RoomBuffType::FACTORY_INC_EFF_RECORD, ProdTypeMask(ProdType::RECORD)),
+    desc::BasicInc("manu_formula_spd[100]",
+        0.3, 0,
+        data::building::RoomType::MANUFACTURE, RoomBuffType::FACTORY_INC_EFF_GOLD, ProdTypeMask(ProdType::GOLD)),
+    desc::BasicInc("manu_formula_spd[101]",
+        0.35, 0,
+        data::building::RoomType::MANUFACTURE, RoomBuffType::FACTORY_INC_EFF_GOLD, ProdTypeMask(ProdType::GOLD)),
+    desc::BasicInc("manu_formula_spd[200]",
+        0.30, 0,
+        data::building::RoomType::MANUFACTURE, RoomBuffType::FACTORY_INC_EFF_ORIGINIUM,
+        ProdTypeMask(ProdType::ORIGINIUM_SHARD)),
+    desc::BasicInc("manu_formula_spd[201]",
+        0.30, 0,
+        data::building::RoomType::MANUFACTURE, RoomBuffType::FACTORY_INC_EFF_ORIGINIUM,
+        ProdTypeMask(ProdType::ORIGINIUM_SHARD)),
+    desc::BasicInc("manu_formula_spd[210]",
+        0.35, 0,
+        data::building::RoomType::MANUFACTURE, RoomBuffType::FACTORY_INC_EFF_ORIGINIUM,
+        ProdTypeMask(ProdType::ORIGINIUM_SHARD)),
+    desc::BasicInc("manu_formula_spd[211]",
+        0.35, 0,
+        data::building::RoomType::MANUFACTURE, RoomBuffType::FACTORY_INC_EFF_ORIGINIUM,
+        ProdTypeMask(ProdType::ORIGINIUM_SHARD)),
+    desc::BasicInc("manu_formula_spd[212]",
+        0.35, 0,
+        data::building::RoomType::MANUFACTURE, RoomBuffType::FACTORY_INC_EFF_ORIGINIUM,
+        ProdTypeMask(ProdType::ORIGINIUM_SHARD)),
+    desc::BasicInc("manu_formula_spd[213]",
+        0.35, 0,
+        data::building::RoomType::MANUFACTURE, RoomBuffType::FACTORY_INC_EFF_ORIGINIUM,
+        ProdTypeMask(ProdType::ORIGINIUM_SHARD)),
+    desc::BasicInc("manu_prod_limit&cost[0000]",
+        0, 8, -0.25, CharCostModifierType::SELF, data::building::RoomType::MANUFACTURE, RoomBuffType::FACTORY_JUNKMAN),
+    desc::BasicInc("manu_prod_limit&cost[000]",
+        0, 8, -0.25, CharCostModifierType::SELF, data::building::RoomType::MANUFACTURE, RoomBuffType::FACTORY_JUNKMAN),
+    desc::BasicInc("manu_prod_limit&cost[001]",
+        0, 8, -0.25, CharCostModifierType::SELF, data::building::RoomType::MANUFACTURE, RoomBuffType::FACTORY_JUNKMAN),
+    desc::BasicInc("manu_prod_limit&cost[002]",
+        0, 8, -0.25, CharCostModifierType::SELF, data::building::RoomType::MANUFACTURE, RoomBuffType::FACTORY_JUNKMAN),
+    desc::BasicInc("manu_prod_limit&cost[003]",
+        0, 8, -0.25, CharCostModifierType::SELF, data::building::RoomType::MANUFACTURE, RoomBuffType::FACTORY_JUNKMAN),
+    desc::BasicInc("manu_prod_limit&cost[010]",
+        0, 10, -0.25, CharCostModifierType::SELF, data::building::RoomType::MANUFACTURE, RoomBuffType::FACTORY_JUNKMAN),
+    desc::BasicInc("manu_prod_limit&cost[020]",
+        0, 16, -0.25, CharCostModifierType::SELF, data::building::RoomType::MANUFACTURE, RoomBuffType::FACTORY_JUNKMAN),
+    desc::BasicInc("manu_prod_spd&limit&cost[000]",
+        -0.05, 16, -0.15, CharCostModifierType::SELF,
+        data::building::RoomType::MANUFACTURE, RoomBuffType::FACTORY_CRAFTSMANSHIP_SPIRIT),
+    desc::BasicInc("manu_prod_spd&limit&cost[001]",
+        -0.05, 19, -0.25, CharCostModifierType::SELF,
+        data::building::RoomType::MANUFACTURE, RoomBuffType::FACTORY_CRAFTSMANSHIP_SPIRIT),
+    desc::BasicInc("manu_prod_spd&limit&cost[010]",
+        0.25, -12, 0.25, CharCostModifierType::SELF,
+        data::building::RoomType::MANUFACTURE, RoomBuffType::FACTORY_TROUBLE_MAKER),
+    desc::BasicInc("manu_prod_spd&limit&cost[011]",
+        0.25, -12, 0.25, CharCostModifierType::SELF,
+        data::building::RoomType::MANUFACTURE, RoomBuffType::FACTORY_TROUBLE_MAKER),
+    desc::BasicInc("manu_prod_spd&limit&cost[020]",
+        -0.2, 17, -0.25, CharCostModifierType::SELF,
+        data::building::RoomType::MANUFACTURE, RoomBuffType::FACTORY_TROUBLE_MAKER),
+    desc::BasicInc("manu_prod_spd&limit[000]",
+        0.1, 6, data::building::RoomType::MANUFACTURE, RoomBuffType::FACTORY_INC_EFF_AND_CAP),
+    desc::BasicInc("manu_prod_spd&limit[001]",
+        0.1, 10, data::building::RoomType::MANUFACTURE, RoomBuffType::FACTORY_INC_EFF_AND_CAP),
+    desc::IncEffByPowerPlantCnt("manu_prod_spd&power[000]", 0.05),
+    desc::IncEffByPowerPlantCnt("manu_prod_spd&power[010]", 0.10),
+    desc::IncEffByPowerPlantCnt("manu_prod_spd&power[020]", 0.15),
+    desc::IncEffByGlobalAttribute("manu_prod_spd&trade[000]",
+        0, 1, 0.2, GlobalAttributeType::TRADING_POST_CNT,
+        data::building::RoomType::MANUFACTURE, RoomBuffType::FACTORY_INC_EFF_BY_TRADING_POST_CNT,
+        ProdTypeMask(ProdType::GOLD)),
+    desc::BasicInc("manu_prod_spd[000]",
+        0.15, 0, data::building::RoomType::MANUFACTURE, RoomBuffType::FACTORY_INC_EFF_ALL),
+    desc::BasicInc("manu_prod_spd[001]",
+        0.15, 0, data::building::RoomType::MANUFACTURE, RoomBuffType::FACTORY_INC_EFF_ALL),
+    desc::BasicInc("manu_prod_spd[002]",
+        0.15, 0, data::building::RoomType::MANUFACTURE, RoomBuffType::FACTORY_INC_EFF_ALL),
+    // 磐蟹·豆豆: 进驻制造站时，生产力+15%
+    desc::BasicInc("manu_prod_spd[003]",
+        0.15, 0, data::building::RoomType::MANUFACTURE, RoomBuffType::FACTORY_INC_EFF_ALL),
+    desc::BasicInc("manu_prod_spd[010]",
+        0.25, 0, data::building::RoomType::MANUFACTURE, RoomBuffType::FACTORY_INC_EFF_ALL),
+    desc::BasicInc("manu_prod_spd[011]",
+        0.25, 0, data::building::RoomType::MANUFACTURE, RoomBuffType::FACTORY_INC_EFF_ALL),
+    // 红松骑士团·β: 进驻制造站时，生产力+25%
+    desc::BasicInc("manu_prod_spd[012]",
+        0.25, 0, data::building::RoomType::MANUFACTURE, RoomBuffType::FACTORY_INC_EFF_ALL),
+    // 咪波·制造型: 进驻制造站时，生产力+30%
+    desc::BasicInc("manu_prod_spd[020]",
+        0.30, 0, data::building::RoomType::MANUFACTURE, RoomBuffType::FACTORY_INC_EFF_ALL),
+    desc::BasicInc("manu_prod_spd[021]",
+        0.3, 0, data::building::RoomType::MANUFACTURE, RoomBuffType::FACTORY_INC_EFF_ALL),
+    desc::IncEffOverTime("manu_prod_spd_addition[030]",
+        0.2, 0.01, 0.05, data::building::RoomType::MANUFACTURE, RoomBuffType::FACTORY_HOTHEAD),
+    desc::IncEffOverTime("manu_prod_spd_addition[031]",
+        0.2, 0.01, 0.05, data::building::RoomType::MANUFACTURE, RoomBuffType::FACTORY_HOTHEAD),
+    desc::IncEffOverTime("manu_prod_spd_addition[040]",
+        0.15, 0.02, 0.10, data::building::RoomType::MANUFACTURE, RoomBuffType::FACTORY_SLOWCOACH),
+    desc::IncEffOverTime("manu_prod_spd_addition[041]",
+        0.15, 0.02, 0.10, data::building::RoomType::MANUFACTURE, RoomBuffType::FACTORY_SLOWCOACH),
+    desc::IncEffByGlobalAttribute("manu_prod_spd_bd[000]",
+        0, 1, 0.005, GlobalAttributeType::CHAIN_OF_THOUGHT,
+        data::building::RoomType::MANUFACTURE, RoomBuffType::FACTORY_INC_EFF_BY_CHAIN_OF_THOUGHT),
+    desc::IncEffByGlobalAttribute("manu_prod_spd_bd[010]",
+        0, 1, 0.01, GlobalAttributeType::CHAIN_OF_THOUGHT,
+        data::building::RoomType::MANUFACTURE, RoomBuffType::FACTORY_INC_EFF_BY_CHAIN_OF_THOUGHT),
+    desc::IncEffByOtherEffInc("manu_prod_spd_variable2[000]",
+        0.05, 0.05, 0.4, data::building::RoomType::MANUFACTURE, RoomBuffType::FACTORY_INC_EFF_BY_OTHER_EFF_INC),
+    desc::IncEffByOtherCapInc("manu_prod_spd_variable3[000]", 16, 0.01, 0.03),
+    desc::IncEffByOtherCapInc("manu_prod_spd_variable[000]", 0, 0.02, 0.02),  // TODO:优先级
+    // 意识协议: 进驻制造站时，当前制造站内每个标准化类技能为自身+5%的生产力
+    desc::IncEffByStandardizationCnt("manu_skill_spd1[010]",
+        0.05, data::building::RoomType::MANUFACTURE, RoomBuffType::FACTORY_INC_EFF_BY_STANDARDIZATION_CNT),
+    // 谈判: 进驻贸易站时，订单上限+5，心情每小时消耗-0.25
+    desc::BasicInc("trade_ord_limit&cost[000]",
+        0, 5, -0.25, CharCostModifierType::SELF, data::building::RoomType::TRADING, RoomBuffType::TRADING_NEGOTIATION),
+    // 醉翁之意·α: 当与德克萨斯在同一个贸易站时，心情每小时消耗-0.1，订单上限+2
+    desc::LapplandTradeBuff("trade_ord_limit&cost_P[000]", -0.1, 2),
+    // 醉翁之意·β: 当与德克萨斯在同一个贸易站时，心情每小时消耗-0.1，订单上限+4
+    desc::LapplandTradeBuff("trade_ord_limit&cost_P[001]", -0.1, 4),
+    // 默契: 当与能天使在同一个贸易站时，心情每小时消耗-0.3
+    desc::TexasTradeBuff("trade_ord_limit&cost_P[010]", true),
+    // 市井之道: 进驻贸易站时，当前贸易站内其他干员提供的每10%订单获取效率使订单上限-1（订单最少为1），同时每有1笔订单就+4%订单获取效率
+    desc::JayeTradeBuff("trade_ord_limit_count[000]", true),
+    // 摊贩经济: 进驻贸易站时，当前订单数与订单上限每差1笔订单，则订单获取效率+4%
+    desc::JayeTradeBuff("trade_ord_limit_diff[000]", false),
+    // 交际: 进驻贸易站时，订单获取效率+30%，心情每小时消耗-0.25
+    desc::BasicInc("trade_ord_spd&cost[000]",
+        0.3, 0, -0.25, CharCostModifierType::SELF, data::building::RoomType::TRADING, RoomBuffType::TRADING_COMM),
+    // 恩怨: 当与拉普兰德在同一个贸易站时，心情每小时消耗+0.3，订单获取效率+65%
+    desc::TexasTradeBuff("trade_ord_spd&cost_P[000]", false),
+    // 虔诚筹款·α: 进驻贸易站时，每间宿舍每级+1%获取效率
+    desc::IncEffByGlobalAttribute("trade_ord_spd&dorm&lv[000]",
+        0, 1, 0.01, GlobalAttributeType::DORM_SUM_LEVEL,
+        data::building::RoomType::TRADING, RoomBuffType::TRADING_FUNDRAISING),
+    // 虔诚筹款·β: 进驻贸易站时，每间宿舍每级+2%获取效率
+    desc::IncEffByGlobalAttribute("trade_ord_spd&dorm&lv[010]",
+        0, 1, 0.02, GlobalAttributeType::DORM_SUM_LEVEL,
+        data::building::RoomType::TRADING, RoomBuffType::TRADING_FUNDRAISING),
+    // 物流规划·α: 进驻贸易站时，订单获取效率+5%，每有4条赤金生产线，则当前贸易站订单获取效率额外+15%
+    desc::IncEffByGlobalAttribute("trade_ord_spd&gold[000]",
+        0.05, 4, 0.15, GlobalAttributeType::GOLD_PROD_LINE_CNT,
+        data::building::RoomType::TRADING, RoomBuffType::TRADING_ORDER_FLOW_VISUALIZATION),
+    // 物流规划·β: 进驻贸易站时，订单获取效率+5%，每有2条赤金生产线，则当前贸易站订单获取效率额外+15%
+    desc::IncEffByGlobalAttribute("trade_ord_spd&gold[010]",
+        0.05, 2, 0.15, GlobalAttributeType::GOLD_PROD_LINE_CNT,
+        data::building::RoomType::TRADING, RoomBuffType::TRADING_ORDER_FLOW_VISUALIZATION),
+    // 订单管理·α: 进驻贸易站时，订单获取效率+10%，且订单上限+2
+    desc::BasicInc("trade_ord_spd&limit[000]",
+        0.1, 2, 0, CharCostModifierType::SELF,
+        data::building::RoomType::TRADING, RoomBuffType::TRADING_INC_EFF_AND_CAP),
+    // 订单管理·β: 进驻贸易站时，订单获取效率+10%，且订单上限+4
+    desc::BasicInc("trade_ord_spd&limit[001]",
+        0.1, 4, 0, CharCostModifierType::SELF,
+        data::building::RoomType::TRADING, RoomBuffType::TRADING_INC_EFF_AND_CAP),
+    desc::BasicInc("trade_ord_spd&limit[010]",
+        0.25, 1, data::building::RoomType::TRADING, RoomBuffType::TRADING_INC_EFF_AND_CAP),
+    desc::BasicInc("trade_ord_spd&limit[020]",
+        0.15, 2, data::building::RoomType::TRADING, RoomBuffType::TRADING_INC_EFF_AND_CAP),
+    desc::BasicInc("trade_ord_spd&limit[021]",
+        0.15, 4, data::building::RoomType::TRADING, RoomBuffType::TRADING_INC_EFF_AND_CAP),
+    desc::BasicInc("trade_ord_spd&limit[022]",
+        0.20, 4, data::building::RoomType::TRADING, RoomBuffType::TRADING_INC_EFF_AND_CAP),
+    desc::BasicInc("trade_ord_spd&limit[030]",
+        0.20, 0, data::building::RoomType::TRADING, RoomBuffType::TRADING_INC_EFF_AND_CAP),
+    desc::BasicInc("trade_ord_spd&limit[031]",
+        0.30, 1, data::building::RoomType::TRADING, RoomBuffType::TRADING_INC_EFF_AND_CAP),
+    desc::BasicInc("trade_ord_spd&limit[032]",
+        0.20, 0, data::building::RoomType::TRADING, RoomBuffType::TRADING_INC_EFF_AND_CAP),
+    desc::BasicInc("trade_ord_spd&limit[033]",
+        0.30, 1, data::building::RoomType::TRADING, RoomBuffType::TRADING_INC_EFF_AND_CAP),
+    desc::BasicInc("trade_ord_spd[000]", 0.2, 0, data::building::RoomType::TRADING, RoomBuffType::TRADING_INC_EFF),
+    desc::BasicInc("trade_ord_spd[001]", 0.3, 0, data::building::RoomType::TRADING, RoomBuffType::TRADING_INC_EFF),
+    desc::BasicInc("trade_ord_spd[010]", 0.2, 0, data::building::RoomType::TRADING, RoomBuffType::TRADING_INC_EFF),
+    desc::BasicInc("trade_ord_spd[011]", 0.3, 0, data::building::RoomType::TRADING, RoomBuffType::TRADING_INC_EFF),
+    desc::BasicInc("trade_ord_spd[020]", 0.35, 0, data::building::RoomType::TRADING, RoomBuffType::TRADING_INC_EFF),
+    desc::IncEffByOtherEffInc("trade_ord_spd_variable2[000]",
+        0.05, 0.05, 0.25, data::building::RoomType::TRADING, RoomBuffType::TRADING_HEAVENLY_REWARD),
+    desc::IncEffByOtherEffInc("trade_ord_spd_variable2[001]",
+        0.05, 0.05, 0.35, data::building::RoomType::TRADING, RoomBuffType::TRADING_HEAVENLY_REWARD),
+    // 低语: 进驻贸易站时，当前贸易站内其他干员提供的订单获取效率全部归零，且每人为自身+45%订单获取效率，同时全体心情每小时消耗+0.25
+    desc::VodfoxTradeBuff("trade_ord_vodfox[000]"),
+};
+// 尚未实现:
+// "manu_prod_spd_bd_n1[000]": 超感: 进驻制造站时，宿舍内每有1名干员则感知信息+1，同时每1点感知信息转化为1点思维链环
+// "trade_ord_line_gold[000]": 订单流可视化·α: 进驻贸易站时，订单获取效率+5%，每有4条赤金生产线，则赤金生产线额外+2
+// "trade_ord_line_gold[010]": 订单流可视化·β: 进驻贸易站时，订单获取效率+5%，每有2条赤金生产线，则赤金生产线额外+2
+// "trade_ord_long[000]": 投资·α: 进驻贸易站后，如果下笔赤金订单交付数大于3，则其龙门币收益+250，心情每小时消耗-0.25
+// "trade_ord_long[010]": 投资·β: 进驻贸易站后，如果下笔赤金订单交付数大于3，则其龙门币收益+500，心情每小时消耗-0.25
+// "trade_ord_spd_bd_n2[000]": “愿者上钩”: 进驻贸易站时，宿舍内每有1名干员则人间烟火+1，同时每有1点人间烟火，则订单获取效率+1%
+// "trade_ord_wt&cost[000]": 裁缝·α: 进驻贸易站时，小幅提升当前贸易站高品质贵金属订单的出现概率（工作时长影响概率），心情每小时消耗-0.25
+// "trade_ord_wt&cost[001]": 手工艺品·α: 进驻贸易站时，小幅提升当前贸易站高品质贵金属订单的出现概率（工作时长影响概率），心情每小时消耗-0.25
+// "trade_ord_wt&cost[010]": 裁缝·β: 进驻贸易站时，提升当前贸易站高品质贵金属订单的出现概率（工作时长影响概率），心情每小时消耗-0.25
+// "trade_ord_wt&cost[011]": 手工艺品·β: 进驻贸易站时，提升当前贸易站高品质贵金属订单的出现概率（工作时长影响概率），心情每小时消耗-0.25
+//  加高品质贵金属订单概率等效效率加成的计算过程：https://www.bilibili.com/video/BV1bo4y1y7ui
+
+inline constexpr size_t kBuffDescriptorCount = std::size(kBuffDescriptors);
+
+/**
+ * @brief 编译期构造的 buff_id 完美哈希 (hash and displace):
+ * 键先按种子0散列到桶, 每个桶再选取一个种子, 使桶内所有键散列到互不冲突的空槽位
+ */
+struct BuffPerfectHash
+{
+    static constexpr size_t kBucketCount = 64;
+    static constexpr size_t kSlotCount = 128; // 2的幂
+    static constexpr size_t kMaxBucketSize = 8;
+    static constexpr UInt8 kEmptySlot = 0xFF;
+
+    Array<UInt16, kBucketCount> seeds{};
+    Array<UInt8, kSlotCount> slots{};
+
+    static constexpr UInt32 hash(std::string_view key, UInt32 seed)
+    {
+        // FNV-1a + murmur3 finalizer
+        UInt32 h = 2166136261U ^ (seed * 0x9E3779B9U);
+        for (const char c : key)
+        {
+            h ^= static_cast<unsigned char>(c);
+            h *= 16777619U;
+        }
+        h ^= h >> 16;
+        h *= 0x85EBCA6BU;
+        h ^= h >> 13;
+        return h;
+    }
+
+    static constexpr size_t bucket_of(std::string_view key)
+    {
+        return hash(key, 0) % kBucketCount;
+    }
+
+    static constexpr size_t slot_of(std::string_view key, UInt32 seed)
+    {
+        return hash(key, seed) & (kSlotCount - 1);
+    }
+
+    [[nodiscard]] constexpr int find(std::string_view key) const
+    {
+        const auto slot = slots[slot_of(key, seeds[bucket_of(key)])];
+        return slot != kEmptySlot && kBuffDescriptors[slot].buff_id == key ? slot : -1;
+    }
+};
+
+namespace detail
+{
+constexpr bool buff_descriptors_sorted()
+{
+    for (size_t i = 1; i < kBuffDescriptorCount; ++i)
+    {
+        if (!(kBuffDescriptors[i - 1].buff_id < kBuffDescriptors[i].buff_id))
+            return false;
+    }
+    return true;
+}
+
+constexpr BuffPerfectHash build_buff_perfect_hash()
+{
+    BuffPerfectHash ph{};
+    for (auto &slot : ph.slots)
+        slot = BuffPerfectHash::kEmptySlot;
+
+    Array<size_t, kBuffDescriptorCount> bucket_of_key{};
+    Array<size_t, BuffPerfectHash::kBucketCount> bucket_size{};
+    size_t max_bucket_size = 0;
+    for (size_t i = 0; i < kBuffDescriptorCount; ++i)
+    {
+        bucket_of_key[i] = BuffPerfectHash::bucket_of(kBuffDescriptors[i].buff_id);
+        max_bucket_size = std::max(max_bucket_size, ++bucket_size[bucket_of_key[i]]);
+    }
+
+    if (max_bucket_size > BuffPerfectHash::kMaxBucketSize)
+        throw std::logic_error("buff perfect hash: bucket overflow");
+
+    // 先放置大桶, 此时空槽位最多
+    for (size_t size = max_bucket_size; size > 0; --size)
+    {
+        for (size_t bucket = 0; bucket < BuffPerfectHash::kBucketCount; ++bucket)
+        {
+            if (bucket_size[bucket] != size)
+                continue;
+
+            Array<size_t, BuffPerfectHash::kMaxBucketSize> keys{};
+            size_t n_keys = 0;
+            for (size_t i = 0; i < kBuffDescriptorCount; ++i)
+            {
+                if (bucket_of_key[i] == bucket)
+                    keys[n_keys++] = i;
+            }
+
+            for (UInt32 seed = 1;; ++seed)
+            {
+                if (seed > 0xFFFF)
+                    throw std::logic_error("buff perfect hash: no seed found");
+
+                Array<size_t, BuffPerfectHash::kMaxBucketSize> pos{};
+                bool ok = true;
+                for (size_t k = 0; k < n_keys && ok; ++k)
+                {
+                    pos[k] = BuffPerfectHash::slot_of(kBuffDescriptors[keys[k]].buff_id, seed);
+                    ok = ph.slots[pos[k]] == BuffPerfectHash::kEmptySlot;
+                    for (size_t j = 0; j < k && ok; ++j)
+                        ok = pos[j] != pos[k];
+                }
+
+                if (!ok)
+                    continue;
+
+                for (size_t k = 0; k < n_keys; ++k)
+                    ph.slots[pos[k]] = static_cast<UInt8>(keys[k]);
+                ph.seeds[bucket] = static_cast<UInt16>(seed);
+                break;
+            }
+        }
+    }
+    return ph;
+}
+} // namespace detail
+
+static_assert(detail::buff_descriptors_sorted(), "kBuffDescriptors must be sorted by buff_id without duplicates");
+static_assert(kBuffDescriptorCount < BuffPerfectHash::kSlotCount, "too many buffs for BuffPerfectHash");
+
+inline constexpr BuffPerfectHash kBuffPerfectHash = detail::build_buff_perfect_hash();
+
+// 查找Buff描述符的下标, 不存在时返回-1. 参数为常量时可在编译期求值
+constexpr int FindBuffDescriptorIndex(std::string_view buff_id)
+{
+    return kBuffPerfectHash.find(buff_id);
+}
+
+constexpr const BuffDescriptor *FindBuffDescriptor(std::string_view buff_id)
+{
+    const int index = FindBuffDescriptorIndex(buff_id);
+    return index >= 0 ? &kBuffDescriptors[index] : nullptr;
+}
+
+namespace detail
+{
+constexpr bool all_buff_descriptors_reachable()
+{
+    for (size_t i = 0; i < kBuffDescriptorCount; ++i)
+    {
+        if (FindBuffDescriptorIndex(kBuffDescriptors[i].buff_id) != static_cast<int>(i))
+            return false;
+    }
+    return true;
+}
+
+constexpr bool buff_patch_targets_exist()
+{
+    for (const auto &descriptor : kBuffDescriptors)
+    {
+        if (!descriptor.patch_target.empty() && FindBuffDescriptorIndex(descriptor.patch_target) < 0)
+            return false;
+    }
+    return true;
+}
+} // namespace detail
+
+static_assert(detail::all_buff_descriptors_reachable(), "kBuffPerfectHash is not a perfect hash of kBuffDescriptors");
+static_assert(detail::buff_patch_targets_exist(), "patch_target must be a known buff");
+} // namespace albc::model::buff
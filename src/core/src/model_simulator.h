@@ -127,7 +127,7 @@ class Simulator
 
             case RoomFinalAttributeModifierType::OVERRIDE_AND_CANCEL_ALL: // override
                 if (override == nullptr || !RoomFinalAttributeModifier::validate(*override) ||
-                    override->owner->sort_id < final_mod.owner->sort_id)
+                    override->owner->meta->sort_id < final_mod.owner->meta->sort_id)
                 {
                     override = &final_mod;
                 }
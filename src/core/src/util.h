@@ -148,16 +148,20 @@ namespace albc::util
 
     // get ops_for_partial_comb time_t in MM-DD HH:MM:SS
     // uses chrono
-    [[maybe_unused]] static std::string GetReadableTime()
+    [[maybe_unused]] static std::string GetReadableTime(std::chrono::system_clock::time_point time)
     {
-        auto now = std::chrono::system_clock::now();
-        auto in_time_t = std::chrono::system_clock::to_time_t(now);
+        auto in_time_t = std::chrono::system_clock::to_time_t(time);
         auto tm = *std::localtime(&in_time_t);
         char buffer[64];
         std::strftime(buffer, sizeof(buffer), "%m-%d.%H:%M:%S", &tm);
         return std::string{buffer};
     }
 
+    [[maybe_unused]] static std::string GetReadableTime()
+    {
+        return GetReadableTime(std::chrono::system_clock::now());
+    }
+
     [[maybe_unused]] static int append_snprintf(char *&buffer, std::size_t &buffer_size, const char *fmt, ...)
     {
         va_list args;
@@ -181,8 +185,9 @@ namespace albc::util
         return std::string{buf};
     }
 
+    // 作用域结束时执行 func，需绑定到局部变量，否则临时对象会立即析构
     template <typename TFunc>
-    struct defer
+    struct [[nodiscard]] defer
     {
         explicit defer(TFunc &&func) : func(std::forward<TFunc>(func)) {}
         defer(const defer &) = delete;
@@ -193,7 +198,7 @@ namespace albc::util
     };
 
     template <typename TFunc>
-    defer<TFunc> make_defer(TFunc &&func)
+    [[nodiscard]] defer<TFunc> make_defer(TFunc &&func)
     {
         return defer<TFunc>(std::forward<TFunc>(func));
     }
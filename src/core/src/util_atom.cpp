@@ -0,0 +1,105 @@
+#include "util_atom.h"
+
+#include <array>
+#include <atomic>
+#include <deque>
+#include <mutex>
+#include <shared_mutex>
+#include <stdexcept>
+#include <string>
+#include <unordered_map>
+
+namespace albc::util
+{
+namespace
+{
+// 编号到字符串的映射按块分配，块一经分配不再移动，读取编号对应的字符串无需加锁。
+// 持有某个原子的线程必然经由驻留（加锁）或其他同步手段获得它，因此对应表项已对其可见。
+class AtomTable
+{
+  public:
+    static AtomTable &Instance()
+    {
+        static AtomTable table;
+        return table;
+    }
+
+    UInt32 Intern(std::string_view str)
+    {
+        {
+            std::shared_lock lock(mutex_);
+            if (const auto it = index_.find(str); it != index_.end())
+                return it->second;
+        }
+
+        std::unique_lock lock(mutex_);
+        if (const auto it = index_.find(str); it != index_.end())
+            return it->second;
+
+        const auto id = size_;
+        if (id >= kChunkCount * kChunkSize)
+            throw std::length_error("Atom table is full");
+
+        auto *chunk = chunks_[id >> kChunkBits].load(std::memory_order_relaxed);
+        if (!chunk)
+        {
+            chunk = owned_chunks_.emplace_back(new std::string_view[kChunkSize]).get();
+            chunks_[id >> kChunkBits].store(chunk, std::memory_order_release);
+        }
+
+        const std::string_view stored = storage_.emplace_back(str);
+        chunk[id & kChunkMask] = stored;
+        index_.emplace(stored, id);
+        ++size_;
+        return id;
+    }
+
+    UInt32 Find(std::string_view str) const
+    {
+        std::shared_lock lock(mutex_);
+        const auto it = index_.find(str);
+        return it != index_.end() ? it->second : 0;
+    }
+
+    std::string_view Get(UInt32 id) const noexcept
+    {
+        return chunks_[id >> kChunkBits].load(std::memory_order_acquire)[id & kChunkMask];
+    }
+
+  private:
+    static constexpr UInt32 kChunkBits = 12;
+    static constexpr UInt32 kChunkSize = 1u << kChunkBits;
+    static constexpr UInt32 kChunkMask = kChunkSize - 1;
+    static constexpr UInt32 kChunkCount = 1024;
+
+    mutable std::shared_mutex mutex_;
+    std::unordered_map<std::string_view, UInt32> index_;
+    std::deque<std::string> storage_; // deque 追加元素时不移动已有元素，视图保持有效
+    Vector<std::unique_ptr<std::string_view[]>> owned_chunks_;
+    std::array<std::atomic<std::string_view *>, kChunkCount> chunks_{};
+    UInt32 size_ = 0;
+
+    AtomTable()
+    {
+        Intern({}); // 编号0保留给空串
+    }
+};
+} // namespace
+
+Atom Atom::Intern(std::string_view str)
+{
+    return str.empty() ? Atom() : Atom(AtomTable::Instance().Intern(str));
+}
+Atom Atom::Find(std::string_view str)
+{
+    return str.empty() ? Atom() : Atom(AtomTable::Instance().Find(str));
+}
+std::string_view Atom::str() const noexcept
+{
+    return AtomTable::Instance().Get(id_);
+}
+std::ostream &operator<<(std::ostream &os, Atom atom)
+{
+    return os << atom.str();
+}
+} // namespace albc::util
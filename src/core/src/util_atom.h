@@ -0,0 +1,80 @@
+#pragma once
+#include "albc_types.h"
+
+#include <functional>
+#include <ostream>
+#include <string_view>
+
+namespace albc::util
+{
+// 字符串原子：全局驻留字符串表中的 32 位编号。
+// 干员Id、Buff Id、异格组等标识在游戏数据载入时驻留，模型层只比较与哈希编号，字符串仅用于输入输出。
+// 驻留表只增不减且容量有限，编号在进程生命周期内有效；空原子（编号0）对应空串。
+// 只在载入游戏数据时驻留，每次求解的输入（玩家数据、自定义干员等）只用 Find 查找，避免长驻进程中驻留表不断增长。
+class Atom
+{
+  public:
+    constexpr Atom() noexcept = default;
+
+    // 驻留字符串，已驻留时返回原有编号
+    static Atom Intern(std::string_view str);
+
+    // 只查找不驻留，未驻留时返回空原子
+    [[nodiscard]] static Atom Find(std::string_view str);
+
+    // 返回的视图在进程生命周期内有效
+    [[nodiscard]] std::string_view str() const noexcept;
+
+    [[nodiscard]] constexpr UInt32 id() const noexcept
+    {
+        return id_;
+    }
+
+    [[nodiscard]] constexpr bool empty() const noexcept
+    {
+        return id_ == 0;
+    }
+
+    friend constexpr bool operator==(Atom lhs, Atom rhs) noexcept
+    {
+        return lhs.id_ == rhs.id_;
+    }
+
+    friend constexpr bool operator!=(Atom lhs, Atom rhs) noexcept
+    {
+        return lhs.id_ != rhs.id_;
+    }
+
+    // 按编号排序，顺序取决于驻留先后而非字符串内容
+    friend constexpr bool operator<(Atom lhs, Atom rhs) noexcept
+    {
+        return lhs.id_ < rhs.id_;
+    }
+
+    // 按字符串字典序排序，用于遍历顺序会影响输出的场合
+    struct LexicalLess
+    {
+        bool operator()(Atom lhs, Atom rhs) const noexcept
+        {
+            return lhs.str() < rhs.str();
+        }
+    };
+
+  private:
+    UInt32 id_ = 0;
+
+    explicit constexpr Atom(UInt32 id) noexcept : id_(id)
+    {
+    }
+};
+
+std::ostream &operator<<(std::ostream &os, Atom atom);
+} // namespace albc::util
+
+template <> struct std::hash<albc::util::Atom>
+{
+    size_t operator()(albc::util::Atom atom) const noexcept
+    {
+        return atom.id();
+    }
+};
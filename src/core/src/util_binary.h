@@ -0,0 +1,135 @@
+#pragma once
+#include "albc_types.h"
+#include "util.h"
+
+#include <cstring>
+#include <stdexcept>
+#include <string_view>
+#include <type_traits>
+
+namespace albc::util
+{
+// FNV-1a 64位哈希，用于校验和及标识数据版本，不用于安全目的
+inline UInt64 Fnv1a64(std::string_view data)
+{
+    UInt64 hash = 14695981039346656037ull;
+    for (const unsigned char c : data)
+    {
+        hash ^= c;
+        hash *= 1099511628211ull;
+    }
+    return hash;
+}
+
+// 定长字段按本机字节序写入，字符串为 UInt32 长度 + 原始字节。
+// 读写双方需为同一字节序，由使用方在文件头中校验。
+class BinaryWriter
+{
+  public:
+    template <typename T, ALBC_REQUIRES(std::is_arithmetic_v<T> || std::is_enum_v<T>)> void Write(T value)
+    {
+        const auto old_size = buf_.size();
+        buf_.resize(old_size + sizeof(T));
+        std::memcpy(buf_.data() + old_size, &value, sizeof(T));
+    }
+
+    void WriteString(std::string_view str)
+    {
+        if (str.size() > UINT32_MAX)
+            throw std::length_error("BinaryWriter: string too long");
+
+        Write(static_cast<UInt32>(str.size()));
+        buf_.append(str.data(), str.size());
+    }
+
+    void WriteBytes(const void *data, size_t size)
+    {
+        buf_.append(static_cast<const char *>(data), size);
+    }
+
+    template <typename TCount> void WriteCount(TCount count)
+    {
+        if (count > UINT32_MAX)
+            throw std::length_error("BinaryWriter: too many elements");
+
+        Write(static_cast<UInt32>(count));
+    }
+
+    [[nodiscard]] const std::string &Buffer() const noexcept
+    {
+        return buf_;
+    }
+
+    [[nodiscard]] std::string &Buffer() noexcept
+    {
+        return buf_;
+    }
+
+  private:
+    std::string buf_;
+};
+
+// 带边界检查的只读游标，不复制底层数据
+class BinaryReader
+{
+  public:
+    explicit BinaryReader(std::string_view data) : pos_(data.data()), end_(data.data() + data.size())
+    {
+    }
+
+    template <typename T, ALBC_REQUIRES(std::is_arithmetic_v<T> || std::is_enum_v<T>)> T Read()
+    {
+        Require(sizeof(T));
+        T value;
+        std::memcpy(&value, pos_, sizeof(T));
+        pos_ += sizeof(T);
+        return value;
+    }
+
+    std::string_view ReadStringView()
+    {
+        const auto len = Read<UInt32>();
+        Require(len);
+        std::string_view str(pos_, len);
+        pos_ += len;
+        return str;
+    }
+
+    std::string ReadString()
+    {
+        return std::string(ReadStringView());
+    }
+
+    // 元素数量，按每个元素至少 min_elem_size 字节校验，防止损坏的数据触发超大分配
+    UInt32 ReadCount(size_t min_elem_size = 1)
+    {
+        const auto count = Read<UInt32>();
+        if (static_cast<UInt64>(count) * min_elem_size > Remaining())
+            throw std::runtime_error("BinaryReader: element count exceeds remaining data");
+        return count;
+    }
+
+    std::string_view ReadBytes(size_t size)
+    {
+        Require(size);
+        std::string_view bytes(pos_, size);
+        pos_ += size;
+        return bytes;
+    }
+
+    [[nodiscard]] size_t Remaining() const noexcept
+    {
+        return static_cast<size_t>(end_ - pos_);
+    }
+
+  private:
+    const char *pos_;
+    const char *end_;
+
+    void Require(size_t size) const
+    {
+        if (size > Remaining())
+            throw std::runtime_error("BinaryReader: unexpected end of data");
+    }
+};
+} // namespace albc::util
@@ -0,0 +1,45 @@
+#include "util_cancel.h"
+
+namespace albc::util
+{
+CancelToken::CancelToken(double deadline_sec)
+{
+    SetDeadline(deadline_sec);
+}
+void CancelToken::Cancel() noexcept
+{
+    cancelled_.store(true, std::memory_order_relaxed);
+}
+void CancelToken::SetDeadline(double deadline_sec) noexcept
+{
+    if (deadline_sec <= 0 || !std::isfinite(deadline_sec))
+    {
+        deadline_ = PerfClock::time_point::max();
+        return;
+    }
+
+    deadline_ = PerfClock::now() + std::chrono::duration_cast<PerfClock::duration>(FloatingSeconds(deadline_sec));
+}
+double CancelToken::GetRemainingSeconds() const noexcept
+{
+    if (!HasDeadline())
+        return INFINITY;
+
+    return std::max(FloatingSeconds(deadline_ - PerfClock::now()).count(), 0.);
+}
+CancelReason CancelToken::Check() const noexcept
+{
+    if (IsCancelled())
+        return CancelReason::CANCELLED;
+
+    if (HasDeadline() && PerfClock::now() >= deadline_)
+        return CancelReason::DEADLINE_EXCEEDED;
+
+    return CancelReason::NONE;
+}
+void CancelToken::ThrowIfStopped() const
+{
+    if (const auto reason = Check(); reason != CancelReason::NONE)
+        throw OperationCancelledException(reason);
+}
+} // namespace albc::util
@@ -0,0 +1,62 @@
+#pragma once
+#include "albc_types.h"
+#include "util_exception.h"
+#include "util_time.h"
+
+#include <atomic>
+#include <cmath>
+
+namespace albc::util
+{
+// 取消令牌：由调用方持有并取消，由算法在枚举及求解过程中轮询。
+// 截止时间为挂钟时间，覆盖整个求解流程（数据准备、组合枚举、Cbc求解）。
+class CancelToken
+{
+  public:
+    CancelToken() = default;
+
+    // deadline_sec <= 0 表示无截止时间
+    explicit CancelToken(double deadline_sec);
+
+    CancelToken(const CancelToken &) = delete;
+    CancelToken &operator=(const CancelToken &) = delete;
+
+    void Cancel() noexcept;
+
+    void SetDeadline(double deadline_sec) noexcept;
+
+    [[nodiscard]] bool IsCancelled() const noexcept
+    {
+        return cancelled_.load(std::memory_order_relaxed);
+    }
+
+    [[nodiscard]] bool HasDeadline() const noexcept
+    {
+        return deadline_ != PerfClock::time_point::max();
+    }
+
+    // 剩余秒数，无截止时间时返回INFINITY
+    [[nodiscard]] double GetRemainingSeconds() const noexcept;
+
+    [[nodiscard]] CancelReason Check() const noexcept;
+
+    [[nodiscard]] bool ShouldStop() const noexcept
+    {
+        return Check() != CancelReason::NONE;
+    }
+
+    // 已取消或超时则抛出 OperationCancelledException
+    void ThrowIfStopped() const;
+
+  private:
+    std::atomic<bool> cancelled_{false};
+    PerfClock::time_point deadline_ = PerfClock::time_point::max();
+};
+
+// 允许空令牌的便捷检查
+[[maybe_unused]] static void throw_if_stopped(const CancelToken *token)
+{
+    if (token)
+        token->ThrowIfStopped();
+}
+} // namespace albc::util
@@ -1,6 +1,34 @@
 #pragma once
 #include "albc_types.h"
 
+#include <stdexcept>
+
 namespace albc::util
 {
-} // namespace albc::exception_util
\ No newline at end of file
+enum class CancelReason
+{
+    NONE,
+    CANCELLED,         // 调用方主动取消
+    DEADLINE_EXCEEDED, // 超过整体截止时间
+};
+
+// 求解流程被取消或超时时抛出
+class OperationCancelledException : public std::runtime_error
+{
+  public:
+    explicit OperationCancelledException(CancelReason reason)
+        : std::runtime_error(reason == CancelReason::DEADLINE_EXCEEDED ? "operation deadline exceeded"
+                                                                       : "operation cancelled"),
+          reason_(reason)
+    {
+    }
+
+    [[nodiscard]] CancelReason GetReason() const noexcept
+    {
+        return reason_;
+    }
+
+  private:
+    CancelReason reason_;
+};
+} // namespace albc::exception_util
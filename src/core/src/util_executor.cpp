@@ -0,0 +1,84 @@
+#include "util_executor.h"
+
+#include <algorithm>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <system_error>
+#include <thread>
+
+namespace albc::util
+{
+struct TaskExecutor::Impl
+{
+    size_t concurrency;
+    std::mutex mutex;
+    std::condition_variable cv;
+    std::deque<std::function<void()>> queue;
+
+    explicit Impl(size_t concurrency_val) : concurrency(concurrency_val)
+    {
+    }
+
+    void Run()
+    {
+        for (;;)
+        {
+            std::function<void()> task;
+            {
+                std::unique_lock lock(mutex);
+                cv.wait(lock, [this] { return !queue.empty(); });
+                task = std::move(queue.front());
+                queue.pop_front();
+            }
+
+            try
+            {
+                task();
+            }
+            catch (...)
+            {
+            }
+        }
+    }
+};
+
+TaskExecutor &TaskExecutor::Shared()
+{
+    // 不析构：线程分离运行，进程退出时由系统回收
+    static TaskExecutor *executor =
+        new TaskExecutor(std::max<size_t>(1, std::thread::hardware_concurrency()));
+    return *executor;
+}
+TaskExecutor::TaskExecutor(size_t concurrency) : impl_(std::make_unique<Impl>(concurrency))
+{
+    for (size_t i = 0; i < concurrency; ++i)
+    {
+        try
+        {
+            std::thread(&Impl::Run, impl_.get()).detach();
+        }
+        catch (const std::system_error &)
+        {
+            // 已启动的线程引用着 impl_，只能以较少的线程继续
+            if (i == 0)
+                throw;
+
+            impl_->concurrency = i;
+            break;
+        }
+    }
+}
+size_t TaskExecutor::GetConcurrency() const noexcept
+{
+    return impl_->concurrency;
+}
+void TaskExecutor::Submit(std::function<void()> task)
+{
+    {
+        std::lock_guard lock(impl_->mutex);
+        impl_->queue.push_back(std::move(task));
+    }
+    impl_->cv.notify_one();
+}
+} // namespace albc::util
@@ -0,0 +1,30 @@
+#pragma once
+#include "albc_types.h"
+
+#include <functional>
+#include <memory>
+
+namespace albc::util
+{
+// 进程内共享的固定大小线程池，供异步 API 使用。线程数为硬件并发数，首次使用时创建；
+// 任务按提交顺序执行，线程全忙时在队列中等待。线程池不析构，进程退出时仍在排队的任务不再执行
+class TaskExecutor
+{
+  public:
+    static TaskExecutor &Shared();
+
+    TaskExecutor(const TaskExecutor &) = delete;
+    TaskExecutor &operator=(const TaskExecutor &) = delete;
+
+    [[nodiscard]] size_t GetConcurrency() const noexcept;
+
+    // task 不应抛出异常，抛出的异常被忽略
+    void Submit(std::function<void()> task);
+
+  private:
+    explicit TaskExecutor(size_t concurrency);
+
+    struct Impl;
+    std::unique_ptr<Impl> impl_;
+};
+} // namespace albc::util
@@ -2,6 +2,7 @@
 #include "util_exception.h"
 #include "util_log.h"
 #include "util_mem.h"
+#include "util_mmap.h"
 #include "json/json.h"
 #include "external/byte_array_buffer.h"
 #include <fstream>
@@ -55,11 +56,11 @@ template <typename TEnum> constexpr TEnum json_string_as_enum(const Json::Value
     return parse_enum_string(val.asString(), default_val);
 }
 
-template <typename TValue>
-static Dictionary<std::string, TValue>
+template <typename TValue, typename TMap = Dictionary<std::string, TValue>>
+static TMap
 json_val_as_dictionary(const Json::Value &val, TValue (*val_factory)(const Json::Value &json), bool throw_on_error = true)
 {
-    Dictionary<std::string, TValue> dict;
+    TMap dict;
 
     const auto &names = val.getMemberNames();
     auto it = names.begin();
@@ -96,6 +97,19 @@ static mem::PtrDictionary<std::string, TValue, TPtr> json_val_as_ptr_dictionary(
     return json_val_as_dictionary<TPtr<TValue>>(val, json_make_ptr<TPtr, TValue>, throw_on_error);
 }
 
+// 读入指定的映射类型（HashDictionary、SmallDictionary 等），值为智能指针时构造其指向的对象
+template <typename TMap>
+static TMap json_val_as_map(const Json::Value &val, bool throw_on_error = true)
+{
+    using TValue = typename TMap::mapped_type;
+    if constexpr (std::is_constructible_v<TValue, Json::Value>)
+        return json_val_as_dictionary<TValue, TMap>(val, json_ctor<TValue>, throw_on_error);
+    else
+        return json_val_as_dictionary<TValue, TMap>(
+            val, +[](const Json::Value &json) { return TValue(new typename TValue::element_type(json)); },
+            throw_on_error);
+}
+
 template <typename T>
 [[maybe_unused]] List<T> json_val_as_list(const Json::Value &val, T (*val_factory)(const Json::Value &json), bool throw_on_error = true)
 {
@@ -160,21 +174,12 @@ static mem::PtrVector<T, TPtr> json_val_as_ptr_vector(const Json::Value &val, bo
     return json_val_as_vector(val, json_make_ptr<TPtr, T>, throw_on_error);
 }
 
-[[maybe_unused]] static Json::Value read_json_from_file(const std::string &path)
-{
-    Json::Value result;
-    std::ifstream fs_read(path);
-    fs_read >> result;
-    fs_read.close();
-    return result;
-} // Reads json from a file
-
-[[maybe_unused]] static Json::Value read_json_from_char_array(const char *json_str)
+[[maybe_unused]] static Json::Value read_json_from_char_array(std::string_view json_str)
 {
     Json::Value result;
     Json::CharReaderBuilder builder;
     std::string errs;
-    byte_array_buffer buffer(json_str, strlen(json_str));
+    byte_array_buffer buffer(json_str.data(), json_str.size());
     std::istream is(&buffer);
     if (!Json::parseFromStream(builder, is, &result, &errs))
     {
@@ -183,6 +188,12 @@ static mem::PtrVector<T, TPtr> json_val_as_ptr_vector(const Json::Value &val, bo
     return result;
 } // Reads json from a char array
 
+[[maybe_unused]] static Json::Value read_json_from_file(const std::string &path)
+{
+    const MappedFile file(path);
+    return read_json_from_char_array(file.View());
+} // Reads json from a file, parsing straight from the mapped pages
+
 template <typename T>
 static Json::Value json_val_from_vector(const Vector<T> &vec, Json::Value (*val_factory)(const T& val) = to_json_ctor<T>)
 {
@@ -194,8 +205,8 @@ static Json::Value json_val_from_vector(const Vector<T> &vec, Json::Value (*val_
     return result;
 } // Creates a json array from a Vector
 
-template <typename T>
-static Json::Value json_val_from_dictionary(const Dictionary<std::string, T> &dict, Json::Value (*val_factory)(const T& val) = to_json_ctor<T>)
+template <typename T, typename TDict>
+static Json::Value json_val_from_dictionary(const TDict &dict, Json::Value (*val_factory)(const T& val) = to_json_ctor<T>)
 {
     Json::Value result(Json::objectValue);
     for (const auto& [key, value] : dict)
@@ -0,0 +1,406 @@
+#include "util_json_stream.h"
+
+#include <charconv>
+#include <climits>
+#include <cmath>
+#include <fstream>
+
+namespace albc::util
+{
+JsonStreamReader::JsonStreamReader(std::string_view text)
+    : begin_(text.data()), pos_(text.data()), end_(text.data() + text.size())
+{
+    // 跳过 UTF-8 BOM
+    if (text.size() >= 3 && text.compare(0, 3, "\xEF\xBB\xBF") == 0)
+        pos_ += 3;
+}
+void JsonStreamReader::SkipWhitespace() noexcept
+{
+    while (pos_ < end_ && (*pos_ == ' ' || *pos_ == '\n' || *pos_ == '\r' || *pos_ == '\t'))
+        ++pos_;
+}
+JsonStreamReader::TokenType JsonStreamReader::Peek()
+{
+    SkipWhitespace();
+    if (pos_ >= end_)
+        return TokenType::END;
+
+    switch (*pos_)
+    {
+    case '{':
+        return TokenType::OBJECT;
+    case '[':
+        return TokenType::ARRAY;
+    case '"':
+        return TokenType::STRING;
+    case 't':
+    case 'f':
+        return TokenType::BOOLEAN;
+    case 'n':
+        return TokenType::NUL;
+    default:
+        if (*pos_ == '-' || (*pos_ >= '0' && *pos_ <= '9'))
+            return TokenType::NUMBER;
+        Fail("unexpected character");
+    }
+}
+bool JsonStreamReader::TryConsume(char c)
+{
+    SkipWhitespace();
+    if (pos_ < end_ && *pos_ == c)
+    {
+        ++pos_;
+        return true;
+    }
+    return false;
+}
+void JsonStreamReader::Expect(char c)
+{
+    if (!TryConsume(c))
+    {
+        const char msg[] = {'\'', c, '\'', ' ', 'e', 'x', 'p', 'e', 'c', 't', 'e', 'd', '\0'};
+        Fail(msg);
+    }
+}
+bool JsonStreamReader::TryConsumeLiteral(std::string_view literal)
+{
+    SkipWhitespace();
+    if (static_cast<size_t>(end_ - pos_) >= literal.size() && std::string_view(pos_, literal.size()) == literal)
+    {
+        pos_ += literal.size();
+        return true;
+    }
+    return false;
+}
+bool JsonStreamReader::TryReadNull()
+{
+    return TryConsumeLiteral("null");
+}
+void JsonStreamReader::DecodeEscape(std::string &out)
+{
+    if (pos_ >= end_)
+        Fail("unterminated escape sequence");
+
+    const auto read_hex4 = [this]() -> UInt32 {
+        if (end_ - pos_ < 4)
+            Fail("invalid unicode escape");
+
+        UInt32 code = 0;
+        for (int i = 0; i < 4; ++i, ++pos_)
+        {
+            const char c = *pos_;
+            code <<= 4;
+            if (c >= '0' && c <= '9')
+                code |= static_cast<UInt32>(c - '0');
+            else if (c >= 'a' && c <= 'f')
+                code |= static_cast<UInt32>(c - 'a' + 10);
+            else if (c >= 'A' && c <= 'F')
+                code |= static_cast<UInt32>(c - 'A' + 10);
+            else
+                Fail("invalid unicode escape");
+        }
+        return code;
+    };
+
+    switch (const char c = *pos_++)
+    {
+    case '"':
+    case '\\':
+    case '/':
+        out.push_back(c);
+        return;
+    case 'b':
+        out.push_back('\b');
+        return;
+    case 'f':
+        out.push_back('\f');
+        return;
+    case 'n':
+        out.push_back('\n');
+        return;
+    case 'r':
+        out.push_back('\r');
+        return;
+    case 't':
+        out.push_back('\t');
+        return;
+    case 'u': {
+        UInt32 code = read_hex4();
+        if (code >= 0xD800 && code <= 0xDBFF)
+        {
+            // UTF-16 代理对
+            if (end_ - pos_ < 2 || pos_[0] != '\\' || pos_[1] != 'u')
+                Fail("missing low surrogate");
+            pos_ += 2;
+            const UInt32 low = read_hex4();
+            if (low < 0xDC00 || low > 0xDFFF)
+                Fail("invalid low surrogate");
+            code = 0x10000 + ((code - 0xD800) << 10) + (low - 0xDC00);
+        }
+
+        if (code < 0x80)
+        {
+            out.push_back(static_cast<char>(code));
+        }
+        else if (code < 0x800)
+        {
+            out.push_back(static_cast<char>(0xC0 | (code >> 6)));
+            out.push_back(static_cast<char>(0x80 | (code & 0x3F)));
+        }
+        else if (code < 0x10000)
+        {
+            out.push_back(static_cast<char>(0xE0 | (code >> 12)));
+            out.push_back(static_cast<char>(0x80 | ((code >> 6) & 0x3F)));
+            out.push_back(static_cast<char>(0x80 | (code & 0x3F)));
+        }
+        else
+        {
+            out.push_back(static_cast<char>(0xF0 | (code >> 18)));
+            out.push_back(static_cast<char>(0x80 | ((code >> 12) & 0x3F)));
+            out.push_back(static_cast<char>(0x80 | ((code >> 6) & 0x3F)));
+            out.push_back(static_cast<char>(0x80 | (code & 0x3F)));
+        }
+        return;
+    }
+    default:
+        Fail("invalid escape sequence");
+    }
+}
+std::string_view JsonStreamReader::ReadRawString(std::string &buf, bool &escaped)
+{
+    Expect('"');
+
+    // 快速路径：不含转义字符时直接返回原文的视图
+    const char *start = pos_;
+    while (pos_ < end_ && *pos_ != '"' && *pos_ != '\\')
+        ++pos_;
+
+    if (pos_ >= end_)
+        Fail("unterminated string");
+
+    if (*pos_ == '"')
+    {
+        escaped = false;
+        return {start, static_cast<size_t>(pos_++ - start)};
+    }
+
+    escaped = true;
+    buf.assign(start, pos_);
+    while (true)
+    {
+        if (pos_ >= end_)
+            Fail("unterminated string");
+
+        const char c = *pos_++;
+        if (c == '"')
+            break;
+
+        if (c == '\\')
+            DecodeEscape(buf);
+        else
+            buf.push_back(c);
+    }
+    return buf;
+}
+std::string_view JsonStreamReader::ReadKey()
+{
+    SkipWhitespace();
+    bool escaped;
+    return ReadRawString(scratch_, escaped);
+}
+std::string_view JsonStreamReader::ReadNumberToken()
+{
+    SkipWhitespace();
+    const char *start = pos_;
+    while (pos_ < end_ &&
+           ((*pos_ >= '0' && *pos_ <= '9') || *pos_ == '-' || *pos_ == '+' || *pos_ == '.' || *pos_ == 'e' ||
+            *pos_ == 'E'))
+        ++pos_;
+
+    if (pos_ == start)
+        Fail("number expected");
+
+    return {start, static_cast<size_t>(pos_ - start)};
+}
+std::string JsonStreamReader::ReadString()
+{
+    switch (Peek())
+    {
+    case TokenType::NUL:
+        TryReadNull();
+        return {};
+
+    case TokenType::STRING: {
+        std::string buf;
+        bool escaped;
+        const auto view = ReadRawString(buf, escaped);
+        return escaped ? buf : std::string(view);
+    }
+
+    case TokenType::NUMBER:
+        return std::string(ReadNumberToken());
+
+    case TokenType::BOOLEAN:
+        return ReadBool() ? "true" : "false";
+
+    default:
+        Fail("string expected");
+    }
+}
+bool JsonStreamReader::ReadBool()
+{
+    switch (Peek())
+    {
+    case TokenType::NUL:
+        TryReadNull();
+        return false;
+
+    case TokenType::NUMBER:
+        return ReadDouble() != 0.;
+
+    default:
+        if (TryConsumeLiteral("true"))
+            return true;
+        if (TryConsumeLiteral("false"))
+            return false;
+        Fail("boolean expected");
+    }
+}
+double JsonStreamReader::ReadDouble()
+{
+    switch (Peek())
+    {
+    case TokenType::NUL:
+        TryReadNull();
+        return 0.;
+
+    case TokenType::BOOLEAN:
+        return ReadBool() ? 1. : 0.;
+
+    case TokenType::NUMBER: {
+        const auto token = ReadNumberToken();
+        double value = 0.;
+        const auto [ptr, ec] = std::from_chars(token.data(), token.data() + token.size(), value);
+        if (ec != std::errc() || ptr != token.data() + token.size())
+            Fail("invalid number");
+        return value;
+    }
+
+    default:
+        Fail("number expected");
+    }
+}
+Int64 JsonStreamReader::ReadInt64()
+{
+    switch (Peek())
+    {
+    case TokenType::NUL:
+        TryReadNull();
+        return 0;
+
+    case TokenType::BOOLEAN:
+        return ReadBool() ? 1 : 0;
+
+    case TokenType::NUMBER: {
+        const char *start = pos_;
+        const auto token = ReadNumberToken();
+        if (token.find_first_of(".eE") != std::string_view::npos)
+        {
+            // 与 jsoncpp 一致：浮点数截断为整数
+            pos_ = start;
+            const double value = ReadDouble();
+            if (!(value >= static_cast<double>(INT64_MIN) && value < static_cast<double>(INT64_MAX)))
+                Fail("integer out of range");
+            return static_cast<Int64>(value);
+        }
+
+        Int64 value = 0;
+        const auto [ptr, ec] = std::from_chars(token.data(), token.data() + token.size(), value);
+        if (ec != std::errc() || ptr != token.data() + token.size())
+            Fail("invalid integer");
+        return value;
+    }
+
+    default:
+        Fail("number expected");
+    }
+}
+int JsonStreamReader::ReadInt()
+{
+    const auto value = ReadInt64();
+    if (value < INT_MIN || value > INT_MAX)
+        Fail("integer out of range");
+    return static_cast<int>(value);
+}
+void JsonStreamReader::Skip()
+{
+    switch (Peek())
+    {
+    case TokenType::OBJECT:
+        ReadObject([this](std::string_view) { Skip(); });
+        return;
+
+    case TokenType::ARRAY:
+        ReadArray([this] { Skip(); });
+        return;
+
+    case TokenType::STRING:
+        // 只定位字符串结尾，不解码
+        for (++pos_; pos_ < end_ && *pos_ != '"'; ++pos_)
+        {
+            if (*pos_ == '\\')
+                ++pos_;
+        }
+        if (pos_ >= end_)
+            Fail("unterminated string");
+        ++pos_;
+        return;
+
+    case TokenType::NUMBER:
+        ReadNumberToken();
+        return;
+
+    case TokenType::BOOLEAN:
+        ReadBool();
+        return;
+
+    case TokenType::NUL:
+        TryReadNull();
+        return;
+
+    default:
+        Fail("value expected");
+    }
+}
+void JsonStreamReader::ExpectEnd()
+{
+    if (Peek() != TokenType::END)
+        Fail("trailing characters");
+}
+void JsonStreamReader::Fail(const char *what) const
+{
+    throw std::runtime_error(std::string("Failed to parse json: ")
+                                 .append(what)
+                                 .append(" at offset ")
+                                 .append(std::to_string(GetOffset())));
+}
+std::string read_file_as_string(const std::string &path)
+{
+    std::ifstream fs(path, std::ios::binary);
+    if (!fs)
+        throw std::runtime_error("Unable to open file: " + path);
+
+    fs.seekg(0, std::ios::end);
+    const auto size = fs.tellg();
+    fs.seekg(0, std::ios::beg);
+
+    std::string content;
+    if (size > 0)
+    {
+        content.resize(static_cast<size_t>(size));
+        fs.read(content.data(), static_cast<std::streamsize>(size));
+        content.resize(static_cast<size_t>(fs.gcount()));
+    }
+    return content;
+}
+} // namespace albc::util
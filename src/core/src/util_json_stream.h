@@ -0,0 +1,166 @@
+#pragma once
+#include "albc_types.h"
+#include "util.h"
+#include "util_mem.h"
+
+#include <stdexcept>
+#include <string_view>
+
+namespace albc::util
+{
+// 流式（拉取式）JSON读取器：直接在原始文本上按需读取，解析结果由调用方写入强类型结构，不构建 Json::Value DOM。
+// 取值语义与 jsoncpp 的 asInt()/asString() 等保持一致：null 视为 0 或空串，不关心的成员用 Skip() 跳过。
+class JsonStreamReader
+{
+  public:
+    enum class TokenType
+    {
+        END,
+        NUL,
+        BOOLEAN,
+        NUMBER,
+        STRING,
+        ARRAY,
+        OBJECT,
+    };
+
+    // text 在读取器的整个生命周期内必须保持有效
+    explicit JsonStreamReader(std::string_view text);
+
+    [[nodiscard]] TokenType Peek();
+
+    // 遍历对象成员，对每个成员调用 on_member(std::string_view key)，回调必须恰好消费一个值。
+    // key 仅在读取下一个值之前有效，需要保存时请先复制。
+    template <typename TFunc> void ReadObject(TFunc &&on_member)
+    {
+        if (TryReadNull())
+            return;
+
+        Expect('{');
+        if (TryConsume('}'))
+            return;
+
+        do
+        {
+            const auto key = ReadKey();
+            Expect(':');
+            on_member(key);
+        } while (TryConsume(','));
+        Expect('}');
+    }
+
+    // 遍历数组元素，对每个元素调用 on_item()，回调必须恰好消费一个值
+    template <typename TFunc> void ReadArray(TFunc &&on_item)
+    {
+        if (TryReadNull())
+            return;
+
+        Expect('[');
+        if (TryConsume(']'))
+            return;
+
+        do
+        {
+            on_item();
+        } while (TryConsume(','));
+        Expect(']');
+    }
+
+    std::string ReadString();
+    bool ReadBool();
+    Int64 ReadInt64();
+    int ReadInt();
+    double ReadDouble();
+
+    // 跳过当前值（含嵌套对象与数组）
+    void Skip();
+
+    bool TryReadNull();
+
+    // 确认文本已全部读完（允许尾随空白）
+    void ExpectEnd();
+
+    [[nodiscard]] size_t GetOffset() const noexcept
+    {
+        return static_cast<size_t>(pos_ - begin_);
+    }
+
+  private:
+    const char *begin_;
+    const char *pos_;
+    const char *end_;
+    std::string scratch_; // 含转义字符的键名的解码缓冲
+
+    void SkipWhitespace() noexcept;
+    bool TryConsume(char c);
+    void Expect(char c);
+    bool TryConsumeLiteral(std::string_view literal);
+    std::string_view ReadKey();
+    std::string_view ReadRawString(std::string &buf, bool &escaped);
+    std::string_view ReadNumberToken();
+    void DecodeEscape(std::string &out);
+    [[noreturn]] void Fail(const char *what) const;
+};
+
+template <typename T,
+    ALBC_REQUIRES(std::is_constructible_v<T, JsonStreamReader &>)>
+static Vector<T> json_stream_as_vector(JsonStreamReader &reader)
+{
+    Vector<T> vec;
+    reader.ReadArray([&] { vec.emplace_back(reader); });
+    return vec;
+}
+
+template <typename T, template <class...> typename TPtr = std::unique_ptr,
+    ALBC_REQUIRES(std::is_constructible_v<T, JsonStreamReader &>)>
+static mem::PtrVector<T, TPtr> json_stream_as_ptr_vector(JsonStreamReader &reader)
+{
+    mem::PtrVector<T, TPtr> vec;
+    reader.ReadArray([&] { vec.emplace_back(new T(reader)); });
+    return vec;
+}
+
+template <typename TValue, typename TFactory>
+static Dictionary<std::string, TValue> json_stream_as_dictionary(JsonStreamReader &reader, TFactory &&val_factory)
+{
+    Dictionary<std::string, TValue> dict;
+    reader.ReadObject([&](std::string_view key) {
+        std::string key_str(key); // 读取值之后 key 失效
+        dict.insert_or_assign(std::move(key_str), val_factory(reader));
+    });
+    return dict;
+}
+
+template <typename TValue,
+    ALBC_REQUIRES(std::is_constructible_v<TValue, JsonStreamReader &>)>
+static Dictionary<std::string, TValue> json_stream_as_dictionary(JsonStreamReader &reader)
+{
+    return json_stream_as_dictionary<TValue>(reader, [](JsonStreamReader &r) { return TValue(r); });
+}
+
+template <typename TValue, template <class...> typename TPtr = std::unique_ptr,
+    ALBC_REQUIRES(std::is_constructible_v<TValue, JsonStreamReader &>)>
+static mem::PtrDictionary<std::string, TValue, TPtr> json_stream_as_ptr_dictionary(JsonStreamReader &reader)
+{
+    return json_stream_as_dictionary<TPtr<TValue>>(reader, [](JsonStreamReader &r) { return TPtr<TValue>(new TValue(r)); });
+}
+
+// 读入指定的映射类型（HashDictionary、SmallDictionary 等），值为智能指针时构造其指向的对象
+template <typename TMap>
+static TMap json_stream_as_map(JsonStreamReader &reader)
+{
+    using TValue = typename TMap::mapped_type;
+    TMap dict;
+    reader.ReadObject([&](std::string_view key) {
+        std::string key_str(key); // 读取值之后 key 失效
+        if constexpr (std::is_constructible_v<TValue, JsonStreamReader &>)
+            dict.insert_or_assign(std::move(key_str), TValue(reader));
+        else
+            dict.insert_or_assign(std::move(key_str), TValue(new typename TValue::element_type(reader)));
+    });
+    return dict;
+}
+
+// 读取整个文件到字符串，供流式解析使用
+std::string read_file_as_string(const std::string &path);
+} // namespace albc::util
@@ -3,7 +3,480 @@
 //
 #include "util_log.h"
 
+#include <algorithm>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <memory>
+#include <thread>
+
+#if defined(ALBC_HAVE_THREADS) && defined(ALBC_ENABLE_THREADED_LOGGING)
+#define ALBC_LOG_BACKGROUND_THREAD
+#endif
+
 namespace albc::util
 {
+namespace
+{
+constexpr unsigned long kDefaultLoggerId = 0;
+
+// 记录头，其后紧跟 arg_count 个参数：1字节标记，数值为8字节，字符串为4字节长度加内容。记录总长按8字节对齐
+struct RecordHeader
+{
+    UInt32 size; // 为0表示缓冲尾部的填充，读取方跳到缓冲开头
+    UInt32 arg_count;
+    const LogSite *site; // 为空表示已格式化的完整消息
+    UInt64 seq;
+    std::chrono::system_clock::rep time;
+    LogLevel level;
+};
+
+constexpr size_t AlignRecord(size_t size)
+{
+    return (size + 7) & ~size_t{7};
+}
+
+// 单生产者单消费者字节环形缓冲。生产者为所属线程；消费者为持有 AsyncLogger 取空锁的线程
+class LogRing
+{
+  public:
+    static constexpr size_t kCapacity = 64 * 1024;
+    static constexpr size_t kMaxRecordSize = kCapacity / 2;
+    static_assert(is_pow_of_two(kCapacity));
+
+    LogRing() : buf_(new std::byte[kCapacity]), tid_(get_current_thread_id())
+    {
+    }
+
+    [[nodiscard]] const std::string &GetTid() const noexcept
+    {
+        return tid_;
+    }
+
+    // 预留 size 字节（已对齐），空间不足时返回空指针
+    std::byte *Reserve(size_t size)
+    {
+        const UInt64 w = write_pos_.load(std::memory_order_relaxed);
+        const UInt64 r = read_pos_.load(std::memory_order_acquire);
+        const size_t offset = w & (kCapacity - 1);
+        const size_t pad = kCapacity - offset < size ? kCapacity - offset : 0;
+        if (w + pad + size - r > kCapacity)
+            return nullptr;
+
+        if (pad)
+        {
+            const UInt32 zero = 0;
+            std::memcpy(buf_.get() + offset, &zero, sizeof(zero));
+        }
+
+        reserved_pos_ = w + pad;
+        return buf_.get() + (reserved_pos_ & (kCapacity - 1));
+    }
+
+    // 发布预留的记录，返回发布后缓冲是否已用过半
+    bool Commit(size_t size)
+    {
+        const UInt64 w = reserved_pos_ + size;
+        write_pos_.store(w, std::memory_order_release);
+        return w - read_pos_.load(std::memory_order_relaxed) > kCapacity / 2;
+    }
+
+    template <typename TFunc> void Consume(TFunc &&func)
+    {
+        UInt64 r = read_pos_.load(std::memory_order_relaxed);
+        const UInt64 w = write_pos_.load(std::memory_order_acquire);
+        while (r < w)
+        {
+            const size_t offset = r & (kCapacity - 1);
+            UInt32 size;
+            std::memcpy(&size, buf_.get() + offset, sizeof(size));
+            if (size == 0)
+            {
+                r += kCapacity - offset;
+                continue;
+            }
+
+            func(buf_.get() + offset);
+            r += size;
+        }
+        read_pos_.store(r, std::memory_order_release);
+    }
+
+    [[nodiscard]] bool Empty() const noexcept
+    {
+        return read_pos_.load(std::memory_order_relaxed) == write_pos_.load(std::memory_order_acquire);
+    }
+
+    void Retire() noexcept
+    {
+        retired_.store(true, std::memory_order_release);
+    }
+
+    [[nodiscard]] bool IsRetired() const noexcept
+    {
+        return retired_.load(std::memory_order_acquire);
+    }
+
+  private:
+    alignas(64) std::atomic<UInt64> write_pos_{0};
+    UInt64 reserved_pos_ = 0;
+    alignas(64) std::atomic<UInt64> read_pos_{0};
+    std::unique_ptr<std::byte[]> buf_;
+    const std::string tid_;
+    std::atomic<bool> retired_{false};
+};
+
+// 线程退出时标记其缓冲，后台线程取空后移除
+struct RingHandle
+{
+    std::shared_ptr<LogRing> ring;
+
+    ~RingHandle()
+    {
+        if (ring)
+            ring->Retire();
+    }
+};
+
+size_t GetEncodedSize(const log_detail::EncodedArg *args, size_t arg_count)
+{
+    size_t size = sizeof(RecordHeader);
+    for (size_t i = 0; i < arg_count; ++i)
+        size += 1 + (args[i].tag == log_detail::ArgTag::STRING ? sizeof(UInt32) + args[i].s.size() : sizeof(UInt64));
+    return AlignRecord(size);
+}
 
-}
\ No newline at end of file
+void EncodeArgs(std::byte *out, const log_detail::EncodedArg *args, size_t arg_count)
+{
+    for (size_t i = 0; i < arg_count; ++i)
+    {
+        const auto &arg = args[i];
+        std::memcpy(out++, &arg.tag, 1);
+        switch (arg.tag)
+        {
+        case log_detail::ArgTag::STRING: {
+            const auto len = static_cast<UInt32>(arg.s.size());
+            std::memcpy(out, &len, sizeof(len));
+            std::memcpy(out + sizeof(len), arg.s.data(), len);
+            out += sizeof(len) + len;
+            break;
+        }
+        default:
+            std::memcpy(out, &arg.u, sizeof(UInt64)); // 整体复制联合体，各成员均位于其起始处
+            out += sizeof(UInt64);
+            break;
+        }
+    }
+}
+
+// 按 std::ostream 的默认格式输出参数，与直接 os << arg 的结果一致
+const std::byte *DecodeArg(std::ostream &os, const std::byte *in)
+{
+    log_detail::ArgTag tag;
+    std::memcpy(&tag, in++, 1);
+    if (tag == log_detail::ArgTag::STRING)
+    {
+        UInt32 len;
+        std::memcpy(&len, in, sizeof(len));
+        os.write(reinterpret_cast<const char *>(in + sizeof(len)), len);
+        return in + sizeof(len) + len;
+    }
+
+    const auto print = [&](auto value) {
+        std::memcpy(&value, in, sizeof(value));
+        os << value;
+    };
+    switch (tag)
+    {
+    case log_detail::ArgTag::INT:
+        print(Int64{});
+        break;
+    case log_detail::ArgTag::UINT:
+        print(UInt64{});
+        break;
+    case log_detail::ArgTag::FLOAT:
+        print(double{});
+        break;
+    case log_detail::ArgTag::CHAR:
+        print(char{});
+        break;
+    case log_detail::ArgTag::BOOL:
+        print(bool{});
+        break;
+    default:
+        break;
+    }
+    return in + sizeof(UInt64);
+}
+
+// 本线程的 get_current_thread_id()，线程局部变量可平凡析构，静态对象析构期间仍可使用
+std::string_view GetCachedThreadId()
+{
+    thread_local char tid[16] = {};
+    if (!tid[0])
+        std::snprintf(tid, sizeof(tid), "%s", get_current_thread_id().c_str());
+    return tid;
+}
+
+void PrintMessage(const std::string &str)
+{
+    DefaultLogPrinter::Print(kDefaultLoggerId, ToTargetLocale(str));
+}
+} // namespace
+
+struct AsyncLogger::Impl
+{
+    std::mutex registry_mutex;
+    Vector<std::shared_ptr<LogRing>> rings;
+    std::atomic<UInt64> seq{0};
+
+    // 取空锁：同一时刻只有一个消费者读取各缓冲并输出
+    std::mutex drain_mutex;
+    Vector<std::pair<UInt64, std::string>> batch;
+    std::ostringstream oss;
+    std::chrono::system_clock::rep cached_time_sec = -1;
+    std::string cached_time;
+
+    // 后台线程运行中。未运行时（未启用或进程退出阶段）由写入线程自行取空输出
+    std::atomic<bool> background{false};
+#ifdef ALBC_LOG_BACKGROUND_THREAD
+    std::mutex wake_mutex;
+    std::condition_variable wake_cv;
+    bool wake_requested = false;
+    bool running = true;
+    std::thread thread;
+#endif
+
+    LogRing &GetThreadRing()
+    {
+        thread_local RingHandle handle;
+        if (!handle.ring)
+        {
+            handle.ring = std::make_shared<LogRing>();
+            std::scoped_lock lock(registry_mutex);
+            rings.push_back(handle.ring);
+        }
+        return *handle.ring;
+    }
+
+    void Wake()
+    {
+#ifdef ALBC_LOG_BACKGROUND_THREAD
+        {
+            std::scoped_lock lock(wake_mutex);
+            wake_requested = true;
+        }
+        wake_cv.notify_one();
+#endif
+    }
+
+    const std::string &FormatTime(std::chrono::system_clock::rep time)
+    {
+        const auto tp = std::chrono::system_clock::time_point(std::chrono::system_clock::duration(time));
+        const auto sec = std::chrono::duration_cast<std::chrono::seconds>(tp.time_since_epoch()).count();
+        if (sec != cached_time_sec)
+        {
+            cached_time_sec = sec;
+            cached_time = GetReadableTime(tp);
+        }
+        return cached_time;
+    }
+
+    std::string Format(const std::byte *record, std::string_view tid)
+    {
+        RecordHeader header;
+        std::memcpy(&header, record, sizeof(header));
+        const std::byte *in = record + sizeof(header);
+
+        oss.str(std::string());
+        oss.clear();
+        if (header.site)
+        {
+            oss << "ALBC|" << FormatTime(header.time) << '|' << tid << GetLogLevelTag(header.level);
+            if (header.site->file)
+                oss << header.site->file << ':' << header.site->func << ':' << header.site->line << '|';
+        }
+
+        for (UInt32 i = 0; i < header.arg_count; ++i)
+            in = DecodeArg(oss, in);
+
+        if (header.site)
+            oss << '\n';
+        return oss.str();
+    }
+
+    // 调用方须持有 drain_mutex
+    void DrainLocked()
+    {
+        Vector<std::shared_ptr<LogRing>> snapshot;
+        {
+            std::scoped_lock lock(registry_mutex);
+            snapshot = rings;
+        }
+
+        batch.clear();
+        for (const auto &ring : snapshot)
+        {
+            ring->Consume([&](const std::byte *record) {
+                UInt64 record_seq;
+                std::memcpy(&record_seq, record + offsetof(RecordHeader, seq), sizeof(record_seq));
+                batch.emplace_back(record_seq, Format(record, ring->GetTid()));
+            });
+        }
+
+        // 各线程内有序，线程之间按写入序号合并
+        std::sort(batch.begin(), batch.end(),
+                  [](const auto &lhs, const auto &rhs) { return lhs.first < rhs.first; });
+        for (const auto &[_, str] : batch)
+            PrintMessage(str);
+
+        std::scoped_lock lock(registry_mutex);
+        rings.erase(std::remove_if(rings.begin(), rings.end(),
+                                   [](const auto &ring) { return ring->IsRetired() && ring->Empty(); }),
+                    rings.end());
+    }
+
+    void Drain()
+    {
+        std::scoped_lock lock(drain_mutex);
+        DrainLocked();
+    }
+
+#ifdef ALBC_LOG_BACKGROUND_THREAD
+    void MainLoop()
+    {
+        while (true)
+        {
+            bool stop;
+            {
+                std::unique_lock lock(wake_mutex);
+                wake_cv.wait_for(lock, std::chrono::milliseconds(10), [&] { return wake_requested || !running; });
+                wake_requested = false;
+                stop = !running;
+            }
+
+            Drain();
+            if (stop)
+                break;
+        }
+    }
+#endif
+};
+
+AsyncLogger &AsyncLogger::instance()
+{
+    // 不析构：其他静态对象的析构函数中仍可能输出日志。进程退出时停止后台线程并输出剩余日志
+    static AsyncLogger *logger = [] {
+        auto *created = new AsyncLogger();
+        std::atexit([] { instance().Shutdown(); });
+        return created;
+    }();
+    return *logger;
+}
+AsyncLogger::AsyncLogger() : impl_(std::make_unique<Impl>())
+{
+#ifdef ALBC_LOG_BACKGROUND_THREAD
+    impl_->thread = std::thread(&Impl::MainLoop, impl_.get());
+    impl_->background.store(true, std::memory_order_release);
+#endif
+}
+AsyncLogger::~AsyncLogger() = default;
+void AsyncLogger::Shutdown()
+{
+#ifdef ALBC_LOG_BACKGROUND_THREAD
+    if (impl_->background.exchange(false, std::memory_order_acq_rel))
+    {
+        {
+            std::scoped_lock lock(impl_->wake_mutex);
+            impl_->running = false;
+        }
+        impl_->wake_cv.notify_one();
+        impl_->thread.join();
+    }
+#endif
+    Flush();
+}
+void AsyncLogger::WriteEncoded(LogLevel level, const LogSite *site, const log_detail::EncodedArg *args,
+                               size_t arg_count)
+{
+    const size_t size = GetEncodedSize(args, arg_count);
+    RecordHeader header{static_cast<UInt32>(size), static_cast<UInt32>(arg_count), site,
+                        impl_->seq.fetch_add(1, std::memory_order_relaxed),
+                        std::chrono::system_clock::now().time_since_epoch().count(), level};
+
+    // 无后台线程（默认构建，或进程退出阶段）时在调用线程上直接格式化输出，不经过环形缓冲与注册表
+    if (!impl_->background.load(std::memory_order_acquire))
+    {
+        std::byte stack_record[512];
+        Vector<std::byte> heap_record;
+        std::byte *record = stack_record;
+        if (size > sizeof(stack_record))
+        {
+            heap_record.resize(size);
+            record = heap_record.data();
+        }
+        std::memcpy(record, &header, sizeof(header));
+        EncodeArgs(record + sizeof(header), args, arg_count);
+
+        std::scoped_lock lock(impl_->drain_mutex);
+#ifdef ALBC_LOG_BACKGROUND_THREAD
+        impl_->DrainLocked(); // 后台线程停止前写入缓冲的日志
+#endif
+        PrintMessage(impl_->Format(record, GetCachedThreadId()));
+        return;
+    }
+
+    // 超长消息不经过缓冲，取空已有日志后直接输出以保持顺序
+    if (size > LogRing::kMaxRecordSize)
+    {
+        Vector<std::byte> record(size);
+        std::memcpy(record.data(), &header, sizeof(header));
+        EncodeArgs(record.data() + sizeof(header), args, arg_count);
+
+        std::scoped_lock lock(impl_->drain_mutex);
+        impl_->DrainLocked();
+        PrintMessage(impl_->Format(record.data(), get_current_thread_id()));
+        return;
+    }
+
+    auto &ring = impl_->GetThreadRing();
+    std::byte *out;
+    while (!(out = ring.Reserve(size)))
+    {
+        // 缓冲已满：唤醒后台线程并等待，后台线程未运行时由本线程取空
+        if (impl_->background.load(std::memory_order_acquire))
+        {
+            impl_->Wake();
+            std::this_thread::yield();
+        }
+        else
+        {
+            impl_->Drain();
+        }
+    }
+
+    std::memcpy(out, &header, sizeof(header));
+    EncodeArgs(out + sizeof(header), args, arg_count);
+    const bool half_full = ring.Commit(size);
+
+    if (!impl_->background.load(std::memory_order_acquire))
+        impl_->Drain(); // 写入期间后台线程已停止
+    else if (half_full || level >= LogLevel::ERROR)
+        impl_->Wake();
+}
+void AsyncLogger::Log(LogLevel level, std::string_view str)
+{
+    if (!GlobalLogConfig::CanLog(level))
+        return;
+
+    const auto encoded = log_detail::Encode(str);
+    WriteEncoded(level, nullptr, &encoded, 1);
+}
+void AsyncLogger::Flush()
+{
+    impl_->Drain();
+    DefaultLogPrinter::Flush(kDefaultLoggerId);
+}
+} // namespace albc::util
@@ -2,23 +2,18 @@
 #pragma once
 #include "util.h"
 #include "util_locale.h"
+#include <atomic>
 #include <iomanip>
 #include <iostream>
 #include <mutex>
 #include <sstream>
 #include <functional>
+#include <string_view>
+#include <type_traits>
 
-#if (!defined(ALBC_HAVE_THREADS) || defined(ALBC_CONFIG_ASAN)) && !defined(ALBC_DISABLE_THREADED_LOGGING)
-#define ALBC_DISABLE_THREADED_LOGGING // AddressSanitizer causes segfault on concurrent queue
-#endif
-
-#ifndef ALBC_ENABLE_THREADED_LOGGING
-#define ALBC_DISABLE_THREADED_LOGGING
-#endif
-
-#ifndef ALBC_DISABLE_THREADED_LOGGING
-#include <condition_variable>
-#include "blockingconcurrentqueue.h"
+// 编译期最低日志级别，取 LogLevel 的数值。低于该级别的日志语句连同其参数在编译期被消除
+#ifndef ALBC_LOG_MIN_LEVEL
+#define ALBC_LOG_MIN_LEVEL 0
 #endif
 
 #define ALBC_LOG_DO_S_LOG(id, target, ...)                                                                                  \
@@ -29,12 +24,26 @@
 
 #define S_LOG(target, ...) ALBC_LOG_DO_S_LOG(__COUNTER__, target, __VA_ARGS__)
 
-#define LOG_TRACED(level, ...) S_LOG(albc::util::Logger()(level), __FILENAME__, ":", __func__, ":", STRINGIFY(__LINE__), "|", __VA_ARGS__)
+// 先检查级别，再求值参数。启用后台线程时参数以二进制形式写入当前线程的环形缓冲，由后台线程格式化输出（见 AsyncLogger）
+#define ALBC_LOG_AT_SITE(level, file, func, ...)                                                                            \
+    do                                                                                                                      \
+    {                                                                                                                       \
+        if (const auto albc_log_level_ = (level); albc::util::GlobalLogConfig::CanLog(albc_log_level_))                    \
+        {                                                                                                                   \
+            static const albc::util::LogSite albc_log_site_{(file), (func), STRINGIFY(__LINE__)};                          \
+            albc::util::AsyncLogger::instance().Write(albc_log_level_, albc_log_site_, __VA_ARGS__);                       \
+        }                                                                                                                   \
+    } while (false)
+
+// 不带源码位置的日志
+#define LOG_AT_LEVEL(level, ...) ALBC_LOG_AT_SITE(level, nullptr, nullptr, __VA_ARGS__)
+
+#define LOG_TRACED(level, ...) ALBC_LOG_AT_SITE(level, __FILENAME__, __func__, __VA_ARGS__)
 #define LOG_D(...) LOG_TRACED(albc::util::LogLevel::DEBUG, __VA_ARGS__)
 #define LOG_I(...) LOG_TRACED(albc::util::LogLevel::INFO, __VA_ARGS__)
 #define LOG_W(...) LOG_TRACED(albc::util::LogLevel::WARN, __VA_ARGS__)
 #define LOG_E(...) LOG_TRACED(albc::util::LogLevel::ERROR, __VA_ARGS__)
-#define LOG_TRACED_DETAIL(level, ...) S_LOG(albc::util::Logger()(level), __FILENAME__, ":", __PRETTY_FUNCTION__, ":", STRINGIFY(__LINE__), "|", __VA_ARGS__)
+#define LOG_TRACED_DETAIL(level, ...) ALBC_LOG_AT_SITE(level, __FILENAME__, __PRETTY_FUNCTION__, __VA_ARGS__)
 #define LOG_D_DETAIL(...) LOG_TRACED_DETAIL(albc::util::LogLevel::DEBUG, __VA_ARGS__)
 #define LOG_I_DETAIL(...) LOG_TRACED_DETAIL(albc::util::LogLevel::INFO, __VA_ARGS__)
 #define LOG_W_DETAIL(...) LOG_TRACED_DETAIL(albc::util::LogLevel::WARN, __VA_ARGS__)
@@ -65,6 +74,8 @@ enum class LogLevel
     NONE = 5
 };
 
+inline constexpr LogLevel kMinLogLevel = static_cast<LogLevel>(ALBC_LOG_MIN_LEVEL);
+
 class GlobalLogConfig
 {
 public:
@@ -113,18 +124,18 @@ public:
 
     static LogLevel GetLogLevel()
     {
-        return log_level_;
+        return log_level_.load(std::memory_order_relaxed);
     }
 
     static void SetLogLevel(LogLevel level)
     {
-        std::lock_guard lock(mutex_);
-        log_level_ = level;
+        log_level_.store(level, std::memory_order_relaxed);
     }
 
+    // 级别为常量时，低于编译期最低级别的判断被折叠为 false
     static bool CanLog(LogLevel level)
     {
-        return log_level_ <= level;
+        return level >= kMinLogLevel && log_level_.load(std::memory_order_relaxed) <= level;
     }
 
     static void SetLogCallback(LogCallback callback, void *data)
@@ -150,7 +161,7 @@ public:
     }
 
 private:
-    inline static LogLevel log_level_;
+    inline static std::atomic<LogLevel> log_level_{LogLevel::ALL};
     inline static std::mutex mutex_;
     inline static LogHandler log_handler_;
     inline static FlushLogHandler flush_log_handler_;
@@ -179,92 +190,154 @@ struct DefaultLogPrinter
     }
 };
 
-template <typename TPrinter = DefaultLogPrinter> class ThreadedConsoleLogger
+// get log level as std::string
+constexpr std::string_view GetLogLevelTag(const LogLevel e)
 {
-public:
-    ~ThreadedConsoleLogger()
+    switch (e)
     {
-        Flush();
-#ifndef ALBC_DISABLE_THREADED_LOGGING
-        running_ = false;
-        thread_.join();
-#endif
+    case LogLevel::ALL:
+        return "|ALL  |";
+    case LogLevel::DEBUG:
+        return "|DEBUG|";
+    case LogLevel::INFO:
+        return "|INFO |";
+    case LogLevel::WARN:
+        return "|WARN |";
+    case LogLevel::ERROR:
+        return "|ERROR|";
+    case LogLevel::NONE:
+        return "|NONE |";
     }
+    ALBC_UNREACHABLE();
+}
+
+// 日志语句的调用点信息，每个调用点一个静态实例。file 为空时不输出源码位置
+struct LogSite
+{
+    const char *file;
+    const char *func;
+    const char *line;
+};
+
+namespace log_detail
+{
+enum class ArgTag : UInt8
+{
+    INT,
+    UINT,
+    FLOAT,
+    CHAR,
+    BOOL,
+    STRING,
+};
 
-    void Log(const LogLevel level, std::string &&str)
+// 可按二进制写入缓冲的参数：算术类型与字符串。其余类型（含流操纵符）在调用线程上立即格式化
+struct EncodedArg
+{
+    ArgTag tag;
+    union
     {
-        if (GlobalLogConfig::CanLog(level))
-        {
-#ifndef ALBC_DISABLE_THREADED_LOGGING
-            if (!queue_.enqueue(std::move(str)))
-            {
-                std::cerr << "Failed to enqueue log message!" << std::endl;
-                return;
-            }
-#else
-            // log directly
-            Print(str);
-#endif
-        }
-    }
+        Int64 i;
+        UInt64 u;
+        double f;
+        char c;
+        bool b;
+    };
+    std::string_view s;
+};
 
-    void Log(const LogLevel level, const std::string &str)
+template <typename T, typename D = std::decay_t<T>>
+inline constexpr bool kIsEncodable =
+    std::is_same_v<D, bool> || std::is_same_v<D, char> || std::is_same_v<D, signed char> ||
+    std::is_same_v<D, unsigned char> || std::is_same_v<D, short> || std::is_same_v<D, unsigned short> ||
+    std::is_same_v<D, int> || std::is_same_v<D, unsigned> || std::is_same_v<D, long> ||
+    std::is_same_v<D, unsigned long> || std::is_same_v<D, long long> || std::is_same_v<D, unsigned long long> ||
+    std::is_same_v<D, float> || std::is_same_v<D, double> || std::is_same_v<D, const char *> ||
+    std::is_same_v<D, char *> || std::is_same_v<D, std::string> || std::is_same_v<D, std::string_view>;
+
+template <typename T> EncodedArg Encode(const T &arg)
+{
+    using D = std::decay_t<T>;
+    EncodedArg encoded{};
+    if constexpr (std::is_same_v<D, bool>)
     {
-        Log(level, std::string(str));
+        encoded.tag = ArgTag::BOOL;
+        encoded.b = arg;
     }
-
-    void Flush()
+    else if constexpr (std::is_same_v<D, char> || std::is_same_v<D, signed char> || std::is_same_v<D, unsigned char>)
     {
-#ifndef ALBC_DISABLE_THREADED_LOGGING
-        std::string str;
-        while (queue_.try_dequeue(str))
-        {
-            Print(str);
-        }
-#endif
-        TPrinter::Flush(kDefaultLoggerId);
+        encoded.tag = ArgTag::CHAR;
+        encoded.c = static_cast<char>(arg);
+    }
+    else if constexpr (std::is_integral_v<D> && std::is_signed_v<D>)
+    {
+        encoded.tag = ArgTag::INT;
+        encoded.i = arg;
+    }
+    else if constexpr (std::is_integral_v<D>)
+    {
+        encoded.tag = ArgTag::UINT;
+        encoded.u = arg;
+    }
+    else if constexpr (std::is_floating_point_v<D>)
+    {
+        encoded.tag = ArgTag::FLOAT;
+        encoded.f = arg;
+    }
+    else
+    {
+        encoded.tag = ArgTag::STRING;
+        encoded.s = std::string_view(arg);
     }
+    return encoded;
+}
+} // namespace log_detail
 
-private:
-    static constexpr unsigned long kDefaultLoggerId = 0;
-#ifndef ALBC_DISABLE_THREADED_LOGGING
-    moodycamel::BlockingConcurrentQueue<std::string> queue_{4096};
-    std::thread thread_{&ThreadedConsoleLogger::MainLoop, this};
-#endif
-    bool running_ = true;
+// 异步二进制日志：调用线程只把级别、调用点、时间戳与参数的二进制形式写入本线程的单生产者单消费者环形缓冲，
+// 格式化、编码转换与输出（含 SetLogHandler 设置的回调）都在后台线程上进行，Flush() 在调用线程上立即取空所有缓冲。
+// 线程化日志需在构建时显式启用（ALBC_ENABLE_THREADED_LOGGING，默认关闭）；未启用时在调用线程上直接格式化输出，不使用环形缓冲。
+class AsyncLogger
+{
+  public:
+    static AsyncLogger &instance();
+
+    AsyncLogger(const AsyncLogger &) = delete;
+    AsyncLogger &operator=(const AsyncLogger &) = delete;
 
-#ifndef ALBC_DISABLE_THREADED_LOGGING
-    void MainLoop()
+    template <typename... Args> void Write(LogLevel level, const LogSite &site, const Args &...args)
     {
-        while (true)
+        if constexpr ((log_detail::kIsEncodable<Args> && ...))
         {
-            constexpr size_t bulk_reserve_size = 256;
-            std::string msg_list[bulk_reserve_size];
-            const size_t bulk_size =
-                queue_.wait_dequeue_bulk_timed(msg_list, bulk_reserve_size, std::chrono::milliseconds(10));
-
-            for (size_t i = 0; i < bulk_size; ++i)
-            {
-                const auto &msg = msg_list[i];
-                Print(msg);
-            }
-
-            if (!running_)
-            {
-                TPrinter::Flush(kDefaultLoggerId);
-                break;
-            }
+            const log_detail::EncodedArg encoded[] = {log_detail::Encode(args)...};
+            WriteEncoded(level, &site, encoded, sizeof...(Args));
+        }
+        else
+        {
+            std::ostringstream oss;
+            VariantPut(oss, args...);
+            const auto str = oss.str();
+            const auto encoded = log_detail::Encode(str);
+            WriteEncoded(level, &site, &encoded, 1);
         }
     }
-#endif
 
-    static void Print(const std::string &str)
-    {
-        TPrinter::Print(kDefaultLoggerId, ToTargetLocale(str));
-    }
-};
+    // 输出已格式化的完整消息，不添加前缀
+    void Log(LogLevel level, std::string_view str);
+
+    void Flush();
+
+    // 停止后台线程并输出剩余日志，此后的日志在写入线程上直接输出
+    void Shutdown();
 
-using SingletonLogger = util::LazySingleton<ThreadedConsoleLogger<DefaultLogPrinter>>;
+  private:
+    struct Impl;
+    std::unique_ptr<Impl> impl_;
+
+    AsyncLogger();
+    ~AsyncLogger();
+
+    void WriteEncoded(LogLevel level, const LogSite *site, const log_detail::EncodedArg *args, size_t arg_count);
+};
 
 class Logger
 {
@@ -312,12 +385,12 @@ public:
         */
         if (GlobalLogConfig::CanLog(m_logLevel))
         {
-            SingletonLogger::instance()->Log(m_logLevel, std::move(std::string("ALBC|")
-                                                                   .append(util::GetReadableTime())
-                                                                   .append("|")
-                                                                   .append(util::get_current_thread_id())
-                                                                   .append(GetLogLevelTag(m_logLevel))
-                                                                   .append(m_stream.str())));
+            AsyncLogger::instance().Log(m_logLevel, std::string("ALBC|")
+                                                        .append(util::GetReadableTime())
+                                                        .append("|")
+                                                        .append(util::get_current_thread_id())
+                                                        .append(GetLogLevelTag(m_logLevel))
+                                                        .append(m_stream.str()));
         }
 
         m_stream.str(std::string());
@@ -327,26 +400,5 @@ public:
 private:
     std::stringstream m_stream;
     LogLevel m_logLevel = LogLevel::INFO;
-
-    // get log level as std::string
-    static constexpr std::string_view GetLogLevelTag(const LogLevel e)
-    {
-        switch (e)
-        {
-        case LogLevel::ALL:
-            return "|ALL  |";
-        case LogLevel::DEBUG:
-            return "|DEBUG|";
-        case LogLevel::INFO:
-            return "|INFO |";
-        case LogLevel::WARN:
-            return "|WARN |";
-        case LogLevel::ERROR:
-            return "|ERROR|";
-        case LogLevel::NONE:
-            return "|NONE |";
-        }
-        ALBC_UNREACHABLE();
-    }
 };
 } // namespace albc::diagnostics
@@ -3,7 +3,250 @@
 //
 #include "util_mem.h"
 
+#include <cstdlib>
+
+#ifdef ALBC_MEMORY_ACCOUNTING
+#   if defined(_MSC_VER)
+#       include <malloc.h>
+#       define ALBC_MALLOC_SIZE(ptr) _msize(ptr)
+#   elif defined(__APPLE__)
+#       include <malloc/malloc.h>
+#       define ALBC_MALLOC_SIZE(ptr) malloc_size(ptr)
+#   else
+#       include <malloc.h>
+#       define ALBC_MALLOC_SIZE(ptr) malloc_usable_size(ptr)
+#   endif
+#endif
+
 namespace albc::mem
 {
+namespace
+{
+// 只含平凡类型，可在 operator new 中安全访问
+struct ThreadMemState
+{
+    Int64 live_bytes;
+    MemPhaseScope *scope;
+};
+
+thread_local ThreadMemState t_mem_state{0, nullptr};
+} // namespace
+
+const char *GetMemPhaseName(MemPhase phase) noexcept
+{
+    switch (phase)
+    {
+    case MemPhase::DATA_FEED:
+        return "data_feed";
+    case MemPhase::OPERATOR_BUILD:
+        return "operator_build";
+    case MemPhase::ENUMERATION:
+        return "enumeration";
+    case MemPhase::MATRIX:
+        return "matrix";
+    case MemPhase::SOLVER:
+        return "solver";
+    case MemPhase::RESULT:
+        return "result";
+    }
+    return "unknown";
+}
+bool IsHeapAccountingEnabled() noexcept
+{
+#ifdef ALBC_MEMORY_ACCOUNTING
+    return true;
+#else
+    return false;
+#endif
+}
+void RecordAlloc(size_t bytes) noexcept
+{
+    auto &state = t_mem_state;
+    state.live_bytes += static_cast<Int64>(bytes);
+    if (auto *scope = state.scope)
+    {
+        ++scope->counters_.alloc_cnt;
+        scope->counters_.alloc_bytes += bytes;
+        scope->peak_ = std::max(scope->peak_, state.live_bytes - scope->base_);
+    }
+}
+void RecordFree(size_t bytes) noexcept
+{
+    t_mem_state.live_bytes -= static_cast<Int64>(bytes);
+}
+void *AccountedMalloc(size_t size) noexcept
+{
+    void *ptr = std::malloc(size ? size : 1);
+#ifdef ALBC_MEMORY_ACCOUNTING
+    if (ptr)
+        RecordAlloc(ALBC_MALLOC_SIZE(ptr));
+#endif
+    return ptr;
+}
+void *AccountedRealloc(void *ptr, size_t size) noexcept
+{
+#ifdef ALBC_MEMORY_ACCOUNTING
+    const size_t old_size = ptr ? ALBC_MALLOC_SIZE(ptr) : 0;
+    void *ret = std::realloc(ptr, size);
+    if (ret)
+    {
+        RecordFree(old_size);
+        RecordAlloc(ALBC_MALLOC_SIZE(ret));
+    }
+    return ret;
+#else
+    return std::realloc(ptr, size);
+#endif
+}
+void AccountedFree(void *ptr) noexcept
+{
+#ifdef ALBC_MEMORY_ACCOUNTING
+    if (ptr)
+        RecordFree(ALBC_MALLOC_SIZE(ptr));
+#endif
+    std::free(ptr);
+}
+MemPhaseScope::MemPhaseScope(MemPhaseCounters &counters) noexcept
+    : counters_(counters), prev_(t_mem_state.scope), base_(t_mem_state.live_bytes)
+{
+    t_mem_state.scope = this;
+}
+MemPhaseScope::~MemPhaseScope()
+{
+    counters_.net_bytes += t_mem_state.live_bytes - base_;
+    counters_.peak_bytes = std::max(counters_.peak_bytes, static_cast<UInt64>(peak_));
+    if (prev_)
+        prev_->peak_ = std::max(prev_->peak_, base_ - prev_->base_ + peak_);
+
+    t_mem_state.scope = prev_;
+}
+Arena::Arena(size_t block_size) noexcept : block_size_(std::max(block_size, sizeof(Block) * 16))
+{
+}
+Arena::~Arena()
+{
+    Release();
+}
+void Arena::Release() noexcept
+{
+    for (auto *cleanup = cleanups_; cleanup; cleanup = cleanup->next)
+    {
+        cleanup->destroy(cleanup->obj);
+    }
+    cleanups_ = nullptr;
+
+    while (head_)
+    {
+        auto *prev = head_->prev;
+#ifndef ALBC_MEMORY_ACCOUNTING
+        RecordFree(head_->size);
+#endif
+        ::operator delete(head_);
+        head_ = prev;
+    }
+    cur_ = end_ = nullptr;
+    bytes_used_ = bytes_reserved_ = 0;
+}
+void *Arena::AllocateSlow(size_t bytes, size_t alignment)
+{
+    const size_t needed = sizeof(Block) + bytes + alignment;
+    if (needed > block_size_ / 4)
+    {
+        // 大块单独分配并挂在当前块之后，当前块的剩余空间继续使用
+        auto *block = NewBlock(needed);
+        if (head_)
+        {
+            block->prev = head_->prev;
+            head_->prev = block;
+        }
+        else
+        {
+            head_ = block;
+        }
+
+        const auto data = reinterpret_cast<std::uintptr_t>(block + 1);
+        bytes_used_ += bytes;
+        return reinterpret_cast<void *>((data + alignment - 1) & ~static_cast<std::uintptr_t>(alignment - 1));
+    }
+
+    auto *block = NewBlock(block_size_);
+    block->prev = head_;
+    head_ = block;
+    cur_ = reinterpret_cast<char *>(block + 1);
+    end_ = reinterpret_cast<char *>(block) + block_size_;
+    return Allocate(bytes, alignment);
+}
+Arena::Block *Arena::NewBlock(size_t size)
+{
+    auto *block = static_cast<Block *>(::operator new(size));
+    block->prev = nullptr;
+    block->size = size;
+    bytes_reserved_ += size;
+#ifndef ALBC_MEMORY_ACCOUNTING
+    RecordAlloc(size); // 已替换全局 operator new 时已经计入
+#endif
+    return block;
+}
+}
+
+#ifdef ALBC_MEMORY_ACCOUNTING
+// 替换全局 operator new/delete，按分配块的实际大小计入当前线程的统计。
+// 直接使用 malloc/free，与未替换的代码之间互相释放也是安全的。
+void *operator new(std::size_t size)
+{
+    for (;;)
+    {
+        if (void *ptr = albc::mem::AccountedMalloc(size))
+            return ptr;
+
+        const auto handler = std::get_new_handler();
+        if (!handler)
+            throw std::bad_alloc();
 
-}
\ No newline at end of file
+        handler();
+    }
+}
+void *operator new[](std::size_t size)
+{
+    return ::operator new(size);
+}
+void *operator new(std::size_t size, const std::nothrow_t &) noexcept
+{
+    try
+    {
+        return ::operator new(size);
+    }
+    catch (...)
+    {
+        return nullptr;
+    }
+}
+void *operator new[](std::size_t size, const std::nothrow_t &) noexcept
+{
+    return ::operator new(size, std::nothrow);
+}
+void operator delete(void *ptr) noexcept
+{
+    albc::mem::AccountedFree(ptr);
+}
+void operator delete[](void *ptr) noexcept
+{
+    albc::mem::AccountedFree(ptr);
+}
+void operator delete(void *ptr, std::size_t) noexcept
+{
+    albc::mem::AccountedFree(ptr);
+}
+void operator delete[](void *ptr, std::size_t) noexcept
+{
+    albc::mem::AccountedFree(ptr);
+}
+void operator delete(void *ptr, const std::nothrow_t &) noexcept
+{
+    albc::mem::AccountedFree(ptr);
+}
+void operator delete[](void *ptr, const std::nothrow_t &) noexcept
+{
+    albc::mem::AccountedFree(ptr);
+}
+#endif
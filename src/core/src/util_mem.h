@@ -3,7 +3,9 @@
 
 #include <new>
 #include <algorithm>
+#include <cstdint>
 #include <memory>
+#include <type_traits>
 
 namespace albc::mem
 {
@@ -75,6 +77,12 @@ template <typename TKey, typename TValue> constexpr void free_ptr_map(std::map<T
     template <typename TKey, typename TValue, template<class...> typename TPtr = std::unique_ptr>
     using PtrDictionary = Dictionary<TKey, TPtr<TValue>>;
 
+    template <typename TKey, typename TValue, template<class...> typename TPtr = std::unique_ptr>
+    using PtrHashDictionary = HashDictionary<TKey, TPtr<TValue>>;
+
+    template <typename TKey, typename TValue, template<class...> typename TPtr = std::unique_ptr>
+    using PtrSmallDictionary = SmallDictionary<TKey, TPtr<TValue>>;
+
     template <typename TValue, template<class...> typename TPtr = std::unique_ptr>
     using PtrVector = Vector<TPtr<TValue>>;
 
@@ -87,4 +95,213 @@ template <typename TKey, typename TValue> constexpr void free_ptr_map(std::map<T
                        [](const TPtr<TValue>& ptr) { return ptr.get(); });
         return raw_vector;
     }
+
+    // 一次求解中按阶段统计的内存分配。计数器为线程局部，一次求解的各阶段都在同一线程中执行。
+    // 以 ALBC_MEMORY_ACCOUNTING 编译时替换全局 operator new/delete，统计全部堆分配（包括Cbc）；
+    // 否则只统计 Arena 申请的内存块。对齐分配（aligned new）不计入。
+    enum class MemPhase
+    {
+        DATA_FEED,      // 由输入构建房间与查询表
+        OPERATOR_BUILD, // 构建干员模型与Buff
+        ENUMERATION,    // 筛选干员并枚举组合
+        MATRIX,         // 构建约束矩阵
+        SOLVER,         // Cbc求解
+        RESULT,         // 收集求解结果
+    };
+
+    constexpr size_t kMemPhaseCount = static_cast<size_t>(MemPhase::RESULT) + 1;
+
+    [[nodiscard]] const char *GetMemPhaseName(MemPhase phase) noexcept;
+
+    struct MemPhaseCounters
+    {
+        UInt64 alloc_cnt = 0;   // 分配次数
+        UInt64 alloc_bytes = 0; // 分配的字节数之和
+        UInt64 peak_bytes = 0;  // 相对进入阶段时的占用峰值，多次进入时取最大值
+        Int64 net_bytes = 0;    // 离开阶段时相对进入时的占用变化，负数表示释放多于分配
+    };
+
+    // 按 MemPhase 索引的各阶段计数
+    struct MemPhaseStats : Array<MemPhaseCounters, kMemPhaseCount>
+    {
+        using Base = Array<MemPhaseCounters, kMemPhaseCount>;
+        using Base::operator[];
+
+        MemPhaseCounters &operator[](MemPhase phase)
+        {
+            return Base::operator[](static_cast<size_t>(phase));
+        }
+
+        const MemPhaseCounters &operator[](MemPhase phase) const
+        {
+            return Base::operator[](static_cast<size_t>(phase));
+        }
+    };
+
+    // 是否以 ALBC_MEMORY_ACCOUNTING 编译，即统计是否包括全部堆分配
+    [[nodiscard]] bool IsHeapAccountingEnabled() noexcept;
+
+    // 记录当前线程的一次分配/释放，计入当前线程活动的阶段
+    void RecordAlloc(size_t bytes) noexcept;
+    void RecordFree(size_t bytes) noexcept;
+
+    // albc::malloc 系列的实现，以 ALBC_MEMORY_ACCOUNTING 编译时计入统计
+    [[nodiscard]] void *AccountedMalloc(size_t size) noexcept;
+    [[nodiscard]] void *AccountedRealloc(void *ptr, size_t size) noexcept;
+    void AccountedFree(void *ptr) noexcept;
+
+    // 作用域内当前线程的分配计入 counters（可多次进入同一阶段，结果累加）。
+    // 嵌套时分配次数只计入内层，占用（peak_bytes、net_bytes）同时计入外层。
+    class MemPhaseScope
+    {
+      public:
+        explicit MemPhaseScope(MemPhaseCounters &counters) noexcept;
+        ~MemPhaseScope();
+
+        MemPhaseScope(const MemPhaseScope &) = delete;
+        MemPhaseScope &operator=(const MemPhaseScope &) = delete;
+
+      private:
+        friend void RecordAlloc(size_t bytes) noexcept;
+
+        MemPhaseCounters &counters_;
+        MemPhaseScope *prev_;
+        Int64 base_;     // 进入时当前线程的占用
+        Int64 peak_ = 0; // 本次进入以来相对 base_ 的占用峰值
+    };
+
+    // 单调分配的内存区域：只分配、不单独释放，区域内的对象在 Release() 或析构时一并销毁，内存整块归还。
+    // 用于一次求解中大量生命周期相同的短期对象（干员模型、Buff实例、房间模型、组合解、约束矩阵等）。
+    // 非线程安全，同一时刻只能由一个线程使用。
+    class Arena
+    {
+      public:
+        static constexpr size_t kDefaultBlockSize = 64 * 1024;
+
+        explicit Arena(size_t block_size = kDefaultBlockSize) noexcept;
+        ~Arena();
+
+        Arena(const Arena &) = delete;
+        Arena &operator=(const Arena &) = delete;
+
+        [[nodiscard]] void *Allocate(size_t bytes, size_t alignment = alignof(std::max_align_t))
+        {
+            const auto cur = reinterpret_cast<std::uintptr_t>(cur_);
+            const auto aligned = (cur + alignment - 1) & ~static_cast<std::uintptr_t>(alignment - 1);
+            if (cur_ && aligned + bytes <= reinterpret_cast<std::uintptr_t>(end_))
+            {
+                cur_ = reinterpret_cast<char *>(aligned + bytes);
+                bytes_used_ += bytes;
+                return reinterpret_cast<void *>(aligned);
+            }
+            return AllocateSlow(bytes, alignment);
+        }
+
+        // 在区域内构造对象，非平凡析构的对象在 Release() 时按构造的逆序析构
+        template <typename Ty, typename... TArgs> Ty *New(TArgs &&...args)
+        {
+            if constexpr (std::is_trivially_destructible_v<Ty>)
+            {
+                return new (Allocate(sizeof(Ty), alignof(Ty))) Ty(std::forward<TArgs>(args)...);
+            }
+            else
+            {
+                auto *cleanup = new (Allocate(sizeof(Cleanup), alignof(Cleanup))) Cleanup{};
+                auto *obj = new (Allocate(sizeof(Ty), alignof(Ty))) Ty(std::forward<TArgs>(args)...);
+                cleanup->obj = obj;
+                cleanup->destroy = [](void *p) { static_cast<Ty *>(p)->~Ty(); };
+                cleanup->next = cleanups_;
+                cleanups_ = cleanup;
+                return obj;
+            }
+        }
+
+        // 析构区域内的所有对象并归还全部内存，之后区域可以继续使用
+        void Release() noexcept;
+
+        [[nodiscard]] size_t GetBytesUsed() const noexcept
+        {
+            return bytes_used_;
+        }
+
+        [[nodiscard]] size_t GetBytesReserved() const noexcept
+        {
+            return bytes_reserved_;
+        }
+
+      private:
+        struct Block
+        {
+            Block *prev;
+            size_t size;
+        };
+
+        struct Cleanup
+        {
+            Cleanup *next;
+            void *obj;
+            void (*destroy)(void *);
+        };
+
+        size_t block_size_;
+        Block *head_ = nullptr;
+        char *cur_ = nullptr;
+        char *end_ = nullptr;
+        Cleanup *cleanups_ = nullptr;
+        size_t bytes_used_ = 0;
+        size_t bytes_reserved_ = 0;
+
+        void *AllocateSlow(size_t bytes, size_t alignment);
+        Block *NewBlock(size_t size);
+    };
+
+    // 从 Arena 分配内存的标准库分配器，deallocate 为空操作，内存随区域一并归还
+    template <typename Ty> class ArenaAllocator
+    {
+      public:
+        using value_type = Ty;
+
+        explicit ArenaAllocator(Arena &arena) noexcept : arena_(&arena)
+        {
+        }
+
+        template <typename U> ArenaAllocator(const ArenaAllocator<U> &other) noexcept : arena_(other.arena_)
+        {
+        }
+
+        [[nodiscard]] Ty *allocate(size_t n)
+        {
+            if (n > SIZE_MAX / sizeof(Ty))
+                throw std::bad_array_new_length();
+
+            return static_cast<Ty *>(arena_->Allocate(n * sizeof(Ty), alignof(Ty)));
+        }
+
+        void deallocate(Ty *, size_t) noexcept
+        {
+        }
+
+        [[nodiscard]] Arena &arena() const noexcept
+        {
+            return *arena_;
+        }
+
+        template <typename U> friend bool operator==(const ArenaAllocator &lhs, const ArenaAllocator<U> &rhs) noexcept
+        {
+            return lhs.arena_ == rhs.arena_;
+        }
+
+        template <typename U> friend bool operator!=(const ArenaAllocator &lhs, const ArenaAllocator<U> &rhs) noexcept
+        {
+            return lhs.arena_ != rhs.arena_;
+        }
+
+      private:
+        template <typename U> friend class ArenaAllocator;
+
+        Arena *arena_;
+    };
+
+    template <typename TValue>
+    using ArenaVector = std::vector<TValue, ArenaAllocator<TValue>>;
 }
\ No newline at end of file
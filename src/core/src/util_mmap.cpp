@@ -0,0 +1,172 @@
+#include "util_mmap.h"
+
+#include <stdexcept>
+#include <utility>
+
+#ifdef _WIN32
+#   ifndef NOMINMAX
+#       define NOMINMAX
+#   endif
+#   include <windows.h>
+#else
+#   include <cerrno>
+#   include <fcntl.h>
+#   include <sys/mman.h>
+#   include <sys/stat.h>
+#   include <unistd.h>
+#endif
+
+namespace albc::util
+{
+#ifdef _WIN32
+MappedFile::MappedFile(const std::string &path)
+{
+    const HANDLE file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING,
+                                    FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+    if (file == INVALID_HANDLE_VALUE)
+        throw std::runtime_error("Unable to open file: " + path);
+
+    if (GetFileType(file) != FILE_TYPE_DISK)
+    {
+        char chunk[64 * 1024];
+        DWORD n = 0;
+        while (ReadFile(file, chunk, sizeof(chunk), &n, nullptr) && n > 0)
+            buffer_.insert(buffer_.end(), chunk, chunk + n);
+        CloseHandle(file);
+        data_ = buffer_.empty() ? nullptr : buffer_.data();
+        size_ = buffer_.size();
+        return;
+    }
+
+    LARGE_INTEGER file_size;
+    if (!GetFileSizeEx(file, &file_size))
+    {
+        CloseHandle(file);
+        throw std::runtime_error("Unable to get file size: " + path);
+    }
+
+    size_ = static_cast<size_t>(file_size.QuadPart);
+    if (size_ == 0)
+    {
+        CloseHandle(file);
+        return;
+    }
+
+    mapping_ = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    CloseHandle(file);
+    if (!mapping_)
+        throw std::runtime_error("Unable to map file: " + path);
+
+    data_ = static_cast<const char *>(MapViewOfFile(mapping_, FILE_MAP_READ, 0, 0, 0));
+    if (!data_)
+    {
+        CloseHandle(mapping_);
+        mapping_ = nullptr;
+        throw std::runtime_error("Unable to map file: " + path);
+    }
+}
+void MappedFile::Unmap() noexcept
+{
+    if (data_ && buffer_.empty())
+        UnmapViewOfFile(data_);
+    if (mapping_)
+        CloseHandle(mapping_);
+    data_ = nullptr;
+    mapping_ = nullptr;
+    size_ = 0;
+    buffer_.clear();
+}
+#else
+MappedFile::MappedFile(const std::string &path)
+{
+    const int fd = open(path.c_str(), O_RDONLY);
+    if (fd < 0)
+        throw std::runtime_error("Unable to open file: " + path);
+
+    struct stat st{};
+    if (fstat(fd, &st) != 0)
+    {
+        close(fd);
+        throw std::runtime_error("Unable to get file size: " + path);
+    }
+
+    if (!S_ISREG(st.st_mode))
+    {
+        char chunk[64 * 1024];
+        for (;;)
+        {
+            const auto n = read(fd, chunk, sizeof(chunk));
+            if (n < 0 && errno == EINTR)
+                continue;
+
+            if (n < 0)
+            {
+                close(fd);
+                throw std::runtime_error("Unable to read file: " + path);
+            }
+            if (n == 0)
+                break;
+
+            buffer_.insert(buffer_.end(), chunk, chunk + n);
+        }
+        close(fd);
+        data_ = buffer_.empty() ? nullptr : buffer_.data();
+        size_ = buffer_.size();
+        return;
+    }
+
+    size_ = static_cast<size_t>(st.st_size);
+    if (size_ == 0)
+    {
+        close(fd);
+        return;
+    }
+
+    void *addr = mmap(nullptr, size_, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd); // 映射建立后即可关闭描述符
+    if (addr == MAP_FAILED)
+    {
+        size_ = 0;
+        throw std::runtime_error("Unable to map file: " + path);
+    }
+
+    madvise(addr, size_, MADV_SEQUENTIAL);
+    data_ = static_cast<const char *>(addr);
+}
+void MappedFile::Unmap() noexcept
+{
+    if (data_ && buffer_.empty())
+        munmap(const_cast<char *>(data_), size_);
+    data_ = nullptr;
+    size_ = 0;
+    buffer_.clear();
+}
+#endif
+MappedFile::~MappedFile()
+{
+    Unmap();
+}
+MappedFile::MappedFile(MappedFile &&other) noexcept
+    : data_(std::exchange(other.data_, nullptr)), size_(std::exchange(other.size_, 0)),
+      buffer_(std::move(other.buffer_))
+#ifdef _WIN32
+      , mapping_(std::exchange(other.mapping_, nullptr))
+#endif
+{
+}
+MappedFile &MappedFile::operator=(MappedFile &&other) noexcept
+{
+    if (this != &other)
+    {
+        Unmap();
+        data_ = std::exchange(other.data_, nullptr);
+        size_ = std::exchange(other.size_, 0);
+        buffer_ = std::move(other.buffer_);
+        other.buffer_.clear();
+#ifdef _WIN32
+        mapping_ = std::exchange(other.mapping_, nullptr);
+#endif
+    }
+    return *this;
+}
+} // namespace albc::util
@@ -0,0 +1,49 @@
+#pragma once
+#include "albc_types.h"
+
+#include <string>
+#include <string_view>
+
+namespace albc::util
+{
+// 只读内存映射文件，映射在对象析构时解除。空文件得到空视图。
+// 只映射普通文件；管道、/dev/stdin 等大小未知的文件退回到读入缓冲区。
+// 映射期间文件被截断时访问越界的页会触发 SIGBUS，调用方需保证读取期间文件不被改写。
+class MappedFile
+{
+  public:
+    explicit MappedFile(const std::string &path);
+    ~MappedFile();
+
+    MappedFile(const MappedFile &) = delete;
+    MappedFile &operator=(const MappedFile &) = delete;
+
+    MappedFile(MappedFile &&other) noexcept;
+    MappedFile &operator=(MappedFile &&other) noexcept;
+
+    [[nodiscard]] const char *data() const noexcept
+    {
+        return data_;
+    }
+
+    [[nodiscard]] size_t size() const noexcept
+    {
+        return size_;
+    }
+
+    [[nodiscard]] std::string_view View() const noexcept
+    {
+        return {data_, size_};
+    }
+
+  private:
+    const char *data_ = nullptr;
+    size_t size_ = 0;
+    Vector<char> buffer_; // 非普通文件读入的内容，非空时 data_ 指向其中
+#ifdef _WIN32
+    void *mapping_ = nullptr; // HANDLE
+#endif
+
+    void Unmap() noexcept;
+};
+} // namespace albc::util
@@ -4,6 +4,7 @@
 #pragma once
 #include <iostream>
 #include <string>
+#include <string_view>
 #include <cstdio>
 #include <ctime>
 #include <chrono>
@@ -11,13 +12,17 @@
 #include <type_traits>
 #include "albc_types.h"
 #include "util_log.h"
+#include "util_trace.h"
 #include "util.h"
 
 // this marco is used to measure the execution time of a scope, and prints filename, function name, line number, and duration
-#define SCOPE_TIMER_WITH_TRACE(name) albc::util::ScopeTimer(                 \
-    std::string("ALBC|").append(albc::util::GetReadableTime()).append("|").append(albc::util::get_current_thread_id())     \
-    .append("|TIMER|").append(__FILENAME__).append(":")                                        \
-    .append(__func__).append(STRINGIFY(:__LINE__|[ScopeTimer])).append((name)))
+// the trace header and name are only formatted when INFO level is enabled, and the scope is only recorded as
+// trace events when TraceRecorder is enabled; otherwise the timer does nothing
+#define SCOPE_TIMER_WITH_TRACE(name) albc::util::ScopeTimer(                                                           \
+    albc::util::GlobalLogConfig::CanLog(albc::util::LogLevel::INFO)                                                     \
+        ? albc::util::ScopeTimer::MakeTraceName(__FILENAME__, __func__, STRINGIFY(__LINE__), (name))                    \
+        : std::string(),                                                                                                \
+    albc::util::TraceRecorder::IsEnabled() ? albc::util::Atom::Intern(name) : albc::util::Atom())
 
 namespace albc::util
 {
@@ -37,28 +42,50 @@ namespace albc::util
         return FloatingSeconds{PerfClock::now() - t0};
     }
 
-    // measures the execution time of a scope, using RAII
+    // measures the execution time of a scope, using RAII. an empty name disables the timer,
+    // an empty trace name disables the begin/end trace events
     class [[nodiscard]] ScopeTimer
     {
     public:
-        explicit ScopeTimer(std::string name, LogLevel log_level = LogLevel::INFO)
+        explicit ScopeTimer(std::string name, Atom trace_name = {}, LogLevel log_level = LogLevel::INFO)
             : m_name(std::move(name)), // store name
-              m_start(PerfClock::now()), // store start time
-                log_level_(log_level)
+              m_start(m_name.empty() ? PerfClock::time_point() : PerfClock::now()), // store start time
+                log_level_(log_level),
+                trace_(trace_name)
         {
         }
 
         ~ScopeTimer()
         {
+            if (m_name.empty())
+                return;
+
             // print name and duration
             double sec = FloatingSeconds(PerfClock::now() - m_start).count();
-            SingletonLogger::instance()->Log(
-                log_level_, std::move(m_name.append(": Done in ").append(std::to_string(sec)).append("s")));
+            AsyncLogger::instance().Log(log_level_, m_name.append(": Done in ").append(std::to_string(sec)).append("s"));
+        }
+
+        static std::string MakeTraceName(std::string_view file, std::string_view func, std::string_view line,
+                                         std::string_view name)
+        {
+            return std::string("ALBC|")
+                .append(GetReadableTime())
+                .append("|")
+                .append(get_current_thread_id())
+                .append("|TIMER|")
+                .append(file)
+                .append(":")
+                .append(func)
+                .append(":")
+                .append(line)
+                .append("|[ScopeTimer]")
+                .append(name);
         }
 
     private:
         std::string m_name;
         const PerfClock::time_point m_start;
         const LogLevel log_level_;
+        const TraceScope trace_;
     };
 }
\ No newline at end of file
@@ -0,0 +1,280 @@
+#include "util_trace.h"
+#include "util_time.h"
+
+#include <algorithm>
+#include <fstream>
+#include <iomanip>
+#include <memory>
+#include <mutex>
+
+namespace albc::util
+{
+namespace
+{
+struct TraceEvent
+{
+    Int64 ts_ns;
+    Atom name;
+    char phase; // 'B' 或 'E'
+    UInt8 id_length;
+    Array<char, TraceRecorder::kMaxIdLength> id; // 事件参数，不以 '\0' 结尾
+};
+
+// 单个线程的事件缓冲：只由所属线程写入，导出线程读取已发布的部分。
+// 事件按块追加，计数以 release 发布，追加事件不加锁。新一轮记录时改挂新的块链表并释放旧链表，
+// 换链表与导出都持有 chain_mutex_，导出不会读到已释放的块。
+class ThreadTraceBuffer
+{
+  public:
+    static constexpr size_t kChunkSize = 4096;
+
+    struct Chunk
+    {
+        Array<TraceEvent, kChunkSize> events;
+        std::atomic<size_t> count{0};
+        std::atomic<Chunk *> next{nullptr};
+    };
+
+    explicit ThreadTraceBuffer(UInt32 tid) : tid_(tid)
+    {
+    }
+
+    [[nodiscard]] UInt32 GetTid() const noexcept
+    {
+        return tid_;
+    }
+
+    void Push(UInt64 session, const TraceEvent &event)
+    {
+        if (session_.load(std::memory_order_relaxed) != session || !tail_)
+        {
+            Vector<std::unique_ptr<Chunk>> previous; // 上一轮记录的块，解锁后释放
+            std::scoped_lock lock(chain_mutex_);
+            previous.swap(owned_);
+            head_.store(nullptr, std::memory_order_relaxed);
+            tail_ = nullptr;
+            tail_ = NewChunk();
+            head_.store(tail_, std::memory_order_release);
+            session_.store(session, std::memory_order_release);
+        }
+
+        size_t n = tail_->count.load(std::memory_order_relaxed);
+        if (n == kChunkSize)
+        {
+            auto *chunk = NewChunk();
+            tail_->next.store(chunk, std::memory_order_release);
+            tail_ = chunk;
+            n = 0;
+        }
+
+        tail_->events[n] = event;
+        tail_->count.store(n + 1, std::memory_order_release);
+    }
+
+    // 所属线程已退出，导出后即可从登记表移除
+    void Retire() noexcept
+    {
+        retired_.store(true, std::memory_order_release);
+    }
+
+    [[nodiscard]] bool IsRetired() const noexcept
+    {
+        return retired_.load(std::memory_order_acquire);
+    }
+
+    template <typename TFunc> void ForEach(UInt64 session, TFunc &&func) const
+    {
+        std::scoped_lock lock(chain_mutex_);
+        if (session_.load(std::memory_order_acquire) != session)
+            return;
+
+        for (const auto *chunk = head_.load(std::memory_order_acquire); chunk;
+             chunk = chunk->next.load(std::memory_order_acquire))
+        {
+            const size_t n = chunk->count.load(std::memory_order_acquire);
+            for (size_t i = 0; i < n; ++i)
+                func(chunk->events[i]);
+        }
+    }
+
+  private:
+    const UInt32 tid_;
+    std::atomic<UInt64> session_{0};
+    std::atomic<Chunk *> head_{nullptr};
+    Chunk *tail_ = nullptr;                // 仅所属线程访问
+    Vector<std::unique_ptr<Chunk>> owned_; // 仅所属线程修改，持有 chain_mutex_
+    mutable std::mutex chain_mutex_;
+    std::atomic<bool> retired_{false};
+
+    Chunk *NewChunk()
+    {
+        return owned_.emplace_back(std::make_unique<Chunk>()).get();
+    }
+};
+
+struct TraceRegistry
+{
+    std::mutex mutex;
+    Vector<std::shared_ptr<ThreadTraceBuffer>> buffers; // 线程退出后缓冲保留到下一次导出或开始新一轮记录
+    UInt32 next_tid = 1;
+    std::atomic<UInt64> session{1};
+    std::atomic<PerfClock::rep> session_start{PerfClock::now().time_since_epoch().count()};
+
+    static TraceRegistry &instance()
+    {
+        static TraceRegistry registry;
+        return registry;
+    }
+
+    // 调用方须持有 mutex
+    void RemoveRetiredLocked()
+    {
+        buffers.erase(std::remove_if(buffers.begin(), buffers.end(),
+                                     [](const auto &buffer) { return buffer->IsRetired(); }),
+                      buffers.end());
+    }
+};
+
+// 线程退出时标记其缓冲
+struct TraceBufferHandle
+{
+    std::shared_ptr<ThreadTraceBuffer> buffer;
+
+    ~TraceBufferHandle()
+    {
+        if (buffer)
+            buffer->Retire();
+    }
+};
+
+ThreadTraceBuffer &GetThreadBuffer()
+{
+    thread_local TraceBufferHandle handle;
+    if (!handle.buffer)
+    {
+        auto &registry = TraceRegistry::instance();
+        std::scoped_lock lock(registry.mutex);
+        handle.buffer = registry.buffers.emplace_back(std::make_shared<ThreadTraceBuffer>(registry.next_tid++));
+    }
+    return *handle.buffer;
+}
+
+void Record(Atom name, char phase, std::string_view id = {}) noexcept
+{
+    auto &registry = TraceRegistry::instance();
+    const auto session = registry.session.load(std::memory_order_acquire);
+    const auto start = PerfClock::time_point(PerfClock::duration(registry.session_start.load(std::memory_order_relaxed)));
+    const auto ts = std::chrono::duration_cast<std::chrono::nanoseconds>(PerfClock::now() - start).count();
+
+    try
+    {
+        TraceEvent event{static_cast<Int64>(ts), name, phase, 0, {}};
+        event.id_length = static_cast<UInt8>(std::min(id.size(), TraceRecorder::kMaxIdLength));
+        std::copy_n(id.data(), event.id_length, event.id.begin());
+        GetThreadBuffer().Push(session, event);
+    }
+    catch (const std::bad_alloc &)
+    {
+        // 内存不足时丢弃事件，追踪不应影响求解
+    }
+}
+
+void WriteJsonString(std::ostream &os, std::string_view str)
+{
+    os << '"';
+    for (const char c : str)
+    {
+        switch (c)
+        {
+        case '"':
+            os << "\\\"";
+            break;
+        case '\\':
+            os << "\\\\";
+            break;
+        default:
+            if (static_cast<unsigned char>(c) < 0x20)
+                os << "\\u" << std::hex << std::setw(4) << std::setfill('0') << static_cast<int>(c) << std::dec
+                   << std::setfill(' ');
+            else
+                os << c;
+        }
+    }
+    os << '"';
+}
+} // namespace
+
+std::atomic<bool> TraceRecorder::enabled_{false};
+
+void TraceRecorder::SetEnabled(bool enabled)
+{
+    auto &registry = TraceRegistry::instance();
+    if (enabled && !enabled_.load(std::memory_order_relaxed))
+    {
+        {
+            // 已退出线程的事件属于上一轮记录，随新一轮记录一并丢弃
+            std::scoped_lock lock(registry.mutex);
+            registry.RemoveRetiredLocked();
+        }
+        registry.session_start.store(PerfClock::now().time_since_epoch().count(), std::memory_order_relaxed);
+        registry.session.fetch_add(1, std::memory_order_acq_rel);
+    }
+
+    enabled_.store(enabled, std::memory_order_relaxed);
+}
+void TraceRecorder::Begin(Atom name, std::string_view id) noexcept
+{
+    Record(name, 'B', id);
+}
+void TraceRecorder::End(Atom name) noexcept
+{
+    Record(name, 'E');
+}
+void TraceRecorder::WriteChromeTrace(std::ostream &os)
+{
+    auto &registry = TraceRegistry::instance();
+    std::scoped_lock lock(registry.mutex);
+    const auto session = registry.session.load(std::memory_order_acquire);
+
+    os << R"({"displayTimeUnit":"ms","traceEvents":[)";
+    bool first = true;
+    const auto separator = [&] {
+        if (!first)
+            os << ",\n";
+        first = false;
+    };
+
+    for (const auto &buffer : registry.buffers)
+    {
+        separator();
+        os << R"({"name":"thread_name","ph":"M","pid":1,"tid":)" << buffer->GetTid()
+           << R"(,"args":{"name":"albc thread )" << buffer->GetTid() << R"("}})";
+
+        buffer->ForEach(session, [&](const TraceEvent &event) {
+            separator();
+            os << R"({"name":)";
+            WriteJsonString(os, event.name.str());
+            os << R"(,"cat":"albc","ph":")" << event.phase << R"(","pid":1,"tid":)" << buffer->GetTid()
+               << R"(,"ts":)" << std::fixed << std::setprecision(3) << static_cast<double>(event.ts_ns) / 1000.;
+            if (event.id_length)
+            {
+                os << R"(,"args":{"id":)";
+                WriteJsonString(os, std::string_view(event.id.data(), event.id_length));
+                os << '}';
+            }
+            os << '}';
+        });
+    }
+
+    os << "]}\n";
+    registry.RemoveRetiredLocked(); // 已退出线程的事件已导出
+}
+void TraceRecorder::WriteChromeTraceFile(const std::string &path)
+{
+    std::ofstream ofs(path, std::ios::out | std::ios::trunc);
+    if (!ofs)
+        throw std::runtime_error("Unable to open file: " + path);
+
+    WriteChromeTrace(ofs);
+}
+} // namespace albc::util
@@ -0,0 +1,76 @@
+#pragma once
+#include "albc_types.h"
+#include "util_atom.h"
+
+#include <atomic>
+#include <ostream>
+#include <string_view>
+
+namespace albc::util
+{
+// 追踪记录器：记录各线程上计时作用域的开始/结束事件，导出为 Chrome trace JSON（chrome://tracing、Perfetto）。
+// 每个线程写入自己的缓冲，写入路径无锁；只有线程首次记录与导出时访问全局登记表。
+// 上一轮记录的事件在线程写入新一轮事件时释放，已退出线程的缓冲在导出或开始新一轮记录后释放。
+// 未启用时 IsEnabled() 仅为一次原子读取，SCOPE_TIMER_WITH_TRACE 与 TRACE_SCOPE 不会驻留名称或记录事件。
+class TraceRecorder
+{
+  public:
+    [[nodiscard]] static bool IsEnabled() noexcept
+    {
+        return enabled_.load(std::memory_order_relaxed);
+    }
+
+    // 启用时开始新的记录，丢弃此前记录的事件
+    static void SetEnabled(bool enabled);
+
+    // id 为作用域对象的标识（如房间Id），导出为事件参数，超出 kMaxIdLength 的部分被截断。
+    // 名称会被驻留，因此只能是固定的字符串；随输入变化的标识应通过 id 传入
+    static void Begin(Atom name, std::string_view id = {}) noexcept;
+    static void End(Atom name) noexcept;
+
+    static constexpr size_t kMaxIdLength = 31;
+
+    // 写出当前记录的全部事件。可以在记录进行中调用，此时仅包含已写入完成的事件
+    static void WriteChromeTrace(std::ostream &os);
+    static void WriteChromeTraceFile(const std::string &path);
+
+  private:
+    static std::atomic<bool> enabled_;
+};
+
+// 记录一对开始/结束事件，空名称时不做任何事
+class [[nodiscard]] TraceScope
+{
+  public:
+    TraceScope() noexcept = default;
+
+    explicit TraceScope(Atom name, std::string_view id = {}) noexcept : name_(name)
+    {
+        if (!name_.empty())
+            TraceRecorder::Begin(name_, id);
+    }
+
+    ~TraceScope()
+    {
+        if (!name_.empty())
+            TraceRecorder::End(name_);
+    }
+
+    TraceScope(const TraceScope &) = delete;
+    TraceScope &operator=(const TraceScope &) = delete;
+
+  private:
+    Atom name_;
+};
+} // namespace albc::util
+
+// 仅追踪、不输出日志的作用域，name 只在追踪启用时求值
+#define TRACE_SCOPE(name)                                                                                              \
+    albc::util::TraceScope(albc::util::TraceRecorder::IsEnabled() ? albc::util::Atom::Intern(name)                   \
+                                                                   : albc::util::Atom())
+
+// 带标识参数的追踪作用域，name 需为固定字符串，id 不会被驻留
+#define TRACE_SCOPE_WITH_ID(name, id)                                                                                  \
+    albc::util::TraceScope(albc::util::TraceRecorder::IsEnabled() ? albc::util::Atom::Intern(name)                   \
+                                                                   : albc::util::Atom(),                             \
+                           id)
@@ -33,6 +33,15 @@ void run(const char* building_data_path, const char *character_table_path, const
                 << std::endl;
         }
     }
+
+    const auto stats = result->GetStats();
+    std::cout
+        << "Solved in "    << stats.total_time << "s"
+        << " (enum: "      << stats.enum_time << "s"
+        << ", solve: "     << stats.solve_time << "s)"
+        << ", combinations: " << stats.calc_cnt
+        << ", columns: "   << stats.col_cnt
+        << std::endl;
     albc::FlushLog();
 }
 